@@ -66,11 +66,10 @@ void app_task_1000ms_init( void )
 	;
 }
 
+/* The heartbeat it toggled runs on N2HET1[0], see fw_het.c */
 void app_task_1000ms( void )
 {
-    // while (1) {
-       toggle_output_pin(eDIO_OUTPUT_PIN_LED_6);
-    // }
+    ;
 }
 
 /*----------------------------------------------------------------------------\
@@ -65,7 +65,8 @@ void app_task_25ms_init( void )
 
 void app_task_25ms( void )
 {
-    ;
+    /* Digital inputs sample period, the debounce times count these calls */
+    read_digital_inputs();
 }
 
 /*----------------------------------------------------------------------------\
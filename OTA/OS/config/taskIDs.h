@@ -39,7 +39,7 @@ typedef enum
      * Include here the application specific Task IDs.
      * MUST be in same order as in TaskParamsList and TaskConfigList.
      */
-//    E_TASKID_C0_GK = 0,
+    E_TASKID_C0_GK = 0,
     E_TASKID_C0_2MS,
     E_TASKID_C0_10MS,
     E_TASKID_C0_25MS,
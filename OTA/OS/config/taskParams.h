@@ -59,6 +59,7 @@ typedef struct
     T_TASKMAINPROC  mainproc;
     T_TASKINITPROC  initproc;
     U32             stacksize;                          /* Size of stack area [bytes] */
+    BOOLEAN         usesfpu;                            /* TRUE gives the task a floating point context, see vPortUndefHandler */
     CHAR            name[ TASK_NAME_LENGTH_MAX + 1 ];   /* Not used by FreeRTOS but for application specific purposes */
 } S_TASK_CONFIG;
 
@@ -91,6 +92,7 @@ typedef struct
     U8                  priority;
     BOOLEAN             taskvalid;      /* TRUE if task for this data is initialised */
     U32                 period;         /* Time between calls [ms] */
+    BOOLEAN             usesfpu;        /* Task saves and restores the VFP registers */
 
     /* Runtime data */
     TaskHandle_t        htask;
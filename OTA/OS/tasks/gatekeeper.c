@@ -0,0 +1,320 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : gatekeeper.c Module File.                                  |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Event driven gatekeeper framework.                                        |
+|                                                                             |
+|   Replaces the 100ms polling of the serial trace queue: service latency    |
+|   drops from up to one period to one context switch, everything pending    |
+|   is handled per wake-up and the gatekeeper no longer wakes when idle.      |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Compiler Controls                                                         |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "gatekeeper.h"
+#include "setup.h"
+#include "trace.h"
+#include "tsk_c0_gk_task.h"
+
+#include "fw_dio.h"
+#include "fw_twheel.h"
+#include "fw_uart.h"
+#include "fw_trace.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Public Data Definitions                                                   |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define GK_SOURCE_BIT( src )	( ( U32 ) 1u << ( U32 ) ( src ) )
+#define GK_ALL_SOURCES			( GK_SOURCE_BIT( eGK_SRC_MAX ) - 1u )
+
+static const S_GK_SOURCE_DEF gk_source_defs[ eGK_SRC_MAX ] =
+{
+	/*
+	 * Gatekeeper sources!
+	 * Keep ordered by E_GK_SOURCE!
+	 */
+	{
+		.source = eGK_SRC_SERIAL_TRACE,
+		.name = "GK trace",
+		.queue = &xSerialTraceHandle,
+		.queue_length = SERIAL_TRACE_QUEUE_LENGTH,
+		.item_size = SERIAL_TRACE_QUEUE_ITEM_SIZE,
+		.handler = task_C0_GK_serial_trace,
+	},
+	{
+		.source = eGK_SRC_UART_RX,
+		.name = "UART RX",
+		.queue = &xUARTQueueHandle,
+		.queue_length = UART_QUEUE_LENGTH,
+		.item_size = UART_QUEUE_ITEM_SIZE,
+		.handler = uartRxFrameHandler,
+	},
+	{
+		.source = eGK_SRC_DIO_EDGE,
+		.name = "DIO edge",
+		.queue = NULL,
+		.queue_length = 0u,
+		.item_size = 0u,
+		.handler = dioEdgeServe,
+	},
+	{
+		.source = eGK_SRC_TIMER_WHEEL,
+		.name = "Timer wheel",
+		.queue = NULL,
+		.queue_length = 0u,
+		.item_size = 0u,
+		.handler = twServe,
+	},
+};
+
+/*----------------------------------------------------------------------------\
+|   Private Data Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+static TaskHandle_t gk_task = NULL;
+static S_GK_STATS gk_stats[ eGK_SRC_MAX ];
+static U8 gk_item[ GK_ITEM_SIZE_MAX ];				/* Kept off the 128 word task stack */
+
+/*----------------------------------------------------------------------------\
+|   Private Function Declarations                                             |
+\----------------------------------------------------------------------------*/
+
+static void gkDrain( E_GK_SOURCE source );
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|    Procedure         :  gkInit                                              |
+|                                                                             |
+|    Description       :  Creates the queue of every source that does not     |
+|                         have one yet and clears the statistics.             |
+|                                                                             |
+|    Inputs            :  none.                                               |
+|                                                                             |
+|    Outputs           :  none.                                               |
+|                                                                             |
+|    Return            :  none.                                               |
+|                                                                             |
+|    Warnings          :  Must run before the scheduler starts.               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void gkInit( void )
+{
+	U32 i;
+	const S_GK_SOURCE_DEF *def;
+
+	memset( gk_stats, 0, sizeof( gk_stats ) );
+
+	for ( i = 0u; i < eGK_SRC_MAX; i++ )
+	{
+		def = &gk_source_defs[ i ];
+		configASSERT( def->item_size <= GK_ITEM_SIZE_MAX );
+
+		if ( ( NULL != def->queue ) && ( NULL == *def->queue ) )
+		{
+			*def->queue = xQueueCreate( def->queue_length, def->item_size );
+			trcNameObject( *def->queue, def->name );
+		}
+	}
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|    Procedure         :  gkServe                                             |
+|                                                                             |
+|    Description       :  Blocks until at least one source is signalled, then |
+|                         drains every signalled source. The first call       |
+|                         drains all sources, to pick up anything posted      |
+|                         before the gatekeeper task was running.             |
+|                                                                             |
+|    Inputs            :  Pointer to the gatekeeper task's process data.      |
+|                                                                             |
+|    Outputs           :  none.                                               |
+|                                                                             |
+|    Return            :  none.                                               |
+|                                                                             |
+|    Warnings          :  Gatekeeper task only.                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void gkServe( S_TASKPROC_DATA *procdata )
+{
+	uint32_t pending = 0u;
+	U32 i;
+
+	if ( NULL == gk_task )
+	{
+		gk_task = ( TaskHandle_t ) procdata->htask;
+		pending = GK_ALL_SOURCES;
+	}
+	else
+	{
+		( void ) xTaskNotifyWait( 0u, GK_ALL_SOURCES, &pending, portMAX_DELAY );
+	}
+
+	procdata->state = TASK_STATE_RUNPROC;
+	procdata->callcount++;
+
+	for ( i = 0u; i < eGK_SRC_MAX; i++ )
+	{
+		if ( ( pending & GK_SOURCE_BIT( i ) ) != 0u )
+		{
+			gkDrain( ( E_GK_SOURCE ) i );
+		}
+	}
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|    Procedure         :  gkPost                                              |
+|                                                                             |
+|    Description       :  Queues an item for a source and wakes the           |
+|                         gatekeeper. Never blocks.                           |
+|                                                                             |
+|    Inputs            :  Source.                                             |
+|                         Pointer to the item ( item_size bytes are copied ). |
+|                                                                             |
+|    Outputs           :  none.                                               |
+|                                                                             |
+|    Return            :  pdPASS if queued,                                   |
+|                         errQUEUE_FULL if the item was dropped.              |
+|                                                                             |
+|    Warnings          :  Task context only, see gkPostFromISR.               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+portBaseType gkPost( E_GK_SOURCE source, const void *item )
+{
+	portBaseType ok;
+	const S_GK_SOURCE_DEF *def = &gk_source_defs[ source ];
+
+	ok = xQueueSend( *def->queue, item, 0 );
+	if ( pdPASS != ok )
+	{
+		gk_stats[ source ].post_failed++;
+	}
+	else if ( NULL != gk_task )
+	{
+		( void ) xTaskNotify( gk_task, GK_SOURCE_BIT( source ), eSetBits );
+	}
+
+	return ok;
+}
+
+portBaseType gkPostFromISR( E_GK_SOURCE source, const void *item, portBaseType *woken )
+{
+	portBaseType ok;
+	const S_GK_SOURCE_DEF *def = &gk_source_defs[ source ];
+
+	ok = xQueueSendFromISR( *def->queue, item, woken );
+	if ( pdPASS != ok )
+	{
+		gk_stats[ source ].post_failed++;
+	}
+	else
+	{
+		gkSignalFromISR( source, woken );
+	}
+
+	return ok;
+}
+
+/* Event only: wakes the gatekeeper to run the source's handler once */
+void gkSignal( E_GK_SOURCE source )
+{
+	if ( NULL != gk_task )
+	{
+		( void ) xTaskNotify( gk_task, GK_SOURCE_BIT( source ), eSetBits );
+	}
+}
+
+void gkSignalFromISR( E_GK_SOURCE source, portBaseType *woken )
+{
+	if ( NULL != gk_task )
+	{
+		( void ) xTaskNotifyFromISR( gk_task, GK_SOURCE_BIT( source ), eSetBits, woken );
+	}
+}
+
+const S_GK_STATS * gkGetStats( E_GK_SOURCE source )
+{
+	return &gk_stats[ source ];
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+static void gkDrain( E_GK_SOURCE source )
+{
+	U32 count = 0u;
+	const S_GK_SOURCE_DEF *def = &gk_source_defs[ source ];
+	S_GK_STATS *stats = &gk_stats[ source ];
+
+	if ( NULL == def->queue )
+	{
+		def->handler( NULL );
+		count = 1u;
+	}
+	else
+	{
+		while ( pdPASS == xQueueReceive( *def->queue, gk_item, 0 ) )
+		{
+			def->handler( gk_item );
+			count++;
+		}
+	}
+
+	if ( count > 0u )
+	{
+		stats->items += count;
+		stats->batches++;
+		if ( count > stats->max_batch )
+		{
+			stats->max_batch = count;
+		}
+	}
+}
+
+/*----------------------------------------------------------------------------\
+|   End of gatekeeper.c module                                                |
+\----------------------------------------------------------------------------*/
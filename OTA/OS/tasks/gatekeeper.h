@@ -0,0 +1,97 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : gatekeeper.h Header File.                                  |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Event driven gatekeeper framework.                                        |
+|                                                                             |
+|   Every source owns a queue ( or none, for pure events ) and a bit in the   |
+|   gatekeeper task's notification value. Producers post the item and set     |
+|   the bit, the gatekeeper blocks in xTaskNotifyWait() and drains every      |
+|   pending item of every signalled source in one batch.                      |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef GATEKEEPER_H
+#define GATEKEEPER_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "FreeRTOS.h"
+#include "os_queue.h"
+#include "os_task.h"
+
+#include "fw_types.h"
+#include "taskParams.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Type Definitions                                                   |
+\----------------------------------------------------------------------------*/
+
+/* Note: one notification bit each, at most 32 sources */
+typedef enum
+{
+	eGK_SRC_SERIAL_TRACE = 0u,			/* S_SERIAL_TRACE_INFO from the periodic tasks */
+	eGK_SRC_UART_RX,					/* S_UART_INFO frames from sciNotification */
+	eGK_SRC_DIO_EDGE,					/* Event only, S_DIO_EDGE_EVENT ring of the GIO edge interrupt */
+	eGK_SRC_TIMER_WHEEL,				/* Event only, expired timers of fw_twheel */
+	eGK_SRC_MAX,
+} E_GK_SOURCE;
+
+typedef void ( *GK_HANDLER )( const void *item );
+
+typedef struct
+{
+	E_GK_SOURCE			source;
+	const CHAR *		name;
+	xQueueHandle *		queue;			/* Created by gkInit() if still NULL, NULL for event only sources */
+	U32					queue_length;
+	U32					item_size;		/* Bytes, at most GK_ITEM_SIZE_MAX */
+	GK_HANDLER			handler;		/* Called per item, with NULL for event only sources */
+} S_GK_SOURCE_DEF;
+
+typedef struct
+{
+	U32					items;			/* Items handled */
+	U32					batches;		/* Wake-ups that found work for this source */
+	U32					max_batch;		/* Most items drained in one wake-up */
+	U32					post_failed;	/* Queue full on post */
+} S_GK_STATS;
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+#define GK_ITEM_SIZE_MAX		128u
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+void gkInit( void );
+void gkServe( S_TASKPROC_DATA *procdata );
+portBaseType gkPost( E_GK_SOURCE source, const void *item );
+portBaseType gkPostFromISR( E_GK_SOURCE source, const void *item, portBaseType *woken );
+void gkSignal( E_GK_SOURCE source );
+void gkSignalFromISR( E_GK_SOURCE source, portBaseType *woken );
+const S_GK_STATS * gkGetStats( E_GK_SOURCE source );
+
+/*----------------------------------------------------------------------------\
+|   End of gatekeeper.h header file                                           |
+\----------------------------------------------------------------------------*/
+
+#endif  /* GATEKEEPER_H */
@@ -36,6 +36,7 @@
 #include "coreParams.h"
 #include "taskParams.h"
 #include "trace.h"
+#include "fw_log.h"
 #include "setup.h"
 #include "global.h"
 
@@ -98,21 +99,21 @@ static const S_TASK_CONFIG TaskConfigList[] =
 	 * Use NULL if no initproc specified!
 	 * Note: Must match S_TASK_CONFIG struct.
 	 */
-	/* taskid			 	mainproc			initproc		   		stacksize	name[20] */
-//    {  E_TASKID_C0_GK,      task_C0_GK,         task_C0_GK_init,        128UL,      "C0 GK task" },         /* Application serial debug queue Gatekeeper task */
-	{  E_TASKID_C0_2MS,	 	task_C0_2MS,		task_C0_2MS_init,		128UL,		"C0 2ms Task" },		/* 2ms task */
-	{  E_TASKID_C0_10MS,	task_C0_10MS,		task_C0_10MS_init,		128UL,		"C0 10ms Task" },		/* 10ms task */
-	{  E_TASKID_C0_25MS,	task_C0_25MS,		task_C0_25MS_init,		128UL,		"C0 25ms Task" },		/* 25ms task */
-	{  E_TASKID_C0_50MS,	task_C0_50MS,		task_C0_50MS_init,		128UL,		"C0 50ms Task" },		/* 50ms task */
-	{  E_TASKID_C0_100MS,	task_C0_100MS,		task_C0_100MS_init,		128UL,		"C0 100ms Task" },		/* 100ms task */
-	{  E_TASKID_C0_500MS,	task_C0_500MS,		task_C0_500MS_init,		128UL,		"C0 500ms Task" },		/* 500ms task */
-	{  E_TASKID_C0_1000MS,	task_C0_1000MS,		task_C0_1000MS_init,	128UL,		"C0 1000ms Task" },		/* 1000ms task */
-	{  E_TASKID_C0_2000MS,	task_C0_2000MS,		task_C0_2000MS_init,	128UL,		"C0 2000ms Task" },		/* 2000ms task */
-	{  E_TASKID_C0_5000MS,	task_C0_5000MS,		task_C0_5000MS_init,	128UL,		"C0 5000ms Task" },		/* 5000ms task */
-//    {  E_TASKID_C0_UART_GK, task_C0_uart_gk,    task_C0_uart_gk_init,   128UL,      "C0 UART GK Task" },    /* UART interfaces Gatekeeper task */
-//    {  E_TASKID_C0_I2C_GK,  task_C0_i2c_gk,     task_C0_i2c_gk_init,    128UL,      "C0 I2C GK Task" },     /* I2C interfaces Gatekeeper task */
-//    {  E_TASKID_C0_SPI_GK,  task_C0_spi_gk,     task_C0_spi_gk_init,    128UL,      "C0 SPI GK Task" },     /* SPI interfaces Gatekeeper task */
-    {  E_TASKID_C0_MY_TASK,  task_C0_my_task,     task_C0_my_task_init,    128UL,      "C0 My Task Task" },     /* My Task task */
+	/* taskid			 	mainproc			initproc		   		stacksize	usesfpu	name[20] */
+	{  E_TASKID_C0_GK,		task_C0_GK,			task_C0_GK_init,		128UL,		FALSE,		"C0 GK task" },			/* Event driven Gatekeeper task, see gatekeeper.c */
+	{  E_TASKID_C0_2MS,	 	task_C0_2MS,		task_C0_2MS_init,		128UL,		FALSE,		"C0 2ms Task" },		/* 2ms task */
+	{  E_TASKID_C0_10MS,	task_C0_10MS,		task_C0_10MS_init,		128UL,		FALSE,		"C0 10ms Task" },		/* 10ms task */
+	{  E_TASKID_C0_25MS,	task_C0_25MS,		task_C0_25MS_init,		128UL,		FALSE,		"C0 25ms Task" },		/* 25ms task */
+	{  E_TASKID_C0_50MS,	task_C0_50MS,		task_C0_50MS_init,		128UL,		FALSE,		"C0 50ms Task" },		/* 50ms task */
+	{  E_TASKID_C0_100MS,	task_C0_100MS,		task_C0_100MS_init,		128UL,		FALSE,		"C0 100ms Task" },		/* 100ms task */
+	{  E_TASKID_C0_500MS,	task_C0_500MS,		task_C0_500MS_init,		128UL,		FALSE,		"C0 500ms Task" },		/* 500ms task */
+	{  E_TASKID_C0_1000MS,	task_C0_1000MS,		task_C0_1000MS_init,	128UL,		FALSE,		"C0 1000ms Task" },		/* 1000ms task */
+	{  E_TASKID_C0_2000MS,	task_C0_2000MS,		task_C0_2000MS_init,	128UL,		FALSE,		"C0 2000ms Task" },		/* 2000ms task */
+	{  E_TASKID_C0_5000MS,	task_C0_5000MS,		task_C0_5000MS_init,	128UL,		FALSE,		"C0 5000ms Task" },		/* 5000ms task */
+//    {  E_TASKID_C0_UART_GK, task_C0_uart_gk,    task_C0_uart_gk_init,   128UL,		FALSE,      "C0 UART GK Task" },    /* UART interfaces Gatekeeper task */
+//    {  E_TASKID_C0_I2C_GK,  task_C0_i2c_gk,     task_C0_i2c_gk_init,    128UL,		FALSE,      "C0 I2C GK Task" },     /* I2C interfaces Gatekeeper task */
+//    {  E_TASKID_C0_SPI_GK,  task_C0_spi_gk,     task_C0_spi_gk_init,    128UL,		FALSE,      "C0 SPI GK Task" },     /* SPI interfaces Gatekeeper task */
+    {  E_TASKID_C0_MY_TASK,  task_C0_my_task,     task_C0_my_task_init,    128UL,		FALSE,      "C0 My Task Task" },     /* My Task task */
 };
 
 #define TaskConfigCount sizeof( TaskConfigList ) / sizeof( TaskConfigList[ 0 ] )
@@ -129,7 +130,7 @@ static const S_TASK_PARAMS TaskParamsList[] =
 	 */
 	/*                                                                   				|-- User Defined Task Encapsulated Variables --------> */
 	/* coreid      taskid				enabled		period      priority				Serial trace handle */
-//	{  eCORE_0,    E_TASKID_C0_GK,		TRUE,       100u,		tskIDLE_PRIORITY + 7,	( QueueHandle_t ) &xSerialTraceHandle, },
+	{  eCORE_0,    E_TASKID_C0_GK,		TRUE,		0u,			tskIDLE_PRIORITY + 7,	( QueueHandle_t ) &xSerialTraceHandle, },	/* Period unused: event driven */
 	{  eCORE_0,    E_TASKID_C0_2MS,		TRUE,		2u,			tskIDLE_PRIORITY + 9,	( QueueHandle_t ) &xSerialTraceHandle, },
 	{  eCORE_0,    E_TASKID_C0_10MS,	TRUE,		10u,		tskIDLE_PRIORITY + 9,	( QueueHandle_t ) &xSerialTraceHandle, },
 	{  eCORE_0,    E_TASKID_C0_25MS,	TRUE,		25u,		tskIDLE_PRIORITY + 8,	( QueueHandle_t ) &xSerialTraceHandle, },
@@ -361,6 +362,7 @@ portBaseType tskCreateCoreTasks( U8 coreid )
 					ptr_task_proc_data->priority = ptr_task_params_list->priority;
 					ptr_task_proc_data->coreid = ptr_task_params_list->coreid;
 					ptr_task_proc_data->period = ptr_task_params_list->period;
+					ptr_task_proc_data->usesfpu = ptr_task_config_list->usesfpu;
 
 					/* =====================================================================
 					 *
@@ -452,18 +454,18 @@ portBaseType tskCreateCoreTasks( U8 coreid )
 					create_task_result == pdPASS ? ( create_core_tasks_result = TRUE ) : ( ptr_task_proc_data->error = create_task_result );
 					if ( TRUE == create_core_tasks_result )
 					{
-						// printf( "Successfully created task: %s\r\n", ptr_task_config_list->name );
+						LOG1( eLOG_MSG_TASK_CREATED, ptr_task_config_list->taskid );
 					}
 					else
 					{
-						// printf( "Unsuccessfully created task: %s.  Error: %d\r\n", ptr_task_config_list->name, ptr_task_proc_data->error );
+						LOG2( eLOG_MSG_TASK_CREATE_FAILED, ptr_task_config_list->taskid, ptr_task_proc_data->error );
 					    // __asm( " nop" );
 					}
 
 					/* Run task's init function if defined ( Note: Task must have been created ) */
 					if ( ( TRUE == create_core_tasks_result ) && ( NULL != ptr_task_config_list->initproc ) )
 					{
-						// printf( "Calling init function of task: %s\r\n", ptr_task_config_list->name );
+						LOG1( eLOG_MSG_TASK_INIT, ptr_task_config_list->taskid );
 						( ptr_task_config_list->initproc )();
 					}
 				}
@@ -481,6 +483,8 @@ portBaseType tskCreateCoreTasks( U8 coreid )
 |    Description       :  Function to initialize the task's process data:     |
 |                             starttime,                                      |
 |                             state                                           |
+|                         and to give the task a floating point context if    |
+|                         its configuration asks for one.                     |
 |                                                                             |
 |    Inputs            :  Pointer to the task's process data.                 |
 |                                                                             |
@@ -488,12 +492,17 @@ portBaseType tskCreateCoreTasks( U8 coreid )
 |                                                                             |
 |    Return            :  none.                                               |
 |                                                                             |
-|    Warnings          :  none.                                               |
+|    Warnings          :  Must be called by the task itself, first thing.      |
 |                                                                             |
 \----------------------------------------------------------------------------*/
 
 void tskInitTaskProcData( S_TASKPROC_DATA *procdata )
 {
+	if ( TRUE == procdata->usesfpu )
+	{
+		vPortTaskUsesFPU();
+	}
+
     procdata->starttime	= xTaskGetTickCount();
 	procdata->state = TASK_STATE_RUNINIT;
 }
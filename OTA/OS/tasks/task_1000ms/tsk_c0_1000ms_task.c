@@ -36,6 +36,8 @@
 #include "coreParams.h"
 #include "setup.h"
 #include "trace.h"
+#include "gatekeeper.h"
+#include "fw_log.h"
 
 /*----------------------------------------------------------------------------\
 |   Public Constant Definitions                                               |
@@ -114,9 +116,12 @@ void task_C0_1000MS( void *params )
 	for ( ;; )
 	{
 #if 0
-		ok = xQueueSend( procdata->xSerialTraceHandle, &SerialTraceInfo, 0 );
+		ok = gkPost( eGK_SRC_SERIAL_TRACE, &SerialTraceInfo );
 		/* Examine reason for unsuccessful send, eg. Queue Full ( ok = -4 ) */
-		( ( ok == pdPASS ) ? ( { __asm volatile ( " nop" ); } ) : ( printf( "task_C0_1000MS - Serial Debug Queue Error: %d\r\n", ok ) ) );
+		if ( ok != pdPASS )
+		{
+			LOG2( eLOG_MSG_TRACE_QUEUE_ERROR, procdata->taskid, ok );
+		}
 #endif
 
 		/* Call the application task */
@@ -124,11 +129,12 @@ void task_C0_1000MS( void *params )
 
 	    /* Update task process data */
 		ok = tskUpdateTaskProcData( procdata );
-		//?? ( ( ok == pdPASS ) ? ( { __asm volatile ( " nop" ); } ) : ( printf( "Task overrun: 1000ms\r\n" ) ) );
+		if ( ok != pdPASS )
+		{
+			LOG3( eLOG_MSG_TASK_OVERRUN, procdata->taskid, procdata->period, procdata->callcount );
+		}
 
-#if 0
-		printf( "C0 1000ms task callcount: %d\r\n", procdata->callcount );
-#endif
+		LOG2( eLOG_MSG_TASK_CALLCOUNT, procdata->taskid, procdata->callcount );
 
 		/* Block until next run for the configured period */
 		vTaskDelayUntil( ( TickType_t * ) &( procdata->starttime ), ( TickType_t ) procdata->period );
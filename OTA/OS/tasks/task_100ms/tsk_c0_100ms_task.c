@@ -36,6 +36,10 @@
 #include "coreParams.h"
 #include "setup.h"
 #include "trace.h"
+#include "gatekeeper.h"
+#include "fw_log.h"
+#include "fw_trace.h"
+#include "dm_history.h"
 
 /*----------------------------------------------------------------------------\
 |   Public Constant Definitions                                               |
@@ -49,18 +53,35 @@
 |   Private Type Definitions                                                  |
 \----------------------------------------------------------------------------*/
 
+/* Sends one frame of its stream if the debug UART is idle, TRUE if it did */
+typedef BOOLEAN ( *DRAIN_FUNC )( void );
+
 /*----------------------------------------------------------------------------\
 |   Private Constant Definitions                                              |
 \----------------------------------------------------------------------------*/
 
+/* Streams sharing the debug UART */
+static const DRAIN_FUNC drain_funcs[] =
+{
+    logDrain,
+    trcDrain,
+    dmHistoryDrain,
+};
+
+#define DRAIN_FUNCS                 ( sizeof( drain_funcs ) / sizeof( drain_funcs[ 0 ] ) )
+
 /*----------------------------------------------------------------------------\
 |   Private Data Definitions                                                  |
 \----------------------------------------------------------------------------*/
 
+static U32 drain_next = 0u;         /* Stream asked first in the next slot */
+
 /*----------------------------------------------------------------------------\
 |   Private Function Declarations                                             |
 \----------------------------------------------------------------------------*/
 
+static void tskDrainDebugUart( void );
+
 /*----------------------------------------------------------------------------\
 |   Public Function Implementations                                           |
 \----------------------------------------------------------------------------*/
@@ -119,21 +140,28 @@ void task_C0_100MS( void *params )
          * No point sending serial debug info to gatekeeper task that runs every 100ms.
 		 * This action will cause queue overflow.
 		 */
-		ok = xQueueSend( procdata->xSerialTraceHandle, &SerialTraceInfo, 0 );
+		ok = gkPost( eGK_SRC_SERIAL_TRACE, &SerialTraceInfo );
 		/* Examine reason for unsuccessful send, eg. Queue Full ( ok = -4 ) */
-		( ( ok == pdPASS ) ? ( { __asm volatile ( " nop" ); } ) : ( printf( "task_C0_100MS - Serial Debug Queue Error: %d\r\n", ok ) ) );
+		if ( ok != pdPASS )
+		{
+			LOG2( eLOG_MSG_TRACE_QUEUE_ERROR, procdata->taskid, ok );
+		}
 #endif
 
 		/* Call the application task */
 		app_task_100ms();
 
+		/* Background drain of the binary log, event trace and history dumps */
+		tskDrainDebugUart();
+
 	    /* Update task process data */
 		ok = tskUpdateTaskProcData( procdata );
-		//?? ( ( ok == pdPASS ) ? ( { __asm volatile ( " nop" ); } ) : ( printf( "Task overrun: 100ms\r\n" ) ) );
+		if ( ok != pdPASS )
+		{
+			LOG3( eLOG_MSG_TASK_OVERRUN, procdata->taskid, procdata->period, procdata->callcount );
+		}
 
-#if 0
-		printf( "C0 100ms task callcount: %d\r\n", procdata->callcount );
-#endif
+		LOG2( eLOG_MSG_TASK_CALLCOUNT, procdata->taskid, procdata->callcount );
 
 		/* Block until next run for the configured period */
 		vTaskDelayUntil( ( TickType_t * ) &( procdata->starttime ), ( TickType_t ) procdata->period );
@@ -144,6 +172,42 @@ void task_C0_100MS( void *params )
 |   Private Function Implementations                                          |
 \----------------------------------------------------------------------------*/
 
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|    Procedure         :  tskDrainDebugUart                                   |
+|                                                                             |
+|    Description       :  Sends at most one frame on the debug UART. The      |
+|                         streams are asked in turn, starting after the one   |
+|                         that sent last, so steady log traffic cannot        |
+|                         starve the trace or a history dump.                 |
+|                                                                             |
+|    Inputs            :  none.                                               |
+|                                                                             |
+|    Outputs           :  none.                                               |
+|                                                                             |
+|    Return            :  none.                                               |
+|                                                                             |
+|    Warnings          :  none.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+static void tskDrainDebugUart( void )
+{
+    U32 i;
+    U32 stream;
+
+    for ( i = 0u; i < DRAIN_FUNCS; i++ )
+    {
+        stream = ( drain_next + i ) % DRAIN_FUNCS;
+
+        if ( drain_funcs[ stream ]() == TRUE )
+        {
+            drain_next = ( stream + 1u ) % DRAIN_FUNCS;
+            break;
+        }
+    }
+}
+
 /*----------------------------------------------------------------------------\
 |   End of tsk_C0_100ms_task.c Module                                         |
 \----------------------------------------------------------------------------*/
@@ -36,6 +36,8 @@
 #include "coreParams.h"
 #include "setup.h"
 #include "trace.h"
+#include "gatekeeper.h"
+#include "fw_log.h"
 
 /*----------------------------------------------------------------------------\
 |   Public Constant Definitions                                               |
@@ -119,9 +121,12 @@ void task_C0_10MS( void *params )
          * No point sending serial debug info to gatekeeper task that runs every 10ms.
 		 * This action will cause queue overflow.
 		 */
-		ok = xQueueSend( procdata->xSerialTraceHandle, &SerialTraceInfo, 0 );
+		ok = gkPost( eGK_SRC_SERIAL_TRACE, &SerialTraceInfo );
 		/* Examine reason for unsuccessful send, eg. Queue Full ( ok = -4 ) */
-		( ( ok == pdPASS ) ? ( { __asm volatile ( " nop" ); } ) : ( printf( "task_C0_10MS - Serial Debug Queue Error: %d\r\n", ok ) ) );
+		if ( ok != pdPASS )
+		{
+			LOG2( eLOG_MSG_TRACE_QUEUE_ERROR, procdata->taskid, ok );
+		}
 #endif
 
 		/* Call the application task */
@@ -129,11 +134,12 @@ void task_C0_10MS( void *params )
 
 	    /* Update task process data */
 		ok = tskUpdateTaskProcData( procdata );
-		//?? ( ( ok == pdPASS ) ? ( { __asm volatile ( " nop" ); } ) : ( printf( "Task overrun: 10ms\r\n" ) ) );
+		if ( ok != pdPASS )
+		{
+			LOG3( eLOG_MSG_TASK_OVERRUN, procdata->taskid, procdata->period, procdata->callcount );
+		}
 
-#if 0
-		printf( "C0 10ms task callcount: %d\r\n", procdata->callcount );
-#endif
+		LOG2( eLOG_MSG_TASK_CALLCOUNT, procdata->taskid, procdata->callcount );
 
 		/* Block until next run for the configured period */
 		vTaskDelayUntil( ( TickType_t * ) &( procdata->starttime ), ( TickType_t ) procdata->period );
@@ -17,6 +17,9 @@
 |                                                                             |
 |   Application tsk_c0_gk_task.c Module                                       |
 |                                                                             |
+|   Event driven, see gatekeeper.c. The task only wakes when a source has     |
+|   been signalled and drains all of its pending items at once.               |
+|                                                                             |
 \----------------------------------------------------------------------------*/
 
 /*----------------------------------------------------------------------------\
@@ -38,6 +41,8 @@
 #include "taskParams.h"
 #include "setup.h"
 #include "trace.h"
+#include "gatekeeper.h"
+#include "fw_log.h"
 
 /*----------------------------------------------------------------------------\
 |   Public Constant Definitions                                               |
@@ -106,25 +111,38 @@ void task_C0_GK_init( void )
 
 void task_C0_GK( void *params )
 {
-	portBaseType ok;
-	S_SERIAL_TRACE_INFO selfSerialTraceInfo, SerialTraceInfo;
 	S_TASKPROC_DATA	*procdata	= ( S_TASKPROC_DATA* ) params;
 
     tskInitTaskProcData( procdata );             			/* Initialize task process data: start time and state */
-    tskInitTraceInfo( procdata, &selfSerialTraceInfo );		/* Initialize task's constant serial trace info */
 
 	for ( ;; )
 	{
-		ok = xQueueReceive( procdata->xSerialTraceHandle, &SerialTraceInfo, 0 );
-		// ( ( ok == pdPASS ) ? ( { memcpy( &xSerialMessage[ procdata->coreid ], &SerialTraceInfo, sizeof( S_SERIAL_TRACE_INFO ) ); } ) : ( { __asm volatile ( " nop" ); } ) );
+		/* Block until a source is signalled, then drain everything pending */
+		gkServe( procdata );
+	}
+}
 
-		/* Update task process data */
-		ok = tskUpdateTaskProcData( procdata );
-		//?? ( ( ok == pdPASS ) ? ( { __asm volatile ( " nop" ); } ) : ( printf( "Task overrun: task_C0_GK\r\n" ) ) );
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|    Procedure         :  task_C0_GK_serial_trace                             |
+|                                                                             |
+|    Description       :  Gatekeeper handler of eGK_SRC_SERIAL_TRACE: keeps   |
+|                         the latest trace message of the core.               |
+|                                                                             |
+|    Inputs            :  Pointer to the S_SERIAL_TRACE_INFO received.        |
+|                                                                             |
+|    Outputs           :  none.                                               |
+|                                                                             |
+|    Return            :  none.                                               |
+|                                                                             |
+|    Warnings          :  Runs in the GK task only.                           |
+|                                                                             |
+\----------------------------------------------------------------------------*/
 
-		/* Block until next run for the configured period */
-		vTaskDelayUntil( ( TickType_t * ) &( procdata->starttime ), ( TickType_t ) procdata->period );
-	}
+void task_C0_GK_serial_trace( const void *item )
+{
+	memcpy( &xSerialMessage[ eCORE_0 ], item, sizeof( S_SERIAL_TRACE_INFO ) );
+	xSerialMessage[ eCORE_0 ].name[ TASK_NAME_LENGTH_MAX ] = '\0';
 }
 
 /*----------------------------------------------------------------------------\
@@ -40,6 +40,7 @@
 
 void task_C0_GK_init( void );
 void task_C0_GK( void *params );
+void task_C0_GK_serial_trace( const void *item );
 
 /*----------------------------------------------------------------------------\
 |   End of task_c0_gk_task.h Task Header File                                 |
@@ -0,0 +1,189 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : ctx_bench.c Module File.                                   |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Context switch cost benchmark.                                            |
+|                                                                             |
+|   Ping and pong run at the same top priority, so a give never preempts:     |
+|   each round trip is exactly two switches, ping blocking in its take and    |
+|   then pong in its own. The FPU run starts once both tasks have called      |
+|   vPortTaskUsesFPU().                                                       |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Compiler Controls                                                         |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "FreeRTOS.h"
+#include "os_task.h"
+
+#include "HL_sys_pmu.h"
+
+#include "fw_log.h"
+#include "ctx_bench.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define CTX_BENCH_PRIORITY          ( ( configMAX_PRIORITIES - 1u ) | portPRIVILEGE_BIT )   /* Privileged for the PMU */
+#define CTX_BENCH_STACK             128u                /* Words */
+#define CTX_BENCH_WARMUP            16u                 /* Round trips before a run, pong marks itself in these */
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+#if ( CTX_BENCH_ENABLED == 1 )
+static TaskHandle_t ctx_bench_ping = NULL;
+static TaskHandle_t ctx_bench_pong = NULL;
+static volatile BOOLEAN ctx_bench_fpu = FALSE;          /* Pong to take an FPU context */
+#endif
+static S_CTX_BENCH_RESULT ctx_bench_result;
+
+/*----------------------------------------------------------------------------\
+|   Private Function Declarations                                             |
+\----------------------------------------------------------------------------*/
+
+#if ( CTX_BENCH_ENABLED == 1 )
+static void ctxBenchPing( void *params );
+static void ctxBenchPong( void *params );
+static void ctxBenchRound( void );
+#endif
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : ctxBenchInit                                        |
+|                                                                             |
+|   Description         : Creates the ping and pong tasks when the benchmark  |
+|                         is enabled; they run as soon as the scheduler       |
+|                         starts and delete themselves when done.             |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Called from main(), before the scheduler starts.    |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void ctxBenchInit( void )
+{
+    ctx_bench_result.done = FALSE;
+
+#if ( CTX_BENCH_ENABLED == 1 )
+    _pmuEnableCountersGlobal_();
+    _pmuStartCounters_( pmuCYCLE_COUNTER );
+
+    if ( ( xTaskCreate( ctxBenchPong, "ctx pong", CTX_BENCH_STACK, NULL, CTX_BENCH_PRIORITY, &ctx_bench_pong ) != pdPASS ) ||
+         ( xTaskCreate( ctxBenchPing, "ctx ping", CTX_BENCH_STACK, NULL, CTX_BENCH_PRIORITY, &ctx_bench_ping ) != pdPASS ) )
+    {
+        LOG0( eLOG_MSG_CTX_BENCH_FAILED );
+    }
+#endif
+}
+
+const S_CTX_BENCH_RESULT * ctxBenchGetResult( void )
+{
+    return &ctx_bench_result;
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+#if ( CTX_BENCH_ENABLED == 1 )
+
+static void ctxBenchPing( void *params )
+{
+    U32 run;
+    U32 i;
+    U32 start;
+
+    ( void ) params;
+
+    for ( run = 0u; run < eCTX_BENCH_MAX; run++ )
+    {
+        if ( run == eCTX_BENCH_FPU )
+        {
+            vPortTaskUsesFPU();
+            ctx_bench_fpu = TRUE;
+        }
+
+        for ( i = 0u; i < CTX_BENCH_WARMUP; i++ )
+        {
+            ctxBenchRound();
+        }
+
+        start = _pmuGetCycleCount_();
+        for ( i = 0u; i < CTX_BENCH_ROUNDS; i++ )
+        {
+            ctxBenchRound();
+        }
+        ctx_bench_result.cycles[ run ] = ( _pmuGetCycleCount_() - start ) / ( 2u * CTX_BENCH_ROUNDS );
+
+        LOG2( eLOG_MSG_CTX_BENCH, run, ctx_bench_result.cycles[ run ] );
+    }
+
+    ctx_bench_result.done = TRUE;
+
+    vTaskDelete( ctx_bench_pong );
+    vTaskDelete( NULL );
+}
+
+static void ctxBenchPong( void *params )
+{
+    BOOLEAN marked = FALSE;
+
+    ( void ) params;
+
+    for ( ;; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        if ( ( ctx_bench_fpu == TRUE ) && ( marked == FALSE ) )
+        {
+            vPortTaskUsesFPU();
+            marked = TRUE;
+        }
+
+        ( void ) xTaskNotifyGive( ctx_bench_ping );
+    }
+}
+
+/* One round trip: wake pong, block until it answers */
+static void ctxBenchRound( void )
+{
+    ( void ) xTaskNotifyGive( ctx_bench_pong );
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+}
+
+#endif
+
+/*----------------------------------------------------------------------------\
+|   End of ctx_bench.c module                                                 |
+\----------------------------------------------------------------------------*/
@@ -0,0 +1,74 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : ctx_bench.h Header File.                                   |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Context switch cost benchmark.                                            |
+|                                                                             |
+|   Two tasks hand a task notification back and forth, first without and      |
+|   then with a floating point context, which is what every task paid         |
+|   before lazy FPU contexts. The PMU cycle count per switch of each run      |
+|   is logged ( eLOG_MSG_CTX_BENCH ).                                         |
+|                                                                             |
+|   Off by default: the two tasks take about 1.2 KB of heap_4 and hold the    |
+|   CPU at the top priority for the duration of the runs.                     |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef ctx_bench_H
+#define ctx_bench_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "fw_types.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+#define CTX_BENCH_ENABLED           0
+#define CTX_BENCH_ROUNDS            1000u               /* Round trips per run, two switches each */
+
+/*----------------------------------------------------------------------------\
+|   Public Type Definitions                                                   |
+\----------------------------------------------------------------------------*/
+
+typedef enum
+{
+    eCTX_BENCH_NO_FPU = 0u,
+    eCTX_BENCH_FPU,
+    eCTX_BENCH_MAX,
+} E_CTX_BENCH_RUN;
+
+typedef struct
+{
+    U32                         cycles[ eCTX_BENCH_MAX ];   /* Per switch, including the notify calls */
+    BOOLEAN                     done;
+} S_CTX_BENCH_RESULT;
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+void ctxBenchInit( void );
+const S_CTX_BENCH_RESULT * ctxBenchGetResult( void );
+
+/*----------------------------------------------------------------------------\
+|   End of ctx_bench.h header file                                            |
+\----------------------------------------------------------------------------*/
+
+#endif  /* ctx_bench_H */
@@ -15,7 +15,7 @@
 |                                                                             |
 |-----------------------------------------------------------------------------|
 |                                                                             |
-|   <Module Description>                                                      |
+|   Data Manager: versioned, double buffered datasets.                        |
 |                                                                             |
 \----------------------------------------------------------------------------*/
 
@@ -27,26 +27,90 @@
 |   Header Files                                                              |
 \----------------------------------------------------------------------------*/
 
+#include <string.h>
+
+#include "HL_sys_core.h"
+
+#include "fw_atomic.h"
 #include "data_manager.h"
+#include "dm_history.h"
 
 /*----------------------------------------------------------------------------\
 |   Private Type Definitions                                                  |
 \----------------------------------------------------------------------------*/
 
+/*
+ * Latched sequence counter: two copies of a dataset and a sequence number
+ * whose low bit selects the copy readers use. The writer always updates the
+ * copy readers are not using, so a reader that interrupts a writer still
+ * gets a complete snapshot at the first attempt. A reader interrupted by a
+ * writer sees the sequence change and copies again.
+ */
+typedef struct
+{
+    volatile U32        seq;                /* Bumped twice per publish */
+    void *              copy[ 2 ];
+    U32                 size;               /* Bytes per copy */
+} S_DM_LATCH;
+
+typedef struct
+{
+    TaskHandle_t        task;
+    U32                 notify_bits;        /* Set in the task's notification value on a change */
+    U32                 mask[ DM_SIGNAL_WORDS ];
+    volatile U32        pending[ DM_SIGNAL_WORDS ];     /* Changed since the last dmTakeChanges() */
+} S_DM_SUBSCRIBER;
+
 /*----------------------------------------------------------------------------\
 |   Private Constant Definitions                                              |
 \----------------------------------------------------------------------------*/
 
+#define DM_CPSR_MODE_MASK           0x1Fu
+#define DM_CPSR_MODE_FIQ            0x11u
+#define DM_CPSR_MODE_IRQ            0x12u
+
+#define DM_STATIC_ASSERT( name, cond )      typedef char dm_assert_##name[ ( cond ) ? 1 : -1 ]
+
+/* dm_signals.h must list the dataset signals in dataset order */
+DM_STATIC_ASSERT( di_aisg_dir, eDM_SIG_DI_AISG_DIR == DM_SIG_DI( eDIO_INPUT_PIN_H16_AISG_DIR ) );
+DM_STATIC_ASSERT( do_led_6, eDM_SIG_DO_LED_6 == DM_SIG_DO( eDIO_OUTPUT_PIN_LED_6 ) );
+DM_STATIC_ASSERT( do_led_7, eDM_SIG_DO_LED_7 == DM_SIG_DO( eDIO_OUTPUT_PIN_LED_7 ) );
+DM_STATIC_ASSERT( do_gain_1, eDM_SIG_DO_GAIN_ACTIVE_1 == DM_SIG_DO( eDIO_OUTPUT_PIN_W9_GAIN_ACTIVE_1 ) );
+DM_STATIC_ASSERT( adc1_9, eDM_SIG_ADC1_9 == DM_SIG_ADC( eADC1_9 ) );
+DM_STATIC_ASSERT( adc_last, DM_SIG_ADC( eADC_CHANNEL_MAX ) <= DM_SIGNAL_MAX );
+
+/* Signal metadata, from dm_signals.h */
+#define DM_SIGNAL( id, type, unit, num, den, offset, min, max, deadband, name ) \
+    { ( name ), ( U8 ) ( type ), ( U8 ) ( unit ), ( num ), ( den ), ( offset ), ( min ), ( max ), ( deadband ) },
+static const S_DM_SIGNAL_INFO dm_signal_info[ DM_SIGNAL_MAX ] =
+{
+    DM_SIGNALS
+};
+#undef DM_SIGNAL
+
 /*----------------------------------------------------------------------------\
 |   Private Data Declarations                                                 |
 \----------------------------------------------------------------------------*/
 
 /* Data structures. */
-static S_DM_DATABASE                dm_database;
+static S_DIGITAL_IO                 dm_digital_io[ 2 ];
+static S_ANALOGUE_INPUTS            dm_analogue_inputs[ 2 ];
+
+/* Dataset latches. */
+static S_DM_LATCH                   dm_digitals_latch;
+static S_DM_LATCH                   dm_analogue_inputs_latch;
+
+/* Raw signal values, indexed by E_DM_SIGNAL_ID. */
+static volatile S32                 dm_values[ DM_SIGNAL_MAX ];
+
+/* Per signal change tracking, written by the signal's writer only. */
+static volatile U32                 dm_signal_version[ DM_SIGNAL_MAX ];
+static S32                          dm_signal_reported[ DM_SIGNAL_MAX ];    /* Value at the last reported change */
+static U32                          dm_signal_deadband[ DM_SIGNAL_MAX ];
 
-/* Instantiate the Data Manager Transport structures. */
-static S_DM_DIGITAL_IO              dm_digitals_dataset;
-static S_DM_ANALOGUE_INPUTS         dm_analogue_inputs_dataset;
+/* Subscribers. */
+static S_DM_SUBSCRIBER              dm_subscribers[ DM_SUBSCRIBERS_MAX ];
+static volatile U32                 dm_subscriber_count;
 
 /*----------------------------------------------------------------------------\
 |   Public Constant Declarations                                              |
@@ -56,13 +120,16 @@ static S_DM_ANALOGUE_INPUTS         dm_analogue_inputs_dataset;
 |   Private Function Declarations                                             |
 \----------------------------------------------------------------------------*/
 
+static void dmLatchInit( S_DM_LATCH *latch, void *copy0, void *copy1, U32 size );
+static void dmLatchPublish( S_DM_LATCH *latch, const void *src );
+static U32 dmLatchRead( const S_DM_LATCH *latch, void *dst );
+static void dmSignalStore( U32 signal, S32 value, U32 changed[ DM_SIGNAL_WORDS ] );
+static void dmNotify( const U32 changed[ DM_SIGNAL_WORDS ] );
+
 /*----------------------------------------------------------------------------\
 |   Public Function Implementations                                           |
 \----------------------------------------------------------------------------*/
 
-/*----------------------------------------------------------------------------\
-|   Private Function Implementations                                          |
-\----------------------------------------------------------------------------*/
 /*----------------------------------------------------------------------------\
 |                                                                             |
 |   Procedure           : dmDataManagerInit                                   |
@@ -84,77 +151,544 @@ static S_DM_ANALOGUE_INPUTS         dm_analogue_inputs_dataset;
 
 void dmDataManagerInit( void )
 {
+    U32 i;
+
     /* TODO Initialize non-volatile data here */
 
-    /* TODO HIGH Assign all structure pointers to transport structures */
-    dm_digitals_dataset.ptr_digital_io = &dm_database.digital_io;
-    dm_analogue_inputs_dataset.ptr_analogue_inputs = &dm_database.analogue_inputs;
+    dmLatchInit( &dm_digitals_latch, &dm_digital_io[ 0 ], &dm_digital_io[ 1 ], sizeof( S_DIGITAL_IO ) );
+    dmLatchInit( &dm_analogue_inputs_latch, &dm_analogue_inputs[ 0 ], &dm_analogue_inputs[ 1 ], sizeof( S_ANALOGUE_INPUTS ) );
+
+    memset( ( void * ) dm_values, 0, sizeof( dm_values ) );
+    memset( ( void * ) dm_signal_version, 0, sizeof( dm_signal_version ) );
+    memset( dm_signal_reported, 0, sizeof( dm_signal_reported ) );
+
+    for ( i = 0u; i < DM_SIGNAL_MAX; i++ )
+    {
+        dm_signal_deadband[ i ] = dm_signal_info[ i ].deadband;
+    }
+
+    memset( dm_subscribers, 0, sizeof( dm_subscribers ) );
+    dm_subscriber_count = 0u;
+
+    dmHistoryInit();
 }
 
 /*----------------------------------------------------------------------------\
 |                                                                             |
-|   Procedure           : dmFullDataAccess                                    |
+|   Procedure           : dmFullDataRead                                      |
 |                                                                             |
-|   Description         : This function returns a pointer to the total        |
-|                         structure                                           |
+|   Description         : This function copies a snapshot of every dataset.   |
 |                                                                             |
 |   Inputs              : None.                                               |
 |                                                                             |
-|   Outputs             : None.                                               |
+|   Outputs             : The database.                                       |
 |                                                                             |
-|   Return              : Pointer to the database access structure.           |
+|   Return              : None.                                               |
 |                                                                             |
-|   Warnings            : None.                                               |
+|   Warnings            : Each dataset is consistent on its own, two datasets |
+|                         may come from different publishes.                  |
 |                                                                             |
 \----------------------------------------------------------------------------*/
 
-S_DM_DATABASE *dmFullDataAccess( void )
+void dmFullDataRead( S_DM_DATABASE *dst )
 {
-    return &dm_database;
+    ( void ) dmLatchRead( &dm_digitals_latch, &dst->digital_io );
+    ( void ) dmLatchRead( &dm_analogue_inputs_latch, &dst->analogue_inputs );
 }
 
 /*----------------------------------------------------------------------------\
 |                                                                             |
-|   Procedure           : dmDigitalssAccess                                   |
+|   Procedure           : dmDigitalsRead                                      |
 |                                                                             |
-|   Description         : This function returns a pointer to the              |
+|   Description         : This function copies a consistent snapshot of the   |
 |                         Digitals                                            |
 |                                                                             |
 |   Inputs              : None.                                               |
 |                                                                             |
-|   Outputs             : None.                                               |
+|   Outputs             : The Digitals.                                       |
 |                                                                             |
-|   Return              : Pointer to the database access structure.           |
+|   Return              : Version of the snapshot ( number of publishes ).    |
 |                                                                             |
 |   Warnings            : None.                                               |
 |                                                                             |
 \----------------------------------------------------------------------------*/
 
-S_DM_DIGITAL_IO *dmDigitalsAccess( void )
+U32 dmDigitalsRead( S_DIGITAL_IO *dst )
 {
-    return &dm_digitals_dataset;
+    return dmLatchRead( &dm_digitals_latch, dst );
 }
 
 /*----------------------------------------------------------------------------\
 |                                                                             |
-|   Procedure           : dmAnalogueInputsAccess                              |
+|   Procedure           : dmDigitalsPublish                                   |
+|                                                                             |
+|   Description         : This function replaces the Digitals                 |
 |                                                                             |
-|   Description         : This function returns a pointer to the              |
+|   Inputs              : The new Digitals.                                   |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Single writer context only.                         |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void dmDigitalsPublish( const S_DIGITAL_IO *src )
+{
+    U32 i;
+    U32 changed[ DM_SIGNAL_WORDS ] = { 0u };
+    const S_DIO_INPUT_PIN_DEF * const p_di = dioConfigGetDIConfig();
+    const S_DIO_OUTPUT_PIN_DEF * const p_do = dioConfigGetDOConfig();
+
+    dmLatchPublish( &dm_digitals_latch, src );
+
+    for ( i = 0u; i < eDIO_NUM_INPUT_PINS; i++ )
+    {
+        dmSignalStore( DM_SIG_DI( i ), ( S32 ) DIO_BIT( src->ports.inputs, p_di[ i ].port, p_di[ i ].pin ), changed );
+    }
+
+    for ( i = 0u; i < eDIO_NUM_OUTPUT_PINS; i++ )
+    {
+        dmSignalStore( DM_SIG_DO( i ), ( S32 ) DIO_BIT( src->ports.outputs, p_do[ i ].port, p_do[ i ].pin ), changed );
+    }
+
+    dmNotify( changed );
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dmAnalogueInputsRead                                |
+|                                                                             |
+|   Description         : This function copies a consistent snapshot of the   |
 |                         Analogue Inputs                                     |
 |                                                                             |
 |   Inputs              : None.                                               |
 |                                                                             |
+|   Outputs             : The Analogue Inputs.                                |
+|                                                                             |
+|   Return              : Version of the snapshot ( number of publishes ).    |
+|                                                                             |
+|   Warnings            : None.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+U32 dmAnalogueInputsRead( S_ANALOGUE_INPUTS *dst )
+{
+    return dmLatchRead( &dm_analogue_inputs_latch, dst );
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dmAnalogueInputsPublish                             |
+|                                                                             |
+|   Description         : This function replaces the Analogue Inputs          |
+|                                                                             |
+|   Inputs              : The new Analogue Inputs.                            |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Single writer context only.                         |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void dmAnalogueInputsPublish( const S_ANALOGUE_INPUTS *src )
+{
+    U32 i;
+    U32 changed[ DM_SIGNAL_WORDS ] = { 0u };
+
+    dmLatchPublish( &dm_analogue_inputs_latch, src );
+
+    for ( i = 0u; i < eADC_CHANNEL_MAX; i++ )
+    {
+        dmSignalStore( DM_SIG_ADC( i ), ( S32 ) src->adc_raw[ i ], changed );
+    }
+
+    dmNotify( changed );
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dmGetInfo                                           |
+|                                                                             |
+|   Description         : This function returns the flash resident metadata   |
+|                         of a signal                                         |
+|                                                                             |
+|   Inputs              : Signal id ( E_DM_SIGNAL_ID ).                       |
+|                                                                             |
 |   Outputs             : None.                                               |
 |                                                                             |
-|   Return              : Pointer to the database access structure.           |
+|   Return              : Metadata, NULL for an unknown signal.               |
 |                                                                             |
 |   Warnings            : None.                                               |
 |                                                                             |
 \----------------------------------------------------------------------------*/
 
-S_DM_ANALOGUE_INPUTS *dmAnalogueInputsAccess( void )
+const S_DM_SIGNAL_INFO * dmGetInfo( U32 signal )
 {
-    return &dm_analogue_inputs_dataset;
+    return ( signal < DM_SIGNAL_MAX ) ? &dm_signal_info[ signal ] : NULL;
+}
+
+S32 dmGet( U32 signal )
+{
+    return ( signal < DM_SIGNAL_MAX ) ? dm_values[ signal ] : 0;
+}
+
+/* Engineering value: raw * scale_num / scale_den + offset */
+S32 dmGetScaled( U32 signal )
+{
+    const S_DM_SIGNAL_INFO *p_info;
+
+    if ( signal >= DM_SIGNAL_MAX )
+    {
+        return 0;
+    }
+
+    p_info = &dm_signal_info[ signal ];
+
+    return ( S32 ) ( ( ( S64 ) dm_values[ signal ] * p_info->scale_num ) / p_info->scale_den ) + p_info->offset;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dmGetRange                                          |
+|                                                                             |
+|   Description         : This function copies the raw values of consecutive  |
+|                         signals                                             |
+|                                                                             |
+|   Inputs              : First signal id.                                    |
+|                         Number of signals.                                  |
+|                                                                             |
+|   Outputs             : Raw values.                                         |
+|                                                                             |
+|   Return              : Number of values copied, clipped at eDM_SIG_MAX.    |
+|                                                                             |
+|   Warnings            : Every value is consistent on its own, use the       |
+|                         dataset reads for a consistent group.               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+U32 dmGetRange( U32 first, U32 count, S32 *values )
+{
+    U32 i;
+
+    if ( first >= DM_SIGNAL_MAX )
+    {
+        return 0u;
+    }
+
+    if ( count > ( DM_SIGNAL_MAX - first ) )
+    {
+        count = DM_SIGNAL_MAX - first;
+    }
+
+    for ( i = 0u; i < count; i++ )
+    {
+        values[ i ] = dm_values[ first + i ];
+    }
+
+    return count;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dmSet                                               |
+|                                                                             |
+|   Description         : This function stores the raw value of a signal,     |
+|                         limited to its min / max, and notifies the          |
+|                         subscribers if it changed                           |
+|                                                                             |
+|   Inputs              : Signal id.                                          |
+|                         Raw value.                                          |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : FALSE for an unknown signal or a limited value.     |
+|                                                                             |
+|   Warnings            : Single writer context per signal. Signals that are  |
+|                         part of a dataset are set by the dataset publish.   |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN dmSet( U32 signal, S32 value )
+{
+    BOOLEAN ok = TRUE;
+    U32 changed[ DM_SIGNAL_WORDS ] = { 0u };
+    const S_DM_SIGNAL_INFO *p_info;
+
+    if ( signal >= DM_SIGNAL_MAX )
+    {
+        return FALSE;
+    }
+
+    p_info = &dm_signal_info[ signal ];
+    if ( value < p_info->min )
+    {
+        value = p_info->min;
+        ok = FALSE;
+    }
+    else if ( value > p_info->max )
+    {
+        value = p_info->max;
+        ok = FALSE;
+    }
+
+    dmSignalStore( signal, value, changed );
+    dmNotify( changed );
+
+    return ok;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dmSignalVersion                                     |
+|                                                                             |
+|   Description         : This function returns the number of reported        |
+|                         changes of a signal                                 |
+|                                                                             |
+|   Inputs              : Signal id ( E_DM_SIGNAL_ID ).                       |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : Version, 0 for an unknown signal.                   |
+|                                                                             |
+|   Warnings            : None.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+U32 dmSignalVersion( U32 signal )
+{
+    return ( signal < DM_SIGNAL_MAX ) ? dm_signal_version[ signal ] : 0u;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dmSetDeadband                                       |
+|                                                                             |
+|   Description         : This function sets how far a signal must move from  |
+|                         its last reported value to count as a change        |
+|                                                                             |
+|   Inputs              : Signal id.                                          |
+|                         Deadband in raw units, 0 reports every change.      |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Meant for analogue signals, digitals keep 0.        |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void dmSetDeadband( U32 signal, U32 deadband )
+{
+    if ( signal < DM_SIGNAL_MAX )
+    {
+        dm_signal_deadband[ signal ] = deadband;
+    }
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dmSubscribe                                         |
+|                                                                             |
+|   Description         : This function registers a task to be notified of    |
+|                         changes, add its signals with dmSubscribeSignal()   |
+|                                                                             |
+|   Inputs              : Task to notify.                                     |
+|                         Bits to set in the task's notification value.       |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : Subscriber id, DM_SUBSCRIBER_NONE if full.          |
+|                                                                             |
+|   Warnings            : Initialisation only, not thread safe.               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+S32 dmSubscribe( TaskHandle_t task, U32 notify_bits )
+{
+    U32 id = dm_subscriber_count;
+
+    if ( ( task == NULL ) || ( id >= DM_SUBSCRIBERS_MAX ) )
+    {
+        return DM_SUBSCRIBER_NONE;
+    }
+
+    memset( &dm_subscribers[ id ], 0, sizeof( S_DM_SUBSCRIBER ) );
+    dm_subscribers[ id ].task = task;
+    dm_subscribers[ id ].notify_bits = notify_bits;
+
+    /* Publishers only look at entries below the count */
+    ATOMIC_DMB();
+    dm_subscriber_count = id + 1u;
+
+    return ( S32 ) id;
+}
+
+void dmSubscribeSignal( S32 subscriber, U32 signal )
+{
+    if ( ( subscriber >= 0 ) && ( ( U32 ) subscriber < dm_subscriber_count ) && ( signal < DM_SIGNAL_MAX ) )
+    {
+        atomicOrU32( &dm_subscribers[ subscriber ].mask[ signal / 32u ], 1u << ( signal % 32u ) );
+    }
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dmTakeChanges                                       |
+|                                                                             |
+|   Description         : This function returns and clears the subscribed     |
+|                         signals that changed since the previous call        |
+|                                                                             |
+|   Inputs              : Subscriber id.                                      |
+|                                                                             |
+|   Outputs             : Changed signals, bit ( signal % 32 ) of word        |
+|                         ( signal / 32 ).                                    |
+|                                                                             |
+|   Return              : TRUE if any signal changed.                         |
+|                                                                             |
+|   Warnings            : Subscribed task only.                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN dmTakeChanges( S32 subscriber, U32 changed[ DM_SIGNAL_WORDS ] )
+{
+    U32 w;
+    U32 any = 0u;
+
+    for ( w = 0u; w < DM_SIGNAL_WORDS; w++ )
+    {
+        changed[ w ] = 0u;
+        if ( ( subscriber >= 0 ) && ( ( U32 ) subscriber < dm_subscriber_count ) )
+        {
+            changed[ w ] = atomicExchangeU32( &dm_subscribers[ subscriber ].pending[ w ], 0u );
+        }
+        any |= changed[ w ];
+    }
+
+    return ( any != 0u ) ? TRUE : FALSE;
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+static void dmLatchInit( S_DM_LATCH *latch, void *copy0, void *copy1, U32 size )
+{
+    memset( copy0, 0, size );
+    memset( copy1, 0, size );
+
+    latch->copy[ 0 ] = copy0;
+    latch->copy[ 1 ] = copy1;
+    latch->size = size;
+    latch->seq = 0u;
+}
+
+/* Odd sequence: readers use copy 1 while copy 0 is written, even sequence:
+ * readers use copy 0 while copy 1 is written. Never waits for a reader.
+ */
+static void dmLatchPublish( S_DM_LATCH *latch, const void *src )
+{
+    U32 seq = latch->seq;
+
+    latch->seq = seq + 1u;
+    ATOMIC_DMB();
+    memcpy( latch->copy[ 0 ], src, latch->size );
+
+    ATOMIC_DMB();
+    latch->seq = seq + 2u;
+    ATOMIC_DMB();
+    memcpy( latch->copy[ 1 ], src, latch->size );
+}
+
+/* Copies the copy selected by the sequence and retries only if a publish
+ * started in the meantime. Returns the number of completed publishes.
+ */
+static U32 dmLatchRead( const S_DM_LATCH *latch, void *dst )
+{
+    U32 seq;
+
+    do
+    {
+        seq = latch->seq;
+        ATOMIC_DMB();
+        memcpy( dst, latch->copy[ seq & 1u ], latch->size );
+        ATOMIC_DMB();
+    } while ( latch->seq != seq );
+
+    return seq >> 1;
+}
+
+/* Stores the raw value, appends it to the signal's history and reports the
+ * signal as changed when it moved further than its deadband from the last
+ * reported value. Comparing with the last reported value rather than the
+ * previous sample keeps a slow drift from hiding inside the deadband.
+ */
+static void dmSignalStore( U32 signal, S32 value, U32 changed[ DM_SIGNAL_WORDS ] )
+{
+    S32 diff;
+    U32 distance;
+
+    dm_values[ signal ] = value;
+    dmHistoryStore( signal, value );
+
+    diff = value - dm_signal_reported[ signal ];
+    distance = ( diff < 0 ) ? ( U32 ) -diff : ( U32 ) diff;
+
+    if ( ( distance != 0u ) && ( distance > dm_signal_deadband[ signal ] ) )
+    {
+        dm_signal_reported[ signal ] = value;
+        dm_signal_version[ signal ]++;
+        changed[ signal / 32u ] |= 1u << ( signal % 32u );
+    }
+}
+
+/* Flags the changes for every interested subscriber and wakes it. Works from
+ * task and ISR context, the caller's mode decides which API is used.
+ */
+static void dmNotify( const U32 changed[ DM_SIGNAL_WORDS ] )
+{
+    U32 i;
+    U32 w;
+    U32 hit;
+    U32 mode = _getCPSRValue_() & DM_CPSR_MODE_MASK;
+    BOOLEAN in_isr = ( ( mode == DM_CPSR_MODE_IRQ ) || ( mode == DM_CPSR_MODE_FIQ ) ) ? TRUE : FALSE;
+    BaseType_t woken = pdFALSE;
+    S_DM_SUBSCRIBER *p_sub;
+
+    for ( i = 0u; i < dm_subscriber_count; i++ )
+    {
+        p_sub = &dm_subscribers[ i ];
+        hit = 0u;
+
+        for ( w = 0u; w < DM_SIGNAL_WORDS; w++ )
+        {
+            if ( ( changed[ w ] & p_sub->mask[ w ] ) != 0u )
+            {
+                atomicOrU32( &p_sub->pending[ w ], changed[ w ] & p_sub->mask[ w ] );
+                hit = 1u;
+            }
+        }
+
+        if ( hit != 0u )
+        {
+            if ( in_isr == TRUE )
+            {
+                ( void ) xTaskNotifyFromISR( p_sub->task, p_sub->notify_bits, eSetBits, &woken );
+            }
+            else
+            {
+                ( void ) xTaskNotify( p_sub->task, p_sub->notify_bits, eSetBits );
+            }
+        }
+    }
+
+    if ( in_isr == TRUE )
+    {
+        portYIELD_FROM_ISR( woken );
+    }
 }
 
 /*----------------------------------------------------------------------------\
@@ -15,7 +15,22 @@
 |                                                                             |
 |-----------------------------------------------------------------------------|
 |                                                                             |
-|   <Module Header Description>                                               |
+|   Data Manager.                                                             |
+|                                                                             |
+|   Every dataset is published as a whole and read as a consistent snapshot.  |
+|   Readers never disable interrupts and writers never block, see             |
+|   data_manager.c for the scheme. Each dataset must have a single writer     |
+|   context ( one task or one ISR ), any number of contexts may read it.      |
+|                                                                             |
+|   Publishing also compares every signal with its last reported value and    |
+|   bumps the signal's version when it changed ( by more than the deadband    |
+|   for analogue signals ). Subscribed tasks get the changed signals flagged  |
+|   and are woken through their task notification value.                     |
+|                                                                             |
+|   Signals are listed in dm_signals.h and accessed by id with dmGet() /      |
+|   dmSet(), their type, unit, scaling and limits with dmGetInfo().           |
+|   Signals listed in DM_HISTORIES also keep a decimated history, see         |
+|   dm_history.h.                                                             |
 |                                                                             |
 \----------------------------------------------------------------------------*/
 
@@ -26,25 +41,82 @@
 |   Header Files                                                              |
 \----------------------------------------------------------------------------*/
 
+#include "FreeRTOS.h"
+#include "os_task.h"
+
+#include "fw_types.h"
 #include "fw_adc.h"
 #include "fw_dio.h"
+#include "dm_signals.h"
 
 /*----------------------------------------------------------------------------\
 |   Public Type Definitions                                                   |
 \----------------------------------------------------------------------------*/
 
+/*
+ * Signal ids, from dm_signals.h
+ */
+#define DM_SIGNAL( id, type, unit, num, den, offset, min, max, deadband, name )    id,
+typedef enum
+{
+    DM_SIGNALS
+    eDM_SIG_MAX
+} E_DM_SIGNAL_ID;
+#undef DM_SIGNAL
+
+typedef enum
+{
+    eDM_TYPE_BOOL = 0u,
+    eDM_TYPE_U8,
+    eDM_TYPE_S8,
+    eDM_TYPE_U16,
+    eDM_TYPE_S16,
+    eDM_TYPE_U32,
+    eDM_TYPE_S32,
+    eDM_TYPE_MAX,
+} E_DM_TYPE;
+
+typedef enum
+{
+    eDM_UNIT_NONE = 0u,
+    eDM_UNIT_MV,
+    eDM_UNIT_MA,
+    eDM_UNIT_DEG_C,
+    eDM_UNIT_PERCENT,
+    eDM_UNIT_HZ,
+    eDM_UNIT_MS,
+    eDM_UNIT_MAX,
+} E_DM_UNIT;
+
+/*
+ * Flash resident signal metadata
+ */
+typedef struct
+{
+    const CHAR *            name;
+    U8                      type;           /* E_DM_TYPE */
+    U8                      unit;           /* E_DM_UNIT of the engineering value */
+    S32                     scale_num;      /* Engineering = raw * scale_num / scale_den + offset */
+    S32                     scale_den;
+    S32                     offset;
+    S32                     min;            /* Raw limits */
+    S32                     max;
+    U32                     deadband;       /* Default change notification deadband, raw */
+} S_DM_SIGNAL_INFO;
+
 /*
  * Dataset structures for the database manager
  */
 typedef struct
 {
-    S_DIO_INPUT_PIN_DEF     digital_inputs[ eDIO_NUM_INPUT_PINS ];
-    S_DIO_OUTPUT_PIN_DEF    digital_outputs[ eDIO_NUM_OUTPUT_PINS ];
+    S_DIO_PORT_STATE        ports;          /* Pin levels and edges, configuration is in fw_dio's const tables */
 } S_DIGITAL_IO;
 
 typedef struct
 {
     int                     adc_raw[ eADC_CHANNEL_MAX ];
+    S32                     adc_eng[ eADC_CHANNEL_MAX ];    /* Calibrated, fixed-point unit of the channel's S_ADC_CAL_RECORD */
+    U32                     adc_time[ eADC_CHANNEL_MAX ];   /* RTI counter 0 at the end of the conversion */
 } S_ANALOGUE_INPUTS;
 
 /*
@@ -57,27 +129,46 @@ typedef struct
     S_ANALOGUE_INPUTS       analogue_inputs;
 } S_DM_DATABASE;
 
+/*----------------------------------------------------------------------------\
+|   Public Constant Declarations                                              |
+\----------------------------------------------------------------------------*/
+
 /*
- * Transport packaging structures
+ * Signal ids: digital inputs, then digital outputs, then analogue inputs
  */
-typedef struct
-{
-    S_DIGITAL_IO            *ptr_digital_io;
-} S_DM_DIGITAL_IO;
+#define DM_SIG_DI( pin )            ( ( U32 ) ( pin ) )
+#define DM_SIG_DO( pin )            ( ( U32 ) eDIO_NUM_INPUT_PINS + ( U32 ) ( pin ) )
+#define DM_SIG_ADC( ch )            ( ( U32 ) eDIO_NUM_INPUT_PINS + ( U32 ) eDIO_NUM_OUTPUT_PINS + ( U32 ) ( ch ) )
+#define DM_SIGNAL_MAX               ( ( U32 ) eDM_SIG_MAX )
 
-typedef struct
-{
-    S_ANALOGUE_INPUTS       *ptr_analogue_inputs;
-} S_DM_ANALOGUE_INPUTS;
+#define DM_SIGNAL_WORDS             ( ( DM_SIGNAL_MAX + 31u ) / 32u )   /* Words of a signal bit set */
+#define DM_SUBSCRIBERS_MAX          4u
+
+/* Returned by dmSubscribe() when the subscriber table is full */
+#define DM_SUBSCRIBER_NONE          ( -1 )
 
 /*----------------------------------------------------------------------------\
 |   Public Function Declarations                                              |
 \----------------------------------------------------------------------------*/
 
 void dmDataManagerInit( void );
-S_DM_DATABASE *dmFullDataAccess( void );
-S_DM_DIGITAL_IO *dmDigitalsAccess( void );
-S_DM_ANALOGUE_INPUTS *dmAnalogueInputsAccess( void );
+void dmFullDataRead( S_DM_DATABASE *dst );
+U32 dmDigitalsRead( S_DIGITAL_IO *dst );
+void dmDigitalsPublish( const S_DIGITAL_IO *src );
+U32 dmAnalogueInputsRead( S_ANALOGUE_INPUTS *dst );
+void dmAnalogueInputsPublish( const S_ANALOGUE_INPUTS *src );
+
+const S_DM_SIGNAL_INFO * dmGetInfo( U32 signal );
+S32 dmGet( U32 signal );
+S32 dmGetScaled( U32 signal );
+U32 dmGetRange( U32 first, U32 count, S32 *values );
+BOOLEAN dmSet( U32 signal, S32 value );
+
+U32 dmSignalVersion( U32 signal );
+void dmSetDeadband( U32 signal, U32 deadband );
+S32 dmSubscribe( TaskHandle_t task, U32 notify_bits );
+void dmSubscribeSignal( S32 subscriber, U32 signal );
+BOOLEAN dmTakeChanges( S32 subscriber, U32 changed[ DM_SIGNAL_WORDS ] );
 
 /*----------------------------------------------------------------------------\
 |   End of data_manager.h header file                                         |
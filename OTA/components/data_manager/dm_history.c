@@ -0,0 +1,554 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : dm_history.c Module File.                                  |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Data Manager signal histories.                                            |
+|                                                                             |
+|   Each ring is written by the single writer of its signal and read          |
+|   without locks: the entry is stored before the head is published, and a    |
+|   reader drops whatever the writer may have overwritten while it copied.    |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Compiler Controls                                                         |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "fw_atomic.h"
+#include "fw_utils.h"
+#include "fw_uart.h"
+#include "data_manager.h"
+#include "dm_history.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+/* Flash resident history layout */
+typedef struct
+{
+    U16                 signal;
+    U16                 fast_factor;        /* Raw samples per fast entry */
+    U16                 slow_factor;        /* Fast entries per slow entry */
+    void *              entries[ eDM_HIST_LEVEL_MAX ];
+    U32                 depth[ eDM_HIST_LEVEL_MAX ];    /* Powers of two */
+} S_DM_HIST_DEF;
+
+/* Running aggregate of the level above */
+typedef struct
+{
+    S32                 min;
+    S32                 max;
+    S64                 sum;
+    U32                 count;
+} S_DM_HIST_ACC;
+
+typedef struct
+{
+    volatile U32        head[ eDM_HIST_LEVEL_MAX ];     /* Next entry to write, free running */
+    volatile U32        time[ eDM_HIST_LEVEL_MAX ][ 2 ];    /* [ n & 1 ]: write time of entry n - 1 */
+    volatile BOOLEAN    full[ eDM_HIST_LEVEL_MAX ];     /* Every slot written at least once */
+    S_DM_HIST_ACC       acc[ eDM_HIST_LEVEL_MAX - 1u ]; /* Feeding the fast and the slow level */
+} S_DM_HIST_STATE;
+
+/* History dump in progress */
+typedef struct
+{
+    BOOLEAN             active;
+    U8                  history;
+    U8                  level;
+    U32                 next;               /* Sequence of the next entry to send */
+    U32                 end;                /* Head when the dump was requested */
+} S_DM_HIST_DUMP;
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define DM_HIST_NONE                0xFFu
+
+#define DM_HIST_IS_POW2( n )        ( ( ( n ) != 0u ) && ( ( ( n ) & ( ( n ) - 1u ) ) == 0u ) )
+
+#define DM_HIST_TIMESTAMP()         ( rtiREG1->CNT[ 0 ].FRCx )
+
+#define DM_HIST_REQUEST_VALID       0x80000000u
+
+#define DM_HIST_FRAME_ENTRIES( size )   ( ( UART_FRAME_PAYLOAD_SIZE - sizeof( S_DM_HIST_FRAME_HDR ) ) / ( size ) )
+
+/* Ring storage, from dm_signals.h */
+#define DM_HISTORY( id, signal, raw_depth, fast_factor, fast_depth, slow_factor, slow_depth ) \
+    typedef char dm_hist_assert_##id[ ( DM_HIST_IS_POW2( raw_depth ) && DM_HIST_IS_POW2( fast_depth ) && \
+                                        DM_HIST_IS_POW2( slow_depth ) && ( ( fast_factor ) > 0 ) && \
+                                        ( ( slow_factor ) > 0 ) ) ? 1 : -1 ]; \
+    static S32 dm_hist_raw_##id[ raw_depth ]; \
+    static S_DM_HIST_AGG dm_hist_fast_##id[ fast_depth ]; \
+    static S_DM_HIST_AGG dm_hist_slow_##id[ slow_depth ];
+DM_HISTORIES
+#undef DM_HISTORY
+
+#define DM_HISTORY( id, signal, raw_depth, fast_factor, fast_depth, slow_factor, slow_depth ) \
+    { ( U16 ) ( signal ), ( fast_factor ), ( slow_factor ), \
+      { dm_hist_raw_##id, dm_hist_fast_##id, dm_hist_slow_##id }, \
+      { ( raw_depth ), ( fast_depth ), ( slow_depth ) } },
+static const S_DM_HIST_DEF dm_hist_defs[ eDM_HIST_MAX ] =
+{
+    DM_HISTORIES
+};
+#undef DM_HISTORY
+
+static const U32 dm_hist_entry_size[ eDM_HIST_LEVEL_MAX ] =
+{
+    sizeof( S32 ),
+    sizeof( S_DM_HIST_AGG ),
+    sizeof( S_DM_HIST_AGG ),
+};
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static S_DM_HIST_STATE              dm_hist_state[ eDM_HIST_MAX ];
+static U8                           dm_hist_of_signal[ DM_SIGNAL_MAX ];
+
+/* Dump requests are posted by one task and served by the draining task */
+static volatile U32                 dm_hist_request;
+static S_DM_HIST_DUMP               dm_hist_dump;
+static U32                          dm_hist_frame[ UART_FRAME_PAYLOAD_SIZE / sizeof( U32 ) ];
+
+/*----------------------------------------------------------------------------\
+|   Private Function Declarations                                             |
+\----------------------------------------------------------------------------*/
+
+static void dmHistPut( U32 history, U32 level, const void *entry, U32 now );
+static void dmHistAccumulate( S_DM_HIST_ACC *acc, S32 min, S32 max, S32 value );
+static void dmHistAccTake( S_DM_HIST_ACC *acc, S_DM_HIST_AGG *agg );
+static void dmHistCopy( U32 history, U32 level, U32 seq, U8 *dst, U32 count );
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dmHistoryInit                                       |
+|                                                                             |
+|   Description         : Empties every history and maps the signals to       |
+|                         their histories.                                    |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Called by dmDataManagerInit(), before the operating |
+|                         system starts to run.                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void dmHistoryInit( void )
+{
+    U32 i;
+
+    memset( ( void * ) dm_hist_state, 0, sizeof( dm_hist_state ) );
+    memset( dm_hist_of_signal, DM_HIST_NONE, sizeof( dm_hist_of_signal ) );
+    memset( &dm_hist_dump, 0, sizeof( dm_hist_dump ) );
+    dm_hist_request = 0u;
+
+    for ( i = 0u; i < eDM_HIST_MAX; i++ )
+    {
+        dm_hist_of_signal[ dm_hist_defs[ i ].signal ] = ( U8 ) i;
+    }
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dmHistoryStore                                      |
+|                                                                             |
+|   Description         : Appends a raw value to the signal's history, if it  |
+|                         has one, and closes the fast and slow aggregates    |
+|                         when they are complete.                             |
+|                                                                             |
+|   Inputs              : Signal id.                                          |
+|                         Raw value.                                          |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Single writer context per signal, called for every  |
+|                         stored value by the data manager.                   |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void dmHistoryStore( U32 signal, S32 value )
+{
+    U32 history;
+    U32 now;
+    S_DM_HIST_AGG agg;
+    S_DM_HIST_STATE *p_state;
+    const S_DM_HIST_DEF *p_def;
+
+    if ( ( signal >= DM_SIGNAL_MAX ) || ( dm_hist_of_signal[ signal ] == DM_HIST_NONE ) )
+    {
+        return;
+    }
+
+    history = dm_hist_of_signal[ signal ];
+    p_def = &dm_hist_defs[ history ];
+    p_state = &dm_hist_state[ history ];
+    now = DM_HIST_TIMESTAMP();
+
+    dmHistPut( history, eDM_HIST_RAW, &value, now );
+
+    dmHistAccumulate( &p_state->acc[ 0 ], value, value, value );
+    if ( p_state->acc[ 0 ].count < p_def->fast_factor )
+    {
+        return;
+    }
+
+    dmHistAccTake( &p_state->acc[ 0 ], &agg );
+    dmHistPut( history, eDM_HIST_FAST, &agg, now );
+
+    /* Equal sized buckets, so the mean of the means is the overall mean */
+    dmHistAccumulate( &p_state->acc[ 1 ], agg.min, agg.max, agg.mean );
+    if ( p_state->acc[ 1 ].count < p_def->slow_factor )
+    {
+        return;
+    }
+
+    dmHistAccTake( &p_state->acc[ 1 ], &agg );
+    dmHistPut( history, eDM_HIST_SLOW, &agg, now );
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dmHistoryRead                                       |
+|                                                                             |
+|   Description         : Copies consecutive entries of one history level,    |
+|                         starting at a sequence number or at the oldest      |
+|                         entry still held if that one is gone.               |
+|                                                                             |
+|   Inputs              : History id.                                         |
+|                         Level ( E_DM_HIST_LEVEL ).                          |
+|                         Sequence of the first wanted entry, 0 for oldest.   |
+|                         Maximum number of entries.                          |
+|                                                                             |
+|   Outputs             : Sequence of the first entry copied.                 |
+|                         Entries, S32 for raw, S_DM_HIST_AGG otherwise.      |
+|                                                                             |
+|   Return              : Number of entries copied.                           |
+|                                                                             |
+|   Warnings            : Any task, not from the signal's writer context.     |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+U32 dmHistoryRead( U32 history, U32 level, U32 *first, void *dst, U32 max )
+{
+    U32 head;
+    U32 held;
+    U32 from;
+    U32 count;
+    U32 valid;
+    U32 skip;
+    U32 size;
+    const S_DM_HIST_DEF *p_def;
+    const S_DM_HIST_STATE *p_state;
+
+    if ( ( history >= eDM_HIST_MAX ) || ( level >= eDM_HIST_LEVEL_MAX ) )
+    {
+        return 0u;
+    }
+
+    p_def = &dm_hist_defs[ history ];
+    p_state = &dm_hist_state[ history ];
+    size = dm_hist_entry_size[ level ];
+
+    head = p_state->head[ level ];
+    ATOMIC_DMB();
+    held = ( p_state->full[ level ] == TRUE ) ? p_def->depth[ level ] : head;
+
+    /* Free running sequences, compare by distance */
+    from = *first;
+    if ( ( S32 ) ( ( head - held ) - from ) > 0 )
+    {
+        from = head - held;
+    }
+    else if ( ( S32 ) ( from - head ) > 0 )
+    {
+        from = head;
+    }
+
+    count = head - from;
+    if ( count > max )
+    {
+        count = max;
+    }
+
+    dmHistCopy( history, level, from, ( U8 * ) dst, count );
+
+    /* The slot of the entry being written now is lost as well */
+    ATOMIC_DMB();
+    valid = p_state->head[ level ] + 1u - p_def->depth[ level ];
+    if ( ( S32 ) ( valid - from ) > 0 )
+    {
+        skip = valid - from;
+        if ( skip >= count )
+        {
+            skip = count;
+        }
+        else
+        {
+            memmove( dst, &( ( U8 * ) dst )[ skip * size ], ( count - skip ) * size );
+        }
+        from += skip;
+        count -= skip;
+    }
+
+    *first = from;
+
+    return count;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dmHistoryHead                                       |
+|                                                                             |
+|   Description         : Returns the sequence of the next entry of a level   |
+|                         and when the newest one was written.                |
+|                                                                             |
+|   Inputs              : History id.                                         |
+|                         Level ( E_DM_HIST_LEVEL ).                          |
+|                                                                             |
+|   Outputs             : RTI counter 0 at the newest entry, NULL if unused.  |
+|                                                                             |
+|   Return              : Head sequence, 0 while the level is empty.          |
+|                                                                             |
+|   Warnings            : None.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+U32 dmHistoryHead( U32 history, U32 level, U32 *time )
+{
+    U32 head;
+    U32 stamp;
+    const S_DM_HIST_STATE *p_state;
+
+    if ( ( history >= eDM_HIST_MAX ) || ( level >= eDM_HIST_LEVEL_MAX ) )
+    {
+        return 0u;
+    }
+
+    p_state = &dm_hist_state[ history ];
+
+    /* The writer stamps the other slot, so a stable head means a stable time */
+    do
+    {
+        head = p_state->head[ level ];
+        ATOMIC_DMB();
+        stamp = p_state->time[ level ][ head & 1u ];
+        ATOMIC_DMB();
+    } while ( p_state->head[ level ] != head );
+
+    if ( time != NULL )
+    {
+        *time = stamp;
+    }
+
+    return head;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dmHistoryRequest                                    |
+|                                                                             |
+|   Description         : Asks dmHistoryDrain() to send every entry of a      |
+|                         level held right now, oldest first. Replaces a      |
+|                         dump in progress.                                   |
+|                                                                             |
+|   Inputs              : History id.                                         |
+|                         Level ( E_DM_HIST_LEVEL ).                          |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Task context.                                       |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void dmHistoryRequest( U32 history, U32 level )
+{
+    if ( ( history < eDM_HIST_MAX ) && ( level < eDM_HIST_LEVEL_MAX ) )
+    {
+        ( void ) atomicExchangeU32( &dm_hist_request, DM_HIST_REQUEST_VALID | ( history << 8 ) | level );
+    }
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dmHistoryDrain                                      |
+|                                                                             |
+|   Description         : Sends the next UART frame ( stream                  |
+|                         eUART_STREAM_HISTORY ) of the requested dump:       |
+|                         S_DM_HIST_FRAME_HDR followed by the entries.        |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : TRUE if a frame was sent.                           |
+|                                                                             |
+|   Warnings            : Call from one task only.                            |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN dmHistoryDrain( void )
+{
+    U32 request;
+    U32 first;
+    U32 count;
+    U32 max;
+    S_DM_HIST_FRAME_HDR *p_hdr = ( S_DM_HIST_FRAME_HDR * ) dm_hist_frame;
+
+    request = atomicExchangeU32( &dm_hist_request, 0u );
+    if ( request != 0u )
+    {
+        dm_hist_dump.history = ( U8 ) ( request >> 8 );
+        dm_hist_dump.level = ( U8 ) request;
+        dm_hist_dump.next = 0u;
+        dm_hist_dump.end = dmHistoryHead( dm_hist_dump.history, dm_hist_dump.level, NULL );
+        dm_hist_dump.active = TRUE;
+    }
+
+    if ( ( dm_hist_dump.active == FALSE ) || ( uartIsTxIdle( DM_HIST_DRAIN_UART ) == FALSE ) )
+    {
+        return FALSE;
+    }
+
+    max = DM_HIST_FRAME_ENTRIES( dm_hist_entry_size[ dm_hist_dump.level ] );
+    first = dm_hist_dump.next;
+    count = dmHistoryRead( dm_hist_dump.history, dm_hist_dump.level, &first, &p_hdr[ 1 ], max );
+
+    /* Stop at the head seen at the request, later entries are for the next dump */
+    if ( ( S32 ) ( ( first + count ) - dm_hist_dump.end ) > 0 )
+    {
+        count = ( ( S32 ) ( dm_hist_dump.end - first ) > 0 ) ? ( dm_hist_dump.end - first ) : 0u;
+    }
+
+    if ( count == 0u )
+    {
+        dm_hist_dump.active = FALSE;
+        return FALSE;
+    }
+
+    p_hdr->history = dm_hist_dump.history;
+    p_hdr->level = dm_hist_dump.level;
+    p_hdr->count = ( U16 ) count;
+    p_hdr->first = first;
+    p_hdr->head = dmHistoryHead( dm_hist_dump.history, dm_hist_dump.level, &p_hdr->head_time );
+
+    if ( uartSendFrame( DM_HIST_DRAIN_UART, eUART_STREAM_HISTORY, ( const U8 * ) dm_hist_frame,
+                        ( U16 ) ( sizeof( S_DM_HIST_FRAME_HDR ) + ( count * dm_hist_entry_size[ dm_hist_dump.level ] ) ) ) == FALSE )
+    {
+        return FALSE;
+    }
+
+    dm_hist_dump.next = first + count;
+
+    return TRUE;
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+/* Stores the entry, stamps it and then publishes it by moving the head */
+static void dmHistPut( U32 history, U32 level, const void *entry, U32 now )
+{
+    const S_DM_HIST_DEF *p_def = &dm_hist_defs[ history ];
+    S_DM_HIST_STATE *p_state = &dm_hist_state[ history ];
+    U32 head = p_state->head[ level ];
+    U32 size = dm_hist_entry_size[ level ];
+
+    memcpy( &( ( U8 * ) p_def->entries[ level ] )[ ( head & ( p_def->depth[ level ] - 1u ) ) * size ], entry, size );
+    p_state->time[ level ][ ( head + 1u ) & 1u ] = now;
+    if ( ( head + 1u ) >= p_def->depth[ level ] )
+    {
+        p_state->full[ level ] = TRUE;
+    }
+
+    ATOMIC_DMB();
+    p_state->head[ level ] = head + 1u;
+}
+
+static void dmHistAccumulate( S_DM_HIST_ACC *acc, S32 min, S32 max, S32 value )
+{
+    if ( acc->count == 0u )
+    {
+        acc->min = min;
+        acc->max = max;
+        acc->sum = 0;
+    }
+    else
+    {
+        acc->min = ( min < acc->min ) ? min : acc->min;
+        acc->max = ( max > acc->max ) ? max : acc->max;
+    }
+
+    acc->sum += value;
+    acc->count++;
+}
+
+static void dmHistAccTake( S_DM_HIST_ACC *acc, S_DM_HIST_AGG *agg )
+{
+    agg->min = acc->min;
+    agg->max = acc->max;
+    agg->mean = ( S32 ) ( acc->sum / ( S64 ) acc->count );
+    acc->count = 0u;
+}
+
+/* Copies count entries from sequence seq on, in at most two pieces */
+static void dmHistCopy( U32 history, U32 level, U32 seq, U8 *dst, U32 count )
+{
+    const S_DM_HIST_DEF *p_def = &dm_hist_defs[ history ];
+    const U8 *p_entries = ( const U8 * ) p_def->entries[ level ];
+    U32 size = dm_hist_entry_size[ level ];
+    U32 slot = seq & ( p_def->depth[ level ] - 1u );
+    U32 run = p_def->depth[ level ] - slot;
+
+    if ( run > count )
+    {
+        run = count;
+    }
+
+    memcpy( dst, &p_entries[ slot * size ], run * size );
+    if ( count > run )
+    {
+        memcpy( &dst[ run * size ], p_entries, ( count - run ) * size );
+    }
+}
+
+/*----------------------------------------------------------------------------\
+|   End of dm_history.c module                                                |
+\----------------------------------------------------------------------------*/
@@ -0,0 +1,108 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : dm_history.h Header File.                                  |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Data Manager signal histories.                                            |
+|                                                                             |
+|   A signal listed in DM_HISTORIES ( dm_signals.h ) keeps three rings:       |
+|   every stored raw value, min / max / mean over fast_factor raw values      |
+|   and min / max / mean over slow_factor fast entries. The aggregates are    |
+|   accumulated on insert, so no query ever walks the raw data.               |
+|                                                                             |
+|   Entries are numbered by a free running sequence per ring. Readers ask     |
+|   for entries from a sequence on and get the oldest ones still held if      |
+|   the writer has overwritten the rest, so a reader can follow a ring by     |
+|   passing back first + count.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef dm_history_H
+#define dm_history_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "fw_types.h"
+#include "fw_uart.h"
+#include "dm_signals.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+#define DM_HIST_DRAIN_UART          eUART_2             /* Shared with fw_log and fw_trace */
+
+/*----------------------------------------------------------------------------\
+|   Public Type Definitions                                                   |
+\----------------------------------------------------------------------------*/
+
+/*
+ * History ids, from dm_signals.h
+ */
+#define DM_HISTORY( id, signal, raw_depth, fast_factor, fast_depth, slow_factor, slow_depth )   id,
+typedef enum
+{
+    DM_HISTORIES
+    eDM_HIST_MAX
+} E_DM_HISTORY_ID;
+#undef DM_HISTORY
+
+typedef enum
+{
+    eDM_HIST_RAW = 0u,                      /* S32 per entry */
+    eDM_HIST_FAST,                          /* S_DM_HIST_AGG per entry */
+    eDM_HIST_SLOW,                          /* S_DM_HIST_AGG per entry */
+    eDM_HIST_LEVEL_MAX,
+} E_DM_HIST_LEVEL;
+
+typedef struct
+{
+    S32                     min;
+    S32                     max;
+    S32                     mean;           /* Rounded towards zero */
+} S_DM_HIST_AGG;
+
+/*
+ * Header of a history frame ( stream eUART_STREAM_HISTORY ), followed by
+ * count entries of the level. Big endian, like everything on the wire.
+ */
+typedef struct
+{
+    U8                      history;        /* E_DM_HISTORY_ID */
+    U8                      level;          /* E_DM_HIST_LEVEL */
+    U16                     count;          /* Entries in this frame */
+    U32                     first;          /* Sequence of the first entry */
+    U32                     head;           /* Sequence of the next entry to be written */
+    U32                     head_time;      /* RTI counter 0 when entry head - 1 was written */
+} S_DM_HIST_FRAME_HDR;
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+void dmHistoryInit( void );
+void dmHistoryStore( U32 signal, S32 value );
+U32 dmHistoryRead( U32 history, U32 level, U32 *first, void *dst, U32 max );
+U32 dmHistoryHead( U32 history, U32 level, U32 *time );
+void dmHistoryRequest( U32 history, U32 level );
+BOOLEAN dmHistoryDrain( void );
+
+/*----------------------------------------------------------------------------\
+|   End of dm_history.h header file                                           |
+\----------------------------------------------------------------------------*/
+
+#endif  /* dm_history_H */
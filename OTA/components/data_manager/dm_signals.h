@@ -0,0 +1,74 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : dm_signals.h Header File.                                  |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Data Manager signal table.                                                |
+|                                                                             |
+|   One DM_SIGNAL( id, type, unit, num, den, offset, min, max, deadband,      |
+|   name ) line per signal. The metadata stays in flash, the raw values live  |
+|   in one RAM array indexed by id. Raw values are 32 bit, the engineering    |
+|   value is raw * num / den + offset. min and max limit the raw value, the   |
+|   deadband is the default for change notification ( raw units ).            |
+|                                                                             |
+|   Keep the groups in order: digital inputs, digital outputs, analogue       |
+|   inputs, each in the order of its fw_dio / fw_adc enum. data_manager.c     |
+|   checks this at compile time. Anything else goes after the groups.         |
+|                                                                             |
+|   One DM_HISTORY( id, signal, raw_depth, fast_factor, fast_depth,           |
+|   slow_factor, slow_depth ) line per signal that keeps a history, see       |
+|   dm_history.h. Depths are powers of two, the fast level aggregates         |
+|   fast_factor raw samples, the slow level slow_factor fast entries.         |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef dm_signals_H
+#define dm_signals_H
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+#define DM_SIGNALS \
+    DM_SIGNAL( eDM_SIG_DI_AISG_DIR, eDM_TYPE_BOOL,  eDM_UNIT_NONE,  1,      1,      0,  0,  1,      0,  "AISG data direction" ) \
+    DM_SIGNAL( eDM_SIG_DO_LED_6,    eDM_TYPE_BOOL,  eDM_UNIT_NONE,  1,      1,      0,  0,  1,      0,  "LED 6" ) \
+    DM_SIGNAL( eDM_SIG_DO_LED_7,    eDM_TYPE_BOOL,  eDM_UNIT_NONE,  1,      1,      0,  0,  1,      0,  "LED 7" ) \
+    DM_SIGNAL( eDM_SIG_DO_RS485_REB, eDM_TYPE_BOOL, eDM_UNIT_NONE,  1,      1,      0,  0,  1,      0,  "RS485 receiver enable" ) \
+    DM_SIGNAL( eDM_SIG_DO_VPOS_5019, eDM_TYPE_BOOL, eDM_UNIT_NONE,  1,      1,      0,  0,  1,      0,  "ADRF5019 supply" ) \
+    DM_SIGNAL( eDM_SIG_DO_POW_SWDT, eDM_TYPE_BOOL,  eDM_UNIT_NONE,  1,      1,      0,  0,  1,      0,  "Power switch watchdog" ) \
+    DM_SIGNAL( eDM_SIG_DO_FLT_BYPASS, eDM_TYPE_BOOL, eDM_UNIT_NONE, 1,      1,      0,  0,  1,      0,  "Fault bypass switch" ) \
+    DM_SIGNAL( eDM_SIG_DO_LED_LEFT_BOTTOM, eDM_TYPE_BOOL, eDM_UNIT_NONE, 1, 1,      0,  0,  1,      0,  "LED left bottom" ) \
+    DM_SIGNAL( eDM_SIG_DO_RS485_DE, eDM_TYPE_BOOL,  eDM_UNIT_NONE,  1,      1,      0,  0,  1,      0,  "RS485 driver enable" ) \
+    DM_SIGNAL( eDM_SIG_DO_DEMOD_ENA, eDM_TYPE_BOOL, eDM_UNIT_NONE,  1,      1,      0,  0,  1,      0,  "Demodulator enable" ) \
+    DM_SIGNAL( eDM_SIG_DO_GAIN_ACTIVE_2, eDM_TYPE_BOOL, eDM_UNIT_NONE, 1,   1,      0,  0,  1,      0,  "Gain active 2" ) \
+    DM_SIGNAL( eDM_SIG_DO_GAIN_ACTIVE_1, eDM_TYPE_BOOL, eDM_UNIT_NONE, 1,   1,      0,  0,  1,      0,  "Gain active 1" ) \
+    DM_SIGNAL( eDM_SIG_ADC1_9,      eDM_TYPE_U16,   eDM_UNIT_MV,    3300,   8190,   0,  0,  8190,   0,  "ADC1 channel 9" ) \
+    DM_SIGNAL( eDM_SIG_ADC1_9_HIGH, eDM_TYPE_BOOL,  eDM_UNIT_NONE,  1,      1,      0,  0,  1,      0,  "ADC1 channel 9 high alarm" ) \
+    DM_SIGNAL( eDM_SIG_ADC1_9_LOW,  eDM_TYPE_BOOL,  eDM_UNIT_NONE,  1,      1,      0,  0,  1,      0,  "ADC1 channel 9 low alarm" ) \
+    DM_SIGNAL( eDM_SIG_ADC1_9_RMS,  eDM_TYPE_U16,   eDM_UNIT_MV,    3300,   4095,   0,  0,  4095,   2,  "ADC1 channel 9 RMS" ) \
+    DM_SIGNAL( eDM_SIG_ADC1_9_100HZ, eDM_TYPE_U16,  eDM_UNIT_MV,    3300,   4095,   0,  0,  4095,   2,  "ADC1 channel 9 100Hz amplitude" ) \
+    DM_SIGNAL( eDM_SIG_ADC1_9_120HZ, eDM_TYPE_U16,  eDM_UNIT_MV,    3300,   4095,   0,  0,  4095,   2,  "ADC1 channel 9 120Hz amplitude" )
+
+/* ADC1 channel 9 is published every 4ms ( 1kHz trigger, decimation by 4 ): raw 2s, fast 200ms for 25.6s,
+ * slow 2s for 128s */
+#define DM_HISTORIES \
+    DM_HISTORY( eDM_HIST_ADC1_9,    eDM_SIG_ADC1_9,     512,    50,     128,    10,     64 ) \
+    DM_HISTORY( eDM_HIST_LED_6,     eDM_SIG_DO_LED_6,   64,     8,      32,     8,      16 )
+
+/*----------------------------------------------------------------------------\
+|   End of dm_signals.h header file                                           |
+\----------------------------------------------------------------------------*/
+
+#endif  /* dm_signals_H */
@@ -72,13 +72,31 @@
  *     ADC1 core non-shared channels: AD1IN[ 7:0 ] and AD1IN[ 31:24 ]
  *     ADC2 core non-shared channels: AD2IN[ 24:16 ]
  *   Will trigger an initial start of conversion in the ADC initialization function.  Subsequent start of conversion
- *     triggers will be done using a periodic OS task
- *   Will use End Of Conversion interrupt for all ADC groups and update the Data Manager with the converged ADC values
- *   Will not use magnitude threshold detection
+ *     triggers will be done using a periodic OS task ( adcTrigger ) for software triggered groups only. Groups with
+ *     a hardware trigger convert on every edge of their source ( N2HET pin, RTI compare 0, ePWM, GIO ), so their
+ *     sample timing does not depend on the scheduler
+ *   Will decimate in the acquisition path: channels with a filter run its integrators on every result and publish
+ *     once per 2^decimation_log2 results. eADC_FILTER_BOXCAR is the one stage case ( sum of the block ), the CIC
+ *     stages sharpen the anti-alias response. The sum grows by order * decimation_log2 bits, of which extra_bits
+ *     are kept, e.g. boxcar over 4 results with 1 extra bit gives a 13 bit value with half the noise
+ *   Will calibrate in the acquisition path ( fw_adc_cal ): every published value is converted once and the
+ *     engineering value is published next to it, so consumers do no conversions of their own
+ *   Will use End Of Conversion interrupt for all ADC groups and update the Data Manager with the converged ADC values:
+ *     the interrupt drains the whole group FIFO, routes every result to its channel by the channel id in the result
+ *     and publishes the Analogue Inputs once per conversion, so no task runs per sample
+ *   Will use magnitude threshold detection for the alarms in adc_alarm_config_defs: one comparator per alarm, armed
+ *     for the trip condition and re-armed for the release condition ( threshold and hysteresis ) each time it fires.
+ *     In-range results cost no CPU time, the interrupt only runs on a change of alarm state and sets the alarm's
+ *     Data Manager signal, which wakes the subscribers of that signal only
  *   Will not use ADC EVT output pin
  *   Implemented custom ADC initialization function in order to read application configuration rather than use HALCoGen
  *   Implemented custom ADC start conversion function to support the ADC initialization function
- *   Used HALCoGen only to create the End Of Conversion interrupt handlers as they must be named as expected by the HAL
+ *   The HALCoGen ADC driver is disabled, so the group interrupt handlers are implemented here under the HALCoGen names
+ *     and mapped into the VIM by the ADC initialization function
+ *   The group interrupts do not nest, so all of them together are the single writer of the Analogue Inputs
+ *   Groups listed in adc_dma_config_defs have their results moved by the DMA instead: one DMA request per result,
+ *     two blocks filled in turn ( HBC / BTC of one auto-initialising channel ) and one interrupt per block. The
+ *     block interrupts are group A DMA interrupts, so they share the writer context with the group interrupts
  *
  */
 
@@ -90,19 +108,67 @@
 |   Header Files                                                              |
 \----------------------------------------------------------------------------*/
 
+#include <stdint.h>
+#include <string.h>
+
 #include "HL_adc.h"
+#include "HL_sys_dma.h"
+#include "HL_sys_vim.h"
 
 #include "data_manager.h"
 #include "fw_adc.h"
+#include "fw_adc_cal.h"
+#include "fw_cache.h"
+#include "fw_log.h"
+#include "fw_trace.h"
+#include "fw_utils.h"
 
 /*----------------------------------------------------------------------------\
 |   Private Type Definitions                                                  |
 \----------------------------------------------------------------------------*/
 
+typedef struct
+{
+    U32                         next_half;          /* Block expected next, 0: first half, 1: second half */
+} S_ADC_DMA_STATE;
+
+/* Cascaded integrator / comb decimator of one channel, all sums wrap modulo 2^32 */
+typedef struct
+{
+    U32                         integrator[ ADC_DECIM_ORDER_MAX ];
+    U32                         comb[ ADC_DECIM_ORDER_MAX ];        /* Previous input of every comb stage */
+    U32                         count;              /* Results since the last output */
+    U32                         order;              /* 0: no decimation */
+    U32                         ratio;
+    U32                         shift;              /* Growth bits dropped from the output */
+} S_ADC_DECIM_STATE;
+
 /*----------------------------------------------------------------------------\
 |   Private Constant Definitions                                              |
 \----------------------------------------------------------------------------*/
 
+#define ADC_TIMESTAMP()             ( rtiREG1->CNT[ 0 ].FRCx )
+
+#define ADC_INTFLG_THRESHOLD        0x00000001U         /* GxINTFLG */
+#define ADC_INTFLG_OVERRUN          0x00000002U
+#define ADC_INTFLG_END              0x00000008U
+#define ADC_INTENA_END              0x00000008U         /* GxINTENA */
+#define ADC_SR_BUSY                 0x00000004U         /* EVSR, G1SR, G2SR */
+#define ADC_DMACR_DMA_EN            0x00000001U         /* EVDMACR, G1DMACR, G2DMACR: request per result */
+#define ADC_MODECR_HW_TRIG          0x00000008U         /* G1MODECR, G2MODECR */
+#define ADC_SRC_EDGE_RISING         0x00000008U         /* EVSRC, G1SRC, G2SRC */
+
+#define ADC_MAGCR_GE                0x00000002U         /* MAGINTCRx: result >= threshold, else result < threshold */
+#define ADC_MAG_FLAGS               0x00000007U         /* MAGTHRINTFLG / MAGTHRINTENASET, one bit per comparator */
+#define ADC_MAG_NONE                0xFFu
+
+#define ADC_DMA_NONE                0xFFu
+#define ADC_DMA_VIM_HBCA            39U
+#define ADC_DMA_VIM_BTCA            40U
+
+#define ADC_RESULT_VALUE( buf )     ( ( buf ) & 0x00000FFFU )               /* 12 bit mode */
+#define ADC_RESULT_CHID( buf )      ( ( ( buf ) >> 16U ) & 0x0000001FU )
+
 /* ADC cores configuration */
 static const S_ADC_UNIT_CONFIG adc_unit_config_defs[] =
 {
@@ -119,6 +185,8 @@ static const S_ADC_UNIT_CONFIG adc_unit_config_defs[] =
                 .continuous_conv = FALSE,
                 .sampling_cap_discharge = FALSE,
                 .conv_end_interrupt_en = TRUE,      /* Leave as is, otherwise must poll for end of conversion */
+                .trigger = eADC_TRIGGER_FALLING,
+                .trigger_source = ( U32 ) ADC1_EVENT,
             },
             {
                 .group = eADC_GROUP_1,              /* Leave as is */
@@ -127,6 +195,8 @@ static const S_ADC_UNIT_CONFIG adc_unit_config_defs[] =
                 .continuous_conv = FALSE,
                 .sampling_cap_discharge = FALSE,
                 .conv_end_interrupt_en = TRUE,      /* Leave as is, otherwise must poll for end of conversion */
+                .trigger = eADC_TRIGGER_RISING,
+                .trigger_source = ( U32 ) ADC1_RTI_COMP0,   /* OS tick, configTICK_RATE_HZ */
             },
             {
                 .group = eADC_GROUP_2,              /* Leave as is */
@@ -135,6 +205,8 @@ static const S_ADC_UNIT_CONFIG adc_unit_config_defs[] =
                 .continuous_conv = FALSE,
                 .sampling_cap_discharge = FALSE,
                 .conv_end_interrupt_en = TRUE,      /* Leave as is, otherwise must poll for end of conversion */
+                .trigger = eADC_TRIGGER_SOFTWARE,
+                .trigger_source = ( U32 ) ADC1_EVENT,
             },
         },
         .enabled = TRUE,
@@ -152,6 +224,8 @@ static const S_ADC_UNIT_CONFIG adc_unit_config_defs[] =
                 .continuous_conv = FALSE,
                 .sampling_cap_discharge = FALSE,
                 .conv_end_interrupt_en = TRUE,      /* Leave as is, otherwise must poll for end of conversion */
+                .trigger = eADC_TRIGGER_FALLING,
+                .trigger_source = ( U32 ) ADC2_EVENT,
             },
             {
                 .group = eADC_GROUP_1,              /* Leave as is */
@@ -160,6 +234,8 @@ static const S_ADC_UNIT_CONFIG adc_unit_config_defs[] =
                 .continuous_conv = FALSE,
                 .sampling_cap_discharge = FALSE,
                 .conv_end_interrupt_en = TRUE,      /* Leave as is, otherwise must poll for end of conversion */
+                .trigger = eADC_TRIGGER_SOFTWARE,
+                .trigger_source = ( U32 ) ADC2_EVENT,
             },
             {
                 .group = eADC_GROUP_2,              /* Leave as is */
@@ -168,6 +244,8 @@ static const S_ADC_UNIT_CONFIG adc_unit_config_defs[] =
                 .continuous_conv = FALSE,
                 .sampling_cap_discharge = FALSE,
                 .conv_end_interrupt_en = TRUE,      /* Leave as is, otherwise must poll for end of conversion */
+                .trigger = eADC_TRIGGER_SOFTWARE,
+                .trigger_source = ( U32 ) ADC2_EVENT,
             },
         },
         .enabled = FALSE,
@@ -183,10 +261,51 @@ static const S_ADC_CHANNEL_CONFIG adc_channel_config_defs[] =
         .unit = eADC_UNIT_1,
         .group = eADC_GROUP_1,
         .ch = 9u,
+        .filter = eADC_FILTER_BOXCAR,
+        .decimation_log2 = 2u,
+        .extra_bits = 1u,
+        .enabled = TRUE,
+    },
+};
+
+/* Channel alarms, at most ADC_MAG_COMPARATORS per unit */
+static const S_ADC_ALARM_CONFIG adc_alarm_config_defs[] =
+{
+    {
+        .id = eADC1_9,
+        .kind = eADC_ALARM_HIGH,
+        .threshold = 3900u,
+        .hysteresis = 200u,
+        .signal = ( U16 ) eDM_SIG_ADC1_9_HIGH,
+        .enabled = TRUE,
+    },
+    {
+        .id = eADC1_9,
+        .kind = eADC_ALARM_LOW,
+        .threshold = 200u,
+        .hysteresis = 100u,
+        .signal = ( U16 ) eDM_SIG_ADC1_9_LOW,
         .enabled = TRUE,
     },
 };
 
+#define ADC_ALARMS                  ( sizeof( adc_alarm_config_defs ) / sizeof( adc_alarm_config_defs[ 0 ] ) )
+
+/* ADC groups served by the DMA */
+static const S_ADC_DMA_CONFIG adc_dma_config_defs[] =
+{
+    {
+        .unit = eADC_UNIT_1,
+        .group = eADC_GROUP_1,
+        .dma_channel = ( U8 ) DMA_CH0,
+        .dma_request = ( U8 ) DMA_REQ10,            /* MIBADC1 group 1 */
+        .block_results = 64u,
+        .enabled = FALSE,
+    },
+};
+
+#define ADC_DMA_STREAMS             ( sizeof( adc_dma_config_defs ) / sizeof( adc_dma_config_defs[ 0 ] ) )
+
 /* s_adc_FiFoSize is used as constant table for channel selection */
 static const uint32 s_adc_FiFoSize[ eADC_UNIT_MAX ][ eADC_GROUP_MAX ] =
 {
@@ -217,11 +336,44 @@ static uint32 s_adc_Select[ eADC_UNIT_MAX ][ eADC_GROUP_MAX ] =
      },
 };
 
+/* VIM channels of the group interrupts */
+static const U32 adc_vim_channels[ eADC_UNIT_MAX ][ eADC_GROUP_MAX ] =
+{
+    { 14U, 15U, 28U },                              /* ADC1 - EVENT GROUP, GROUP1, GROUP2 */
+    { 50U, 51U, 57U },                              /* ADC2 - EVENT GROUP, GROUP1, GROUP2 */
+};
+
+/* VIM channels of the magnitude threshold interrupts */
+static const U32 adc_mag_vim_channels[ eADC_UNIT_MAX ] = { 31U, 59U };
+
 /*----------------------------------------------------------------------------\
 |   Private Data Declarations                                                 |
 \----------------------------------------------------------------------------*/
 
-static int adc_raw[ eADC_CHANNEL_MAX ];
+/* E_ADC_ID of every hardware channel, ADC_CHANNEL_NONE if not configured */
+static U8 adc_channel_map[ eADC_UNIT_MAX ][ ADC_HW_CHANNELS ];
+
+/* Results per conversion of every group */
+static U32 adc_group_expected[ eADC_UNIT_MAX ][ eADC_GROUP_MAX ];
+
+static S_ADC_GROUP_STATS adc_stats[ eADC_UNIT_MAX ][ eADC_GROUP_MAX ];
+
+static S_ADC_DECIM_STATE adc_decim[ eADC_CHANNEL_MAX ];
+
+/* Alarm served by every comparator, ADC_MAG_NONE if unused */
+static U8 adc_mag_alarm[ eADC_UNIT_MAX ][ ADC_MAG_COMPARATORS ];
+static S_ADC_ALARM_STATS adc_alarm_stats[ ADC_ALARMS ];
+
+/* Written by the group interrupts only, published whole after every conversion */
+static S_ANALOGUE_INPUTS adc_inputs;
+
+/* DMA streams: ping-pong blocks, cache line aligned for the invalidation */
+#pragma DATA_ALIGN( adc_dma_buffer, 32 )
+static U32 adc_dma_buffer[ ADC_DMA_STREAMS ][ 2u * ADC_DMA_BLOCK_MAX ];
+static S_ADC_DMA_STATE adc_dma_state[ ADC_DMA_STREAMS ];
+static U8 adc_dma_stream_of_group[ eADC_UNIT_MAX ][ eADC_GROUP_MAX ];
+static U8 adc_dma_stream_of_channel[ 32u ];
+static ADC_BLOCK_HANDLER adc_block_handler = NULL;
 
 /*----------------------------------------------------------------------------\
 |   Public Constant Declarations                                              |
@@ -231,16 +383,110 @@ static int adc_raw[ eADC_CHANNEL_MAX ];
 |   Private Function Declarations                                             |
 \----------------------------------------------------------------------------*/
 
+void adc1Group0Interrupt( void );
+void adc1Group1Interrupt( void );
+void adc1Group2Interrupt( void );
+void adc2Group0Interrupt( void );
+void adc2Group1Interrupt( void );
+void adc2Group2Interrupt( void );
+void dmaHBCAInterrupt( void );
+void dmaBTCAInterrupt( void );
+void adc1MagnitudeInterrupt( void );
+void adc2MagnitudeInterrupt( void );
+
+static BOOLEAN adcStoreResult( U32 unit, S_ADC_GROUP_STATS *p_stats, U32 buf, U32 now );
+static BOOLEAN adcDecimate( S_ADC_DECIM_STATE *p_decim, U32 value, U32 *out );
+static void adcDecimInit( const S_ADC_CHANNEL_CONFIG *p_ch, S_ADC_DECIM_STATE *p_decim );
+static void adcDmaInit( void );
+static void adcAlarmInit( U32 unit, adcBASE_t *p_adc );
+static void adcAlarmArm( adcBASE_t *p_adc, U32 comparator, U32 alarm );
+static void adcMagnitude( U32 unit, adcBASE_t *p_adc );
+static void adcDmaBlock( U32 channel, U32 half );
+static U32 adcPingPongTake( S_ADC_DMA_STATE *p_state, U32 half, BOOLEAN next_pending );
+
+static const t_isrFuncPTR adc_isrs[ eADC_UNIT_MAX ][ eADC_GROUP_MAX ] =
+{
+    { &adc1Group0Interrupt, &adc1Group1Interrupt, &adc1Group2Interrupt },
+    { &adc2Group0Interrupt, &adc2Group1Interrupt, &adc2Group2Interrupt },
+};
+
 /*----------------------------------------------------------------------------\
 |   Public Function Implementations                                           |
 \----------------------------------------------------------------------------*/
 
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : adcNotification                                     |
+|                                                                             |
+|   Description         : Drains the FIFO of a group at the end of its        |
+|                         conversion, stores every result in the channel      |
+|                         named by its channel id and publishes the Analogue  |
+|                         Inputs once.                                        |
+|                                                                             |
+|   Inputs              : ADC core.                                           |
+|                         Group.                                              |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Group interrupt context only.                       |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
 void adcNotification(adcBASE_t *adc, uint32 group)
 {
-    adcData_t data;
-    volatile uint32 count;
+    U32 i;
+    U32 count;
+    U32 intcr;
+    BOOLEAN stored = FALSE;
+    BOOLEAN overrun = FALSE;
+    U32 now = ADC_TIMESTAMP();
+    U32 unit = ( adc == adcREG1 ) ? eADC_UNIT_1 : eADC_UNIT_2;
+    S_ADC_GROUP_STATS *p_stats = &adc_stats[ unit ][ group ];
+
+    TRC_ISR_ENTER( eTRC_ISR_ADC );
+
+    p_stats->conversions++;
+
+    /* Results in the FIFO, as HALCoGen's adcGetData() works it out */
+    intcr = adc->GxINTCR[ group ];
+    count = ( intcr >= 256U ) ? s_adc_FiFoSize[ unit ][ group ] : ( s_adc_FiFoSize[ unit ][ group ] - ( intcr & 0xFFU ) );
+
+    if ( ( adc->GxINTFLG[ group ] & ADC_INTFLG_OVERRUN ) != 0U )
+    {
+        /* The FIFO content no longer lines up with the conversion, drop it */
+        p_stats->overruns++;
+        adc->GxFIFORESETCR[ group ] = 1U;
+        count = 0U;
+        overrun = TRUE;
+    }
+
+    for ( i = 0U; i < count; i++ )
+    {
+        if ( adcStoreResult( unit, p_stats, adc->GxBUF[ group ].BUF0, now ) == TRUE )
+        {
+            stored = TRUE;
+        }
+    }
+
+    p_stats->samples += count;
+
+    /* A dropped FIFO is already counted as an overrun, not as missing results too */
+    if ( ( overrun == FALSE ) && ( count < adc_group_expected[ unit ][ group ] ) )
+    {
+        p_stats->missing += adc_group_expected[ unit ][ group ] - count;
+    }
+
+    adc->GxINTFLG[ group ] = ADC_INTFLG_END | ADC_INTFLG_THRESHOLD;
+
+    /* Decimating channels only publish once per block of results */
+    if ( stored == TRUE )
+    {
+        dmAnalogueInputsPublish( &adc_inputs );
+    }
 
-    count = adcGetData( adc, group, &data );
+    TRC_ISR_EXIT( eTRC_ISR_ADC );
 }
 
 void adc_start_conversion( adcBASE_t *adc, uint32 group )
@@ -254,19 +500,55 @@ void adc_start_conversion( adcBASE_t *adc, uint32 group )
     adc->GxSEL[ group ] = s_adc_Select[ index ][ group ];
 }
 
-void adc_read_channels( void )
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : adcTrigger                                          |
+|                                                                             |
+|   Description         : Starts the next conversion of every software        |
+|                         triggered group that has channels. A group still    |
+|                         converting is skipped and counted in trigger_busy.  |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Call from one periodic task, after adc_init().      |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void adcTrigger( void )
 {
-    int i;
+    U32 i, j;
+    adcBASE_t * p_adc[ eADC_UNIT_MAX ] = { adcREG1, adcREG2 };
     const S_ADC_UNIT_CONFIG * const p_adc_unit = adcGetUnitConfig();
-    const S_ADC_CHANNEL_CONFIG * const p_adc_ch = adcGetChannelConfig();
-    S_DM_ANALOGUE_INPUTS *ptr_dm_analogue_inputs = ( S_DM_ANALOGUE_INPUTS * ) dmAnalogueInputsAccess();
 
-    for ( i = 0; i < eADC_CHANNEL_MAX; i++ )
+    for ( i = 0U; i < eADC_UNIT_MAX; i++ )
     {
-        if ( p_adc_ch[ i ].enabled == TRUE )
+        if ( p_adc_unit[ i ].enabled == FALSE )
+        {
+            continue;
+        }
+
+        for ( j = 0U; j < eADC_GROUP_MAX; j++ )
         {
-            /* TODO Read ADC channel */
-            ptr_dm_analogue_inputs->ptr_analogue_inputs->adc_raw[ i ] = adc_raw[ p_adc_ch[ i ].ch ];
+            /* Continuous groups restart themselves, hardware triggered groups wait for their source */
+            if ( ( s_adc_Select[ i ][ j ] == 0U ) || ( p_adc_unit[ i ].group_config[ j ].continuous_conv == TRUE ) ||
+                 ( p_adc_unit[ i ].group_config[ j ].trigger != eADC_TRIGGER_SOFTWARE ) )
+            {
+                continue;
+            }
+
+            /* EVSR, G1SR and G2SR are consecutive */
+            if ( ( ( &p_adc[ i ]->EVSR )[ j ] & ADC_SR_BUSY ) != 0U )
+            {
+                adc_stats[ i ][ j ].trigger_busy++;
+            }
+            else
+            {
+                adc_start_conversion( p_adc[ i ], j );
+            }
         }
     }
 }
@@ -274,18 +556,30 @@ void adc_read_channels( void )
 void adc_init( void )
 {
     int i, j;
+    U32 src;
     adcBASE_t * p_adc[ eADC_UNIT_MAX ] = { adcREG1, adcREG2 };
-    S_DM_DATABASE *ptr_dm_database = ( S_DM_DATABASE * ) dmFullDataAccess();
     const S_ADC_UNIT_CONFIG * const p_adc_unit = adcGetUnitConfig();
     const S_ADC_CHANNEL_CONFIG * const p_adc_ch = adcGetChannelConfig();
 
-    /* Setup ADC channels array */
+    memset( adc_channel_map, ADC_CHANNEL_NONE, sizeof( adc_channel_map ) );
+    memset( adc_group_expected, 0, sizeof( adc_group_expected ) );
+    memset( adc_stats, 0, sizeof( adc_stats ) );
+    memset( &adc_inputs, 0, sizeof( adc_inputs ) );
+
+    /* Calibration and DMA channels first, they must be ready for the first result */
+    ( void ) adcCalInit();
+    adcDmaInit();
+
+    /* Setup ADC channels array, the result demultiplexing map and the results per conversion */
     for ( i = 0; i < eADC_CHANNEL_MAX; i++ )
     {
         if ( p_adc_ch[ i ].enabled == TRUE )                            /* Check ADC enabled */
         {
             s_adc_Select[ p_adc_ch[ i ].unit ][ p_adc_ch[ i ].group ] |= ( uint32 ) ( ( uint32 ) 1U << p_adc_ch[ i ].ch );
+            adc_channel_map[ p_adc_ch[ i ].unit ][ p_adc_ch[ i ].ch ] = ( U8 ) p_adc_ch[ i ].id;
+            adc_group_expected[ p_adc_ch[ i ].unit ][ p_adc_ch[ i ].group ]++;
         }
+        adcDecimInit( &p_adc_ch[ i ], &adc_decim[ i ] );
     }
 
     /* Setup ADC units */
@@ -325,7 +619,15 @@ void adc_init( void )
                     p_adc[ i ]->GxMODECR[ j ] |= ( uint32 ) 0x00000002U;
                 }
 
-                /* Setup event group hardware trigger:
+                /* Setup hardware trigger mode, the event group is always hardware triggered */
+                if ( ( j != eADC_EVENT_GROUP ) && ( p_adc_unit[ i ].group_config[ j ].trigger != eADC_TRIGGER_SOFTWARE ) )
+                {
+                    p_adc[ i ]->GxMODECR[ j ] |= ADC_MODECR_HW_TRIG;
+                }
+                src = ( p_adc_unit[ i ].group_config[ j ].trigger == eADC_TRIGGER_RISING ) ? ADC_SRC_EDGE_RISING : 0U;
+                src |= p_adc_unit[ i ].group_config[ j ].trigger_source;
+
+                /* Setup group hardware trigger:
                  *   Setup hardware trigger edge
                  *   Setup hardware trigger source
                  * Setup event group sample window
@@ -336,7 +638,7 @@ void adc_init( void )
                 switch ( p_adc_unit[ i ].group_config[ j ].group )
                 {
                     case eADC_EVENT_GROUP:
-                        p_adc[ i ]->EVSRC = ( uint32 ) 0x00000000U | ( uint32 ) ADC1_EVENT;
+                        p_adc[ i ]->EVSRC = src;
                         p_adc[ i ]->EVSAMP = 1U;
                         p_adc[ i ]->EVSAMPDISEN = ( uint32 ) ( ( uint32 ) 0U << 8U );
                         ( p_adc_unit[ i ].group_config[ j ].sampling_cap_discharge == TRUE ) ?
@@ -344,7 +646,7 @@ void adc_init( void )
                                 ( p_adc[ i ]->EVSAMPDISEN |= ( uint32 ) 0x00000000U );
                         break;
                     case eADC_GROUP_1:
-                        p_adc[ i ]->G1SRC = ( uint32 ) 0x00000000U | ( uint32 ) ADC1_EVENT;
+                        p_adc[ i ]->G1SRC = src;
                         p_adc[ i ]->G1SAMP = 1U;
                         p_adc[ i ]->G1SAMPDISEN = ( uint32 ) ( ( uint32 ) 0U << 8U );
                         ( p_adc_unit[ i ].group_config[ j ].sampling_cap_discharge == TRUE ) ?
@@ -352,7 +654,7 @@ void adc_init( void )
                                 ( p_adc[ i ]->G1SAMPDISEN |= ( uint32 ) 0x00000000U );
                         break;
                     case eADC_GROUP_2:
-                        p_adc[ i ]->G2SRC = ( uint32 ) 0x00000000U | ( uint32 ) ADC1_EVENT;
+                        p_adc[ i ]->G2SRC = src;
                         p_adc[ i ]->G2SAMP = 1U;
                         p_adc[ i ]->G2SAMPDISEN = ( uint32 ) ( ( uint32 ) 0U << 8U );
                         ( p_adc_unit[ i ].group_config[ j ].sampling_cap_discharge == TRUE ) ?
@@ -363,10 +665,17 @@ void adc_init( void )
                         break;
                 }
 
-                /* Enable End Of Conversion notification interrupt for ADC group */
-                if ( p_adc_unit[ i ].group_config[ j ].conv_end_interrupt_en == TRUE )
+                /* DMA groups raise a DMA request per result instead of the End Of Conversion interrupt */
+                if ( adc_dma_stream_of_group[ i ][ j ] != ADC_DMA_NONE )
+                {
+                    ( &p_adc[ i ]->EVDMACR )[ j ] = ADC_DMACR_DMA_EN;
+                }
+                /* Enable End Of Conversion interrupt for ADC group and route it through the VIM */
+                else if ( p_adc_unit[ i ].group_config[ j ].conv_end_interrupt_en == TRUE )
                 {
-                    adcEnableNotification( p_adc[ i ], j );
+                    p_adc[ i ]->GxINTENA[ j ] = ADC_INTENA_END;
+                    vimChannelMap( adc_vim_channels[ i ][ j ], adc_vim_channels[ i ][ j ], adc_isrs[ i ][ j ] );
+                    vimEnableInterrupt( adc_vim_channels[ i ][ j ], SYS_IRQ );
                 }
             }
 
@@ -394,6 +703,9 @@ void adc_init( void )
                 ;
             }
 
+            /* Alarms, before the first conversion */
+            adcAlarmInit( i, p_adc[ i ] );
+
             /* Setup parity */
             ( p_adc_unit[ i ].ram_parity == TRUE ) ? ( p_adc[ i ]->PARCR = 0x0000000AU ) : ( p_adc[ i ]->PARCR = 0x00000005U );
 
@@ -419,10 +731,512 @@ const S_ADC_CHANNEL_CONFIG * const adcGetChannelConfig( void )
     return adc_channel_config_defs;
 }
 
+const S_ADC_GROUP_STATS * adcGetStats( E_ADC_UNIT unit, E_ADC_GROUP group )
+{
+    return &adc_stats[ unit ][ group ];
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : adcAlarmAck                                         |
+|                                                                             |
+|   Description         : Called by the task woken for an alarm signal:       |
+|                         measures the reaction time from the magnitude       |
+|                         interrupt and logs the alarm.                       |
+|                                                                             |
+|   Inputs              : Alarm, index in adc_alarm_config_defs.              |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : Alarm state, FALSE for an unknown alarm.            |
+|                                                                             |
+|   Warnings            : Once per wake up, a second call measures the time   |
+|                         since the interrupt again.                          |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN adcAlarmAck( U32 alarm )
+{
+    U32 latency;
+    S_ADC_ALARM_STATS *p_stats;
+
+    if ( alarm >= ADC_ALARMS )
+    {
+        return FALSE;
+    }
+
+    p_stats = &adc_alarm_stats[ alarm ];
+    latency = ADC_TIMESTAMP() - p_stats->time;
+    p_stats->last_latency = latency;
+    if ( latency > p_stats->max_latency )
+    {
+        p_stats->max_latency = latency;
+    }
+
+    LOG3( eLOG_MSG_ADC_ALARM, alarm, p_stats->active, latency );
+
+    return p_stats->active;
+}
+
+const S_ADC_ALARM_STATS * adcGetAlarmStats( U32 alarm )
+{
+    return ( alarm < ADC_ALARMS ) ? &adc_alarm_stats[ alarm ] : NULL;
+}
+
+/* Raw results of every DMA block, e.g. for filtering. Runs in the block
+ * interrupt, NULL to remove. Set before the first block or with the DMA
+ * interrupts masked.
+ */
+void adcSetBlockHandler( ADC_BLOCK_HANDLER handler )
+{
+    adc_block_handler = handler;
+}
+
 /*----------------------------------------------------------------------------\
 |   Private Function Implementations                                          |
 \----------------------------------------------------------------------------*/
 
+/* Stores one result word in its channel, results of unconfigured channels
+ * are counted. Returns TRUE when the channel has a new value, for a
+ * decimating channel only on the last result of a block.
+ */
+static BOOLEAN adcStoreResult( U32 unit, S_ADC_GROUP_STATS *p_stats, U32 buf, U32 now )
+{
+    U32 value;
+    U8 id = adc_channel_map[ unit ][ ADC_RESULT_CHID( buf ) ];
+
+    if ( id == ADC_CHANNEL_NONE )
+    {
+        p_stats->unknown++;
+        return FALSE;
+    }
+
+    if ( adcDecimate( &adc_decim[ id ], ADC_RESULT_VALUE( buf ), &value ) == FALSE )
+    {
+        return FALSE;
+    }
+
+    adc_inputs.adc_raw[ id ] = ( int ) value;
+    adc_inputs.adc_eng[ id ] = adcCalApply( id, ( S32 ) value );
+    adc_inputs.adc_time[ id ] = now;
+
+    return TRUE;
+}
+
+/* One input of a decimator: the integrators run on every result, the combs
+ * once per ratio results. Unsigned wrap-around keeps the output exact as long
+ * as it fits in 32 bits, which adcDecimInit() checks.
+ */
+static BOOLEAN adcDecimate( S_ADC_DECIM_STATE *p_decim, U32 value, U32 *out )
+{
+    U32 k;
+    U32 y;
+    U32 previous;
+
+    if ( p_decim->order == 0U )
+    {
+        *out = value;
+        return TRUE;
+    }
+
+    p_decim->integrator[ 0 ] += value;
+    for ( k = 1U; k < p_decim->order; k++ )
+    {
+        p_decim->integrator[ k ] += p_decim->integrator[ k - 1U ];
+    }
+
+    if ( ++p_decim->count < p_decim->ratio )
+    {
+        return FALSE;
+    }
+    p_decim->count = 0U;
+
+    y = p_decim->integrator[ p_decim->order - 1U ];
+    for ( k = 0U; k < p_decim->order; k++ )
+    {
+        previous = p_decim->comb[ k ];
+        p_decim->comb[ k ] = y;
+        y -= previous;
+    }
+
+    *out = y >> p_decim->shift;
+    return TRUE;
+}
+
+/* Decimator of a channel from its configuration. A filter the sums cannot
+ * hold, or that keeps more bits than it grows, falls back to no decimation.
+ */
+static void adcDecimInit( const S_ADC_CHANNEL_CONFIG *p_ch, S_ADC_DECIM_STATE *p_decim )
+{
+    U32 growth = ( U32 ) p_ch->filter * p_ch->decimation_log2;
+
+    memset( p_decim, 0, sizeof( *p_decim ) );
+
+    if ( ( p_ch->filter == eADC_FILTER_NONE ) || ( ( U32 ) p_ch->filter > ADC_DECIM_ORDER_MAX ) ||
+         ( p_ch->decimation_log2 == 0u ) || ( growth > ADC_DECIM_GROWTH_MAX ) || ( p_ch->extra_bits > growth ) )
+    {
+        return;
+    }
+
+    p_decim->order = ( U32 ) p_ch->filter;
+    p_decim->ratio = ( U32 ) 1U << p_ch->decimation_log2;
+    p_decim->shift = growth - p_ch->extra_bits;
+}
+
+/* Hands the comparators of a unit to its enabled alarms in table order and
+ * arms them for the trip condition. Alarms beyond the comparators of the
+ * unit stay off.
+ */
+static void adcAlarmInit( U32 unit, adcBASE_t *p_adc )
+{
+    U32 i;
+    U32 used = 0U;
+    const S_ADC_CHANNEL_CONFIG * const p_adc_ch = adcGetChannelConfig();
+
+    memset( adc_mag_alarm[ unit ], ADC_MAG_NONE, sizeof( adc_mag_alarm[ unit ] ) );
+    p_adc->MAGTHRINTENACLR = ADC_MAG_FLAGS;
+    p_adc->MAGTHRINTFLG = ADC_MAG_FLAGS;
+
+    for ( i = 0U; ( i < ADC_ALARMS ) && ( used < ADC_MAG_COMPARATORS ); i++ )
+    {
+        if ( ( adc_alarm_config_defs[ i ].enabled == FALSE ) ||
+             ( p_adc_ch[ adc_alarm_config_defs[ i ].id ].unit != ( E_ADC_UNIT ) unit ) )
+        {
+            continue;
+        }
+
+        memset( &adc_alarm_stats[ i ], 0, sizeof( adc_alarm_stats[ i ] ) );
+        adc_mag_alarm[ unit ][ used ] = ( U8 ) i;
+        ( &p_adc->MAGINT1MASK )[ 2U * used ] = 0U;                      /* Compare every result bit */
+        adcAlarmArm( p_adc, used, i );
+        used++;
+    }
+
+    if ( used != 0U )
+    {
+        p_adc->MAGTHRINTENASET = ( ( U32 ) 1U << used ) - 1U;
+        vimChannelMap( adc_mag_vim_channels[ unit ], adc_mag_vim_channels[ unit ], ( unit == eADC_UNIT_1 ) ? &adc1MagnitudeInterrupt : &adc2MagnitudeInterrupt );
+        vimEnableInterrupt( adc_mag_vim_channels[ unit ], SYS_IRQ );
+    }
+}
+
+/* Programs a comparator for the next change of its alarm: the threshold while
+ * the alarm is clear, the threshold moved back by the hysteresis while it is
+ * raised.
+ */
+static void adcAlarmArm( adcBASE_t *p_adc, U32 comparator, U32 alarm )
+{
+    const S_ADC_ALARM_CONFIG *p_cfg = &adc_alarm_config_defs[ alarm ];
+    const S_ADC_CHANNEL_CONFIG * const p_adc_ch = adcGetChannelConfig();
+    BOOLEAN high = ( p_cfg->kind == eADC_ALARM_HIGH ) ? TRUE : FALSE;
+    U32 threshold = p_cfg->threshold;
+    U32 ge;
+
+    if ( adc_alarm_stats[ alarm ].active == FALSE )
+    {
+        ge = ( high == TRUE ) ? ADC_MAGCR_GE : 0U;
+    }
+    else if ( high == TRUE )
+    {
+        threshold = ( threshold > p_cfg->hysteresis ) ? ( threshold - p_cfg->hysteresis ) : 0U;
+        ge = 0U;
+    }
+    else
+    {
+        threshold = threshold + p_cfg->hysteresis;
+        ge = ADC_MAGCR_GE;
+    }
+
+    ( &p_adc->MAGINTCR1 )[ 2U * comparator ] = ( ( threshold & 0x0FFFU ) << 16U ) |
+                                                ( ( U32 ) p_adc_ch[ p_cfg->id ].ch << 8U ) | ge;
+}
+
+/* Toggles every alarm whose comparator fired, re-arms it the other way and
+ * sets its signal
+ */
+static void adcMagnitude( U32 unit, adcBASE_t *p_adc )
+{
+    U32 k;
+    U32 alarm;
+    U32 now = ADC_TIMESTAMP();
+    U32 flags = p_adc->MAGTHRINTFLG & ADC_MAG_FLAGS;
+    S_ADC_ALARM_STATS *p_stats;
+
+    TRC_ISR_ENTER( eTRC_ISR_ADC );
+
+    p_adc->MAGTHRINTFLG = flags;
+
+    for ( k = 0U; k < ADC_MAG_COMPARATORS; k++ )
+    {
+        alarm = adc_mag_alarm[ unit ][ k ];
+        if ( ( ( flags & ( ( U32 ) 1U << k ) ) == 0U ) || ( alarm == ADC_MAG_NONE ) )
+        {
+            continue;
+        }
+
+        p_stats = &adc_alarm_stats[ alarm ];
+        p_stats->active = ( p_stats->active == FALSE ) ? TRUE : FALSE;
+        p_stats->time = now;
+        if ( p_stats->active == TRUE )
+        {
+            p_stats->raised++;
+        }
+        else
+        {
+            p_stats->cleared++;
+        }
+
+        adcAlarmArm( p_adc, k, alarm );
+        ( void ) dmSet( adc_alarm_config_defs[ alarm ].signal, ( S32 ) p_stats->active );
+    }
+
+    TRC_ISR_EXIT( eTRC_ISR_ADC );
+}
+
+#pragma CODE_STATE(adc1MagnitudeInterrupt, 32)
+#pragma INTERRUPT(adc1MagnitudeInterrupt, IRQ)
+void adc1MagnitudeInterrupt( void )
+{
+    adcMagnitude( eADC_UNIT_1, adcREG1 );
+}
+
+#pragma CODE_STATE(adc2MagnitudeInterrupt, 32)
+#pragma INTERRUPT(adc2MagnitudeInterrupt, IRQ)
+void adc2MagnitudeInterrupt( void )
+{
+    adcMagnitude( eADC_UNIT_2, adcREG2 );
+}
+
+/* Programs one auto-initialising DMA channel per enabled stream: a frame of
+ * one 32 bit result per request, from the group FIFO into 2 * block_results
+ * words. HBC and BTC mark the two halves.
+ */
+static void adcDmaInit( void )
+{
+    U32 i;
+    BOOLEAN any = FALSE;
+    g_dmaCTRL packet;
+    adcBASE_t * p_adc[ eADC_UNIT_MAX ] = { adcREG1, adcREG2 };
+    const S_ADC_DMA_CONFIG *p_cfg;
+
+    memset( adc_dma_stream_of_group, ADC_DMA_NONE, sizeof( adc_dma_stream_of_group ) );
+    memset( adc_dma_stream_of_channel, ADC_DMA_NONE, sizeof( adc_dma_stream_of_channel ) );
+    memset( adc_dma_state, 0, sizeof( adc_dma_state ) );
+
+    for ( i = 0U; i < ADC_DMA_STREAMS; i++ )
+    {
+        p_cfg = &adc_dma_config_defs[ i ];
+        if ( ( p_cfg->enabled == FALSE ) || ( p_cfg->block_results == 0u ) ||
+             ( p_cfg->block_results > ADC_DMA_BLOCK_MAX ) || ( ( p_cfg->block_results % ADC_DMA_BLOCK_ALIGN ) != 0u ) )
+        {
+            continue;
+        }
+
+        adc_dma_stream_of_group[ p_cfg->unit ][ p_cfg->group ] = ( U8 ) i;
+        adc_dma_stream_of_channel[ p_cfg->dma_channel ] = ( U8 ) i;
+
+        packet.SADD = ( U32 ) ( uintptr_t ) &p_adc[ p_cfg->unit ]->GxBUF[ p_cfg->group ].BUF0;
+        packet.DADD = ( U32 ) ( uintptr_t ) &adc_dma_buffer[ i ][ 0 ];
+        packet.CHCTRL = 0U;
+        packet.FRCNT = 2U * p_cfg->block_results;
+        packet.ELCNT = 1U;
+        packet.ELDOFFSET = 0U;
+        packet.ELSOFFSET = 0U;
+        packet.FRDOFFSET = 0U;
+        packet.FRSOFFSET = 0U;
+        packet.PORTASGN = PORTB_READ_PORTB_WRITE;
+        packet.RDSIZE = ACCESS_32_BIT;
+        packet.WRSIZE = ACCESS_32_BIT;
+        packet.TTYPE = FRAME_TRANSFER;
+        packet.ADDMODERD = ADDR_FIXED;
+        packet.ADDMODEWR = ADDR_INC1;
+        packet.AUTOINIT = AUTOINIT_ON;
+
+        dmaReqAssign( ( dmaChannel_t ) p_cfg->dma_channel, ( dmaRequest_t ) p_cfg->dma_request );
+        dmaSetCtrlPacket( ( dmaChannel_t ) p_cfg->dma_channel, packet );
+        dmaEnableInterrupt( ( dmaChannel_t ) p_cfg->dma_channel, HBC, DMA_INTA );
+        dmaEnableInterrupt( ( dmaChannel_t ) p_cfg->dma_channel, BTC, DMA_INTA );
+        dmaSetChEnable( ( dmaChannel_t ) p_cfg->dma_channel, DMA_HW );
+        any = TRUE;
+    }
+
+    if ( any == TRUE )
+    {
+        vimChannelMap( ADC_DMA_VIM_HBCA, ADC_DMA_VIM_HBCA, &dmaHBCAInterrupt );
+        vimChannelMap( ADC_DMA_VIM_BTCA, ADC_DMA_VIM_BTCA, &dmaBTCAInterrupt );
+        vimEnableInterrupt( ADC_DMA_VIM_HBCA, SYS_IRQ );
+        vimEnableInterrupt( ADC_DMA_VIM_BTCA, SYS_IRQ );
+        dmaEnable();
+    }
+}
+
+/* Hands a completed block to the channels, the block handler and the data
+ * manager. half 0 is signalled by HBC, half 1 by BTC.
+ */
+static void adcDmaBlock( U32 channel, U32 half )
+{
+    U32 i;
+    U32 stream;
+    U32 lost;
+    U32 now = ADC_TIMESTAMP();
+    BOOLEAN stored = FALSE;
+    BOOLEAN next_pending;
+    const U32 *p_block;
+    const S_ADC_DMA_CONFIG *p_cfg;
+    S_ADC_GROUP_STATS *p_stats;
+    adcBASE_t *p_adc;
+
+    if ( ( channel >= 32U ) || ( adc_dma_stream_of_channel[ channel ] == ADC_DMA_NONE ) )
+    {
+        return;
+    }
+
+    stream = adc_dma_stream_of_channel[ channel ];
+    p_cfg = &adc_dma_config_defs[ stream ];
+    p_stats = &adc_stats[ p_cfg->unit ][ p_cfg->group ];
+    p_adc = ( p_cfg->unit == eADC_UNIT_1 ) ? adcREG1 : adcREG2;
+
+    /* The other half complete as well: the DMA has wrapped into this one */
+    next_pending = ( ( ( ( half == 0U ) ? dmaREG->BTCFLAG : dmaREG->HBCFLAG ) & ( ( U32 ) 1U << channel ) ) != 0U ) ? TRUE : FALSE;
+
+    lost = adcPingPongTake( &adc_dma_state[ stream ], half, next_pending );
+    p_stats->block_overruns += lost;
+
+    if ( ( p_adc->GxINTFLG[ p_cfg->group ] & ADC_INTFLG_OVERRUN ) != 0U )
+    {
+        /* The DMA fell behind the conversions */
+        p_stats->overruns++;
+        p_adc->GxFIFORESETCR[ p_cfg->group ] = 1U;
+    }
+
+    if ( lost != 0U )
+    {
+        return;
+    }
+
+    p_block = &adc_dma_buffer[ stream ][ half * p_cfg->block_results ];
+    _dCacheInvalidateRange_( p_block, p_cfg->block_results * sizeof( U32 ) );
+
+    p_stats->blocks++;
+    p_stats->samples += p_cfg->block_results;
+
+    for ( i = 0U; i < p_cfg->block_results; i++ )
+    {
+        if ( adcStoreResult( p_cfg->unit, p_stats, p_block[ i ], now ) == TRUE )
+        {
+            stored = TRUE;
+        }
+    }
+
+    if ( adc_block_handler != NULL )
+    {
+        adc_block_handler( p_cfg->unit, p_cfg->group, p_block, p_cfg->block_results );
+    }
+
+    if ( stored == TRUE )
+    {
+        dmAnalogueInputsPublish( &adc_inputs );
+    }
+}
+
+/* Ping-pong bookkeeping, no hardware access. Returns the number of blocks
+ * lost: a half that was never signalled, or this half if the DMA has
+ * completed the other one too and is refilling it already.
+ */
+static U32 adcPingPongTake( S_ADC_DMA_STATE *p_state, U32 half, BOOLEAN next_pending )
+{
+    U32 lost = 0U;
+
+    if ( half != p_state->next_half )
+    {
+        lost++;
+    }
+    p_state->next_half = half ^ 1U;
+
+    if ( next_pending == TRUE )
+    {
+        lost++;
+    }
+
+    return lost;
+}
+
+/** @fn void dmaHBCAInterrupt(void), void dmaBTCAInterrupt(void)
+ *   @brief  DMA group A half block / block complete, reading the offset clears the flag
+ */
+#pragma CODE_STATE(dmaHBCAInterrupt, 32)
+#pragma INTERRUPT(dmaHBCAInterrupt, IRQ)
+void dmaHBCAInterrupt( void )
+{
+    U32 offset = dmaREG->HBCAOFFSET;
+
+    TRC_ISR_ENTER( eTRC_ISR_ADC );
+    if ( offset != 0U )
+    {
+        adcDmaBlock( offset - 1U, 0U );
+    }
+    TRC_ISR_EXIT( eTRC_ISR_ADC );
+}
+
+#pragma CODE_STATE(dmaBTCAInterrupt, 32)
+#pragma INTERRUPT(dmaBTCAInterrupt, IRQ)
+void dmaBTCAInterrupt( void )
+{
+    U32 offset = dmaREG->BTCAOFFSET;
+
+    TRC_ISR_ENTER( eTRC_ISR_ADC );
+    if ( offset != 0U )
+    {
+        adcDmaBlock( offset - 1U, 1U );
+    }
+    TRC_ISR_EXIT( eTRC_ISR_ADC );
+}
+
+/** @fn void adc1Group0Interrupt(void) .. adc2Group2Interrupt(void)
+ *   @brief  End of conversion interrupts of the ADC groups, see adcNotification
+ */
+#pragma CODE_STATE(adc1Group0Interrupt, 32)
+#pragma INTERRUPT(adc1Group0Interrupt, IRQ)
+void adc1Group0Interrupt( void )
+{
+    adcNotification( adcREG1, adcGROUP0 );
+}
+
+#pragma CODE_STATE(adc1Group1Interrupt, 32)
+#pragma INTERRUPT(adc1Group1Interrupt, IRQ)
+void adc1Group1Interrupt( void )
+{
+    adcNotification( adcREG1, adcGROUP1 );
+}
+
+#pragma CODE_STATE(adc1Group2Interrupt, 32)
+#pragma INTERRUPT(adc1Group2Interrupt, IRQ)
+void adc1Group2Interrupt( void )
+{
+    adcNotification( adcREG1, adcGROUP2 );
+}
+
+#pragma CODE_STATE(adc2Group0Interrupt, 32)
+#pragma INTERRUPT(adc2Group0Interrupt, IRQ)
+void adc2Group0Interrupt( void )
+{
+    adcNotification( adcREG2, adcGROUP0 );
+}
+
+#pragma CODE_STATE(adc2Group1Interrupt, 32)
+#pragma INTERRUPT(adc2Group1Interrupt, IRQ)
+void adc2Group1Interrupt( void )
+{
+    adcNotification( adcREG2, adcGROUP1 );
+}
+
+#pragma CODE_STATE(adc2Group2Interrupt, 32)
+#pragma INTERRUPT(adc2Group2Interrupt, IRQ)
+void adc2Group2Interrupt( void )
+{
+    adcNotification( adcREG2, adcGROUP2 );
+}
+
 /*----------------------------------------------------------------------------\
 |   End of fw_adc.c module                                                    |
 \----------------------------------------------------------------------------*/
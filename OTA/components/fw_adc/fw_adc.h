@@ -30,6 +30,21 @@
 
 #include "fw_types.h"
 
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+#define ADC_HW_CHANNELS             32u                 /* AD1IN[31:0], AD2IN[24:0] */
+#define ADC_CHANNEL_NONE            0xFFu               /* Hardware channel not in adc_channel_config_defs */
+
+#define ADC_DMA_BLOCK_MAX           256u                /* Results per DMA block */
+#define ADC_DMA_BLOCK_ALIGN         8u                  /* Results, one 32 byte cache line */
+
+#define ADC_MAG_COMPARATORS         3u                  /* Magnitude threshold comparators per unit */
+
+#define ADC_DECIM_ORDER_MAX         3u                  /* eADC_FILTER_CIC3 */
+#define ADC_DECIM_GROWTH_MAX        20u                 /* order * decimation_log2, 12 bit results in 32 bit sums */
+
 /*----------------------------------------------------------------------------\
 |   Public Type Definitions                                                   |
 \----------------------------------------------------------------------------*/
@@ -71,6 +86,23 @@ typedef enum
     eADC_GROUP_MAX,
 } E_ADC_GROUP;
 
+/* Start of a group conversion: adcTrigger() or an edge of a hardware source */
+typedef enum
+{
+    eADC_TRIGGER_SOFTWARE = 0,                      /* Not for the event group, it is always hardware triggered */
+    eADC_TRIGGER_FALLING,
+    eADC_TRIGGER_RISING,
+} E_ADC_TRIGGER;
+
+/* Decimation of a channel, the value is the number of cascaded integrator / comb stages */
+typedef enum
+{
+    eADC_FILTER_NONE = 0,                           /* Every result is published */
+    eADC_FILTER_BOXCAR,                             /* Sum of 2^decimation_log2 results */
+    eADC_FILTER_CIC2,
+    eADC_FILTER_CIC3,
+} E_ADC_FILTER;
+
 typedef struct
 {
     E_ADC_GROUP                 group;
@@ -79,6 +111,8 @@ typedef struct
     BOOLEAN                     continuous_conv;
     BOOLEAN                     sampling_cap_discharge;
     BOOLEAN                     conv_end_interrupt_en;
+    E_ADC_TRIGGER               trigger;
+    U32                         trigger_source;     /* adc1HwTriggerSource / adc2HwTriggerSource, hardware triggers only */
 } E_ADC_GROUP_CONFIG;
 
 typedef struct
@@ -97,9 +131,73 @@ typedef struct
     E_ADC_UNIT                  unit;
     E_ADC_GROUP                 group;
     U8                          ch;
+    E_ADC_FILTER                filter;
+    U8                          decimation_log2;    /* One value per 2^decimation_log2 results */
+    U8                          extra_bits;         /* Published value is 12 + extra_bits wide */
     BOOLEAN                     enabled;
 } S_ADC_CHANNEL_CONFIG;
 
+/* Group whose results are moved by the DMA instead of the end of conversion
+ * interrupt. The channel fills two blocks in turn ( ping-pong ) and the CPU is
+ * interrupted once per block.
+ */
+typedef struct
+{
+    E_ADC_UNIT                  unit;
+    E_ADC_GROUP                 group;
+    U8                          dma_channel;        /* dmaChannel_t */
+    U8                          dma_request;        /* dmaRequest_t of the group, see the device datasheet */
+    U16                         block_results;      /* Multiple of ADC_DMA_BLOCK_ALIGN, at most ADC_DMA_BLOCK_MAX */
+    BOOLEAN                     enabled;
+} S_ADC_DMA_CONFIG;
+
+/* Called from the DMA block interrupt with the raw result words of a block:
+ * value in bits 11:0, channel id in bits 20:16
+ */
+typedef void ( *ADC_BLOCK_HANDLER )( E_ADC_UNIT unit, E_ADC_GROUP group, const U32 *results, U32 count );
+
+typedef enum
+{
+    eADC_ALARM_HIGH = 0,                            /* Raised by a result >= threshold */
+    eADC_ALARM_LOW,                                 /* Raised by a result < threshold */
+} E_ADC_ALARM_KIND;
+
+/* Alarm on one channel, served by a magnitude threshold comparator of its
+ * unit. The comparators see the raw 12 bit results, before any decimation.
+ */
+typedef struct
+{
+    E_ADC_ID                    id;
+    E_ADC_ALARM_KIND            kind;
+    U16                         threshold;          /* Raw counts */
+    U16                         hysteresis;         /* Raw counts back inside the threshold to clear */
+    U16                         signal;             /* E_DM_SIGNAL_ID, set to 1 / 0 on raise / clear */
+    BOOLEAN                     enabled;
+} S_ADC_ALARM_CONFIG;
+
+typedef struct
+{
+    U32                         raised;
+    U32                         cleared;
+    U32                         time;               /* RTI counter 0 at the last raise / clear */
+    U32                         last_latency;       /* RTI counter 0 ticks from the interrupt to adcAlarmAck() */
+    U32                         max_latency;
+    BOOLEAN                     active;
+} S_ADC_ALARM_STATS;
+
+/* Acquisition counters of one group, every loss is counted where it happens */
+typedef struct
+{
+    U32                         conversions;        /* End of conversion interrupts */
+    U32                         samples;            /* Results drained from the FIFO */
+    U32                         missing;            /* Expected results that were not in the FIFO */
+    U32                         overruns;           /* FIFO overruns, the FIFO was reset */
+    U32                         unknown;            /* Results of unconfigured channels */
+    U32                         trigger_busy;       /* Triggers skipped, previous conversion still running */
+    U32                         blocks;             /* DMA blocks handled */
+    U32                         block_overruns;     /* DMA blocks overwritten before they were handled */
+} S_ADC_GROUP_STATS;
+
 /*----------------------------------------------------------------------------\
 |   Public Constant Declarations                                              |
 \----------------------------------------------------------------------------*/
@@ -110,9 +208,13 @@ typedef struct
 
 void adc_init( void );
 void adc_start_conversion( adcBASE_t *adc, uint32 group );
-void adc_read_channels( void );
+void adcTrigger( void );
 const S_ADC_CHANNEL_CONFIG * const adcGetChannelConfig( void );
 const S_ADC_UNIT_CONFIG * const adcGetUnitConfig( void );
+const S_ADC_GROUP_STATS * adcGetStats( E_ADC_UNIT unit, E_ADC_GROUP group );
+void adcSetBlockHandler( ADC_BLOCK_HANDLER handler );
+BOOLEAN adcAlarmAck( U32 alarm );
+const S_ADC_ALARM_STATS * adcGetAlarmStats( U32 alarm );
 
 /*----------------------------------------------------------------------------\
 |   End of fw_adc.h header file                                               |
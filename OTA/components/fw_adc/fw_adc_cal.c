@@ -0,0 +1,247 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_adc_cal.c Module File.                                  |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   ADC channel calibration.                                                  |
+|                                                                             |
+|   Records are turned into a RAM form once, with the slope of every          |
+|   segment precomputed, so a conversion costs one multiply for the gain      |
+|   and one for the segment. Each channel has two RAM copies: adcCalSet()     |
+|   fills the one not in use and then switches the channel over, so the       |
+|   acquisition interrupts never see a half written record.                   |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Compiler Controls                                                         |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "fw_adc_cal.h"
+#include "fw_atomic.h"
+#include "fw_crc.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    S32                         offset;
+    S32                         gain;               /* Q16 */
+    U32                         points;
+    S32                         x[ ADC_CAL_POINTS_MAX ];
+    S32                         y[ ADC_CAL_POINTS_MAX ];
+    S32                         slope[ ADC_CAL_POINTS_MAX - 1u ];   /* Q16, of segment x[ k ] .. x[ k + 1 ] */
+} S_ADC_CAL_STATE;
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+/* Built in records, used when the calibration sector holds no valid table */
+static const S_ADC_CAL_RECORD adc_cal_defaults[ eADC_CHANNEL_MAX ] =
+{
+    [ eADC1_9 ] =                                   /* HDK LDR, 13 bit to mV */
+    {
+        .offset = 0,
+        .gain = 26408,                              /* 3300 / 8190 in Q16 */
+        .points = 0u,
+    },
+};
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+/* The calibration sector, defined by the linker command file at the start
+ * of ADCCAL. The image holds only the ECC of its erased words, so it reads
+ * back as all ones without an ECC error until the production tool programs
+ * the table, and all ones never pass the checks. Volatile, so every read
+ * goes to the flash rather than to what the compiler assumes.
+ */
+extern volatile const S_ADC_CAL_TABLE adc_cal_flash;
+
+static S_ADC_CAL_STATE adc_cal_state[ eADC_CHANNEL_MAX ][ 2u ];
+static volatile U32 adc_cal_active[ eADC_CHANNEL_MAX ];
+
+/*----------------------------------------------------------------------------\
+|   Private Function Declarations                                             |
+\----------------------------------------------------------------------------*/
+
+static BOOLEAN adcCalLoad( S_ADC_CAL_STATE *p_state, const S_ADC_CAL_RECORD *p_record );
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : adcCalInit                                          |
+|                                                                             |
+|   Description         : Loads every channel from the calibration sector if  |
+|                         it holds a valid table, else from the defaults. A   |
+|                         bad record in a valid table falls back to the       |
+|                         default of its channel.                             |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : TRUE if the calibration sector was used.            |
+|                                                                             |
+|   Warnings            : Before the ADC interrupts are enabled.              |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN adcCalInit( void )
+{
+    U32 i;
+    BOOLEAN from_flash;
+
+    from_flash = ( ( adc_cal_flash.magic == ADC_CAL_MAGIC ) &&
+                   ( adc_cal_flash.version == ADC_CAL_VERSION ) &&
+                   ( adc_cal_flash.channels == ( U32 ) eADC_CHANNEL_MAX ) &&
+                   ( adc_cal_flash.crc == crc32( ( const void * ) &adc_cal_flash, ( uint32 ) offsetof( S_ADC_CAL_TABLE, crc ) ) ) ) ? TRUE : FALSE;
+
+    for ( i = 0u; i < eADC_CHANNEL_MAX; i++ )
+    {
+        adc_cal_active[ i ] = 0u;
+        if ( ( from_flash == FALSE ) || ( adcCalLoad( &adc_cal_state[ i ][ 0 ], ( const S_ADC_CAL_RECORD * ) &adc_cal_flash.record[ i ] ) == FALSE ) )
+        {
+            ( void ) adcCalLoad( &adc_cal_state[ i ][ 0 ], &adc_cal_defaults[ i ] );
+        }
+    }
+
+    return from_flash;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : adcCalSet                                           |
+|                                                                             |
+|   Description         : Replaces the calibration of a channel at run time,  |
+|                         the next conversion of the channel uses it.         |
+|                                                                             |
+|   Inputs              : Channel.                                            |
+|                         Record.                                             |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : FALSE if the record is invalid, the channel keeps   |
+|                         its calibration.                                    |
+|                                                                             |
+|   Warnings            : One caller at a time, and not twice for the same    |
+|                         channel within one of its conversions.              |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN adcCalSet( E_ADC_ID id, const S_ADC_CAL_RECORD *p_record )
+{
+    U32 spare;
+
+    if ( ( U32 ) id >= ( U32 ) eADC_CHANNEL_MAX )
+    {
+        return FALSE;
+    }
+
+    spare = adc_cal_active[ id ] ^ 1u;
+    if ( adcCalLoad( &adc_cal_state[ id ][ spare ], p_record ) == FALSE )
+    {
+        return FALSE;
+    }
+
+    ATOMIC_DMB();                           /* Record complete before the switch */
+    adc_cal_active[ id ] = spare;
+
+    return TRUE;
+}
+
+/* Engineering value of a published ADC value, acquisition path */
+S32 adcCalApply( U32 id, S32 value )
+{
+    U32 k;
+    const S_ADC_CAL_STATE *p_state = &adc_cal_state[ id ][ adc_cal_active[ id ] ];
+
+    value = ( S32 ) ( ( ( S64 ) ( value + p_state->offset ) * p_state->gain ) >> 16 );
+
+    if ( p_state->points == 0u )
+    {
+        return value;
+    }
+
+    if ( value <= p_state->x[ 0 ] )
+    {
+        return p_state->y[ 0 ];
+    }
+
+    for ( k = 0u; k < ( p_state->points - 1u ); k++ )
+    {
+        if ( value <= p_state->x[ k + 1u ] )
+        {
+            return p_state->y[ k ] + ( S32 ) ( ( ( S64 ) ( value - p_state->x[ k ] ) * p_state->slope[ k ] ) >> 16 );
+        }
+    }
+
+    return p_state->y[ p_state->points - 1u ];
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+/* Checks a record and stores it with its segment slopes */
+static BOOLEAN adcCalLoad( S_ADC_CAL_STATE *p_state, const S_ADC_CAL_RECORD *p_record )
+{
+    U32 k;
+
+    if ( ( p_record->points == 1u ) || ( p_record->points > ADC_CAL_POINTS_MAX ) )
+    {
+        return FALSE;
+    }
+
+    for ( k = 1u; k < p_record->points; k++ )
+    {
+        if ( p_record->x[ k ] <= p_record->x[ k - 1u ] )
+        {
+            return FALSE;
+        }
+    }
+
+    p_state->offset = p_record->offset;
+    p_state->gain = p_record->gain;
+    p_state->points = p_record->points;
+    memcpy( p_state->x, p_record->x, sizeof( p_state->x ) );
+    memcpy( p_state->y, p_record->y, sizeof( p_state->y ) );
+
+    for ( k = 1u; k < p_record->points; k++ )
+    {
+        p_state->slope[ k - 1u ] = ( S32 ) ( ( ( S64 ) ( p_record->y[ k ] - p_record->y[ k - 1u ] ) * ADC_CAL_GAIN_ONE ) /
+                                             ( p_record->x[ k ] - p_record->x[ k - 1u ] ) );
+    }
+
+    return TRUE;
+}
+
+/*----------------------------------------------------------------------------\
+|   End of fw_adc_cal.c module                                                |
+\----------------------------------------------------------------------------*/
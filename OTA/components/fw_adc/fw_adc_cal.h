@@ -0,0 +1,89 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_adc_cal.h Header File.                                  |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   ADC channel calibration.                                                  |
+|                                                                             |
+|   Every channel has a record: offset and gain on the published value,       |
+|   then an optional piecewise-linear curve for non-linear sensors. The       |
+|   result is the engineering value, a fixed-point integer in whatever        |
+|   unit and resolution the record is made for ( mV, 0.1 degC, lux ... ).     |
+|                                                                             |
+|   The records come from the calibration sector ( ADCCAL, see the linker     |
+|   command file ) when it holds a valid S_ADC_CAL_TABLE, otherwise from      |
+|   the defaults built into fw_adc_cal.c. The sector is written by the        |
+|   production tool, adcCalSet() replaces a record at run time.               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef fw_adc_cal_H
+#define fw_adc_cal_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "fw_types.h"
+#include "fw_adc.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+#define ADC_CAL_POINTS_MAX          8u
+#define ADC_CAL_MAGIC               0x4143414CUL        /* "ACAL" */
+#define ADC_CAL_VERSION             1u
+#define ADC_CAL_GAIN_ONE            65536L              /* Q16 */
+
+/*----------------------------------------------------------------------------\
+|   Public Type Definitions                                                   |
+\----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    S32                         offset;             /* Added to the published value first */
+    S32                         gain;               /* Q16 */
+    U32                         points;             /* 0: linear only, else 2 .. ADC_CAL_POINTS_MAX */
+    S32                         x[ ADC_CAL_POINTS_MAX ];    /* Strictly ascending, after offset and gain */
+    S32                         y[ ADC_CAL_POINTS_MAX ];    /* Engineering value at x, clamped outside */
+} S_ADC_CAL_RECORD;
+
+/*
+ * Layout of the calibration sector, big endian. The CRC ( fw_crc ) covers
+ * everything before it.
+ */
+typedef struct
+{
+    U32                         magic;              /* ADC_CAL_MAGIC */
+    U32                         version;            /* ADC_CAL_VERSION */
+    U32                         channels;           /* eADC_CHANNEL_MAX */
+    S_ADC_CAL_RECORD            record[ eADC_CHANNEL_MAX ];
+    U32                         crc;
+} S_ADC_CAL_TABLE;
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN adcCalInit( void );
+BOOLEAN adcCalSet( E_ADC_ID id, const S_ADC_CAL_RECORD *p_record );
+S32 adcCalApply( U32 id, S32 value );
+
+/*----------------------------------------------------------------------------\
+|   End of fw_adc_cal.h header file                                           |
+\----------------------------------------------------------------------------*/
+
+#endif  /* fw_adc_cal_H */
@@ -0,0 +1,212 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_adc_tone.c Module File.                                 |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   ADC tone and level detectors.                                             |
+|                                                                             |
+|   Runs as the ADC block handler, in the DMA block interrupt. Each result    |
+|   of a followed channel costs one Goertzel step per tone plus a sum and a   |
+|   sum of squares; the square roots are taken once per evaluation.           |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Compiler Controls                                                         |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "data_manager.h"
+#include "fw_adc_tone.h"
+#include "fw_dsp.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    S_DSP_GOERTZEL              tone[ ADC_TONES_MAX ];
+    S32                         sum;
+    U64                         sum_sq;
+    U32                         count;
+    BOOLEAN                     running;            /* Configuration checked */
+} S_ADC_TONE_STATE;
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define ADC_TONE_MID                2048L               /* Mid scale, keeps the resonators centred */
+
+#define ADC_TONE_VALUE( buf )       ( ( buf ) & 0x00000FFFU )               /* 12 bit mode */
+#define ADC_TONE_CHID( buf )        ( ( ( buf ) >> 16U ) & 0x0000001FU )
+
+/* Detectors, the channel must be in a group served by the DMA */
+static const S_ADC_TONE_CONFIG adc_tone_config_defs[] =
+{
+    {
+        .id = eADC1_9,                              /* HDK LDR: mains flicker of the room lighting */
+        .sample_hz = 1000u,                         /* RTI compare 0 trigger, see fw_adc.c */
+        .length = 200u,                             /* 5 Hz bins, levels every 200 ms */
+        .tones = 2u,
+        .tone_hz = { 100u, 120u },
+        .tone_signal = { ( U16 ) eDM_SIG_ADC1_9_100HZ, ( U16 ) eDM_SIG_ADC1_9_120HZ },
+        .rms_signal = ( U16 ) eDM_SIG_ADC1_9_RMS,
+        .enabled = TRUE,
+    },
+};
+
+#define ADC_TONE_DETECTORS          ( sizeof( adc_tone_config_defs ) / sizeof( adc_tone_config_defs[ 0 ] ) )
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static S_ADC_TONE_STATE adc_tone_state[ ADC_TONE_DETECTORS ];
+
+/*----------------------------------------------------------------------------\
+|   Private Function Declarations                                             |
+\----------------------------------------------------------------------------*/
+
+static void adcToneBlock( E_ADC_UNIT unit, E_ADC_GROUP group, const U32 *results, U32 count );
+static void adcToneEvaluate( const S_ADC_TONE_CONFIG *p_cfg, S_ADC_TONE_STATE *p_state );
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : adcToneInit                                         |
+|                                                                             |
+|   Description         : Prepares the resonators of every valid detector     |
+|                         and installs the detectors as the ADC block         |
+|                         handler.                                            |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Before adc_init(), which starts the DMA.            |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void adcToneInit( void )
+{
+    U32 i;
+    U32 k;
+    const S_ADC_TONE_CONFIG *p_cfg;
+
+    memset( adc_tone_state, 0, sizeof( adc_tone_state ) );
+
+    for ( i = 0u; i < ADC_TONE_DETECTORS; i++ )
+    {
+        p_cfg = &adc_tone_config_defs[ i ];
+        if ( ( p_cfg->enabled == FALSE ) || ( p_cfg->tones > ADC_TONES_MAX ) || ( p_cfg->sample_hz == 0u ) ||
+             ( p_cfg->length == 0u ) || ( p_cfg->length > ADC_TONE_LENGTH_MAX ) )
+        {
+            continue;
+        }
+
+        for ( k = 0u; k < p_cfg->tones; k++ )
+        {
+            dspGoertzelInit( &adc_tone_state[ i ].tone[ k ], dspGoertzelCoef( p_cfg->tone_hz[ k ], p_cfg->sample_hz ) );
+        }
+        adc_tone_state[ i ].running = TRUE;
+    }
+
+    adcSetBlockHandler( &adcToneBlock );
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+/* Feeds the results of every followed channel in the block to its detector */
+static void adcToneBlock( E_ADC_UNIT unit, E_ADC_GROUP group, const U32 *results, U32 count )
+{
+    U32 i;
+    U32 n;
+    U32 k;
+    S32 x;
+    const S_ADC_TONE_CONFIG *p_cfg;
+    const S_ADC_CHANNEL_CONFIG *p_ch;
+    S_ADC_TONE_STATE *p_state;
+    const S_ADC_CHANNEL_CONFIG * const p_adc_ch = adcGetChannelConfig();
+
+    for ( i = 0u; i < ADC_TONE_DETECTORS; i++ )
+    {
+        p_cfg = &adc_tone_config_defs[ i ];
+        p_state = &adc_tone_state[ i ];
+        p_ch = &p_adc_ch[ p_cfg->id ];
+        if ( ( p_state->running == FALSE ) || ( p_ch->unit != unit ) || ( p_ch->group != group ) )
+        {
+            continue;
+        }
+
+        for ( n = 0u; n < count; n++ )
+        {
+            if ( ADC_TONE_CHID( results[ n ] ) != p_ch->ch )
+            {
+                continue;
+            }
+
+            x = ( S32 ) ADC_TONE_VALUE( results[ n ] ) - ADC_TONE_MID;
+            for ( k = 0u; k < p_cfg->tones; k++ )
+            {
+                dspGoertzelStep( &p_state->tone[ k ], x );
+            }
+            p_state->sum += x;
+            p_state->sum_sq += ( U64 ) ( x * x );
+
+            if ( ++p_state->count == p_cfg->length )
+            {
+                adcToneEvaluate( p_cfg, p_state );
+            }
+        }
+    }
+}
+
+/* Publishes the levels of one evaluation and starts the next. The RMS is
+ * taken around the block mean: sqrt( n * sum_sq - sum^2 ) / n.
+ */
+static void adcToneEvaluate( const S_ADC_TONE_CONFIG *p_cfg, S_ADC_TONE_STATE *p_state )
+{
+    U32 k;
+    U64 n = p_state->count;
+    U64 spread = ( n * p_state->sum_sq ) - ( U64 ) ( ( S64 ) p_state->sum * p_state->sum );
+
+    for ( k = 0u; k < p_cfg->tones; k++ )
+    {
+        ( void ) dmSet( p_cfg->tone_signal[ k ], ( S32 ) dspGoertzelAmplitude( &p_state->tone[ k ], p_state->count ) );
+    }
+    ( void ) dmSet( p_cfg->rms_signal, ( S32 ) ( dspSqrt64( spread ) / p_state->count ) );
+
+    p_state->sum = 0;
+    p_state->sum_sq = 0u;
+    p_state->count = 0u;
+}
+
+/*----------------------------------------------------------------------------\
+|   End of fw_adc_tone.c module                                               |
+\----------------------------------------------------------------------------*/
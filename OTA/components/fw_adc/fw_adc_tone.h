@@ -0,0 +1,71 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_adc_tone.h Header File.                                 |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   ADC tone and level detectors.                                             |
+|                                                                             |
+|   A detector follows one channel of a DMA served group ( see                |
+|   adc_dma_config_defs ) and, every length results, publishes to the Data    |
+|   Manager the amplitude of each of its tones ( Goertzel ) and the RMS of    |
+|   the channel around its mean, both in raw counts. Only the levels leave    |
+|   the acquisition path, never the samples.                                  |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef fw_adc_tone_H
+#define fw_adc_tone_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "fw_types.h"
+#include "fw_adc.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+#define ADC_TONES_MAX               4u                  /* Tones per detector */
+#define ADC_TONE_LENGTH_MAX         4096u               /* Results per evaluation, DSP_GOERTZEL_INPUT_MAX */
+
+/*----------------------------------------------------------------------------\
+|   Public Type Definitions                                                   |
+\----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    E_ADC_ID                    id;
+    U32                         sample_hz;          /* Conversion rate of the channel's group */
+    U16                         length;             /* Results per evaluation, bins are sample_hz / length wide */
+    U8                          tones;
+    U32                         tone_hz[ ADC_TONES_MAX ];
+    U16                         tone_signal[ ADC_TONES_MAX ];   /* E_DM_SIGNAL_ID of each amplitude */
+    U16                         rms_signal;         /* E_DM_SIGNAL_ID */
+    BOOLEAN                     enabled;
+} S_ADC_TONE_CONFIG;
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+void adcToneInit( void );
+
+/*----------------------------------------------------------------------------\
+|   End of fw_adc_tone.h header file                                          |
+\----------------------------------------------------------------------------*/
+
+#endif  /* fw_adc_tone_H */
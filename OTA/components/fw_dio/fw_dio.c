@@ -15,7 +15,12 @@
 |                                                                             |
 |-----------------------------------------------------------------------------|
 |                                                                             |
-|   <Module Description>                                                      |
+|   Digital I/O, GIO, N2HET, DMM and MIBSPI pins behind one pin ID space.     |
+|                                                                             |
+|   Init walks the pin tables once, resolves every enabled pin to its port    |
+|   registers and bit, and composes per port masks, so each configuration     |
+|   register of a port is written once whatever the number of its pins.       |
+|   Disabled pins resolve to an empty mask and are never written.             |
 |                                                                             |
 \----------------------------------------------------------------------------*/
 
@@ -27,20 +32,91 @@
 |   Header Files                                                              |
 \----------------------------------------------------------------------------*/
 
-#include "HL_reg_gio.h"
+#include <string.h>
 
+#include "HL_reg_gio.h"
+#include "HL_reg_het.h"
+#include "HL_reg_dmm.h"
+#include "HL_reg_mibspi.h"
+#include "HL_sys_core.h"
+#include "HL_sys_vim.h"
+
+#include "svc.h"
+#include "gatekeeper.h"
+#include "fw_atomic.h"
 #include "fw_dio.h"
+#include "fw_ring.h"
+#include "fw_trace.h"
+#include "fw_utils.h"
+#include "data_manager.h"
 
 /*----------------------------------------------------------------------------\
 |   Private Type Definitions                                                  |
 \----------------------------------------------------------------------------*/
 
+/* A port: the GIO compatible registers of its pins */
+typedef struct
+{
+    gioPORT_t *         regs;
+    volatile uint32 *   p_pc0;          /* Function select of a shared peripheral, bit clear is GIO; NULL if none */
+    BOOLEAN             privileged;     /* Written in a privileged mode only */
+} S_DIO_PORT_DEF;
+
+/* Debouncer of one port. Counters and limits are bit planes: plane k holds
+ * bit k of the count, or of the limit, of every pin of the port.
+ */
+typedef struct
+{
+    U32                 stable;                         /* Debounced levels */
+    U32                 count[ DIO_DEBOUNCE_BITS ];     /* Samples the raw level has differed from stable */
+    U32                 limit[ DIO_DEBOUNCE_BITS ];     /* Count at which stable follows */
+} S_DIO_DEBOUNCE;
+
+/* Edge interrupt state of one GIO interrupt bit */
+typedef struct
+{
+    U32                 holdoff;        /* RTI counter 0 ticks */
+    U32                 last;           /* Time of the last queued event */
+    U16                 lost;
+} S_DIO_EDGE_STATE;
+
+/* A pin resolved at init */
+typedef struct
+{
+    U32                 port;           /* E_DIO_PORT_ID */
+    U32                 mask;           /* Bit of the pin, 0 if the pin is disabled */
+} S_DIO_PIN;
+
 /*----------------------------------------------------------------------------\
 |   Private Constant Definitions                                              |
 \----------------------------------------------------------------------------*/
 
+#define DIO_CPSR_MODE_MASK          0x1Fu
+#define DIO_CPSR_MODE_USER          0x10u
+
+#define DIO_TIMESTAMP()             ( rtiREG1->CNT[ 0 ].FRCx )
+#define DIO_TICKS_PER_2US           75u                 /* RTI counter 0 at 37.5 MHz */
+
+#define DIO_EDGE_VIM                9U                  /* GIO high level interrupt */
+#define DIO_EDGE_PINS_PER_PORT      8u
+#define DIO_EDGE_NO_PIN             0xFFu
+#define DIO_EDGE_LOST_MAX           0xFFFFu
+
 static const S_DIO_INPUT_PIN_DEF dio_input_pin_defs[ eDIO_NUM_INPUT_PINS ] =
 {
+     {
+          .label = "AISG Data Dir Input",                       /* H16, DMM DATA14 */
+          .id = eDIO_INPUT_PIN_H16_AISG_DIR,
+          .port = eDIO_PORT_DMM,
+          .pin = 16u,
+          .pull = ePULL_NONE,
+          .pull_enable = FALSE,
+          .debounce = 2u,
+          .edge = eDIO_EDGE_NONE,                               /* DMM pin, no edge interrupt */
+          .edge_holdoff_us = 0u,
+          .value = 0,
+          .enabled = TRUE,
+     },
 };
 
 static const S_DIO_OUTPUT_PIN_DEF dio_output_pin_defs[ eDIO_NUM_OUTPUT_PINS ] =
@@ -50,7 +126,7 @@ static const S_DIO_OUTPUT_PIN_DEF dio_output_pin_defs[ eDIO_NUM_OUTPUT_PINS ] =
           .id = eDIO_OUTPUT_PIN_LED_6,
           .port = eDIO_PORTB,
           .pin = 6u,
-          .open_drain = TRUE,
+          .open_drain = FALSE,
           .value = 0,
           .enabled = TRUE,
      },
@@ -59,16 +135,120 @@ static const S_DIO_OUTPUT_PIN_DEF dio_output_pin_defs[ eDIO_NUM_OUTPUT_PINS ] =
           .id = eDIO_OUTPUT_PIN_LED_7,
           .port = eDIO_PORTB,
           .pin = 7u,
+          .open_drain = FALSE,
+          .value = 0,
+          .enabled = TRUE,
+     },
+     {
+          .label = "RS485REb",                                  /* A13 */
+          .id = eDIO_OUTPUT_PIN_A13_RS485_REB,
+          .port = eDIO_PORT_HET1,
+          .pin = 17u,
+          .open_drain = FALSE,
+          .value = 0,
+          .enabled = TRUE,
+     },
+     {
+          .label = "ADRF5019",                                  /* J17, positive supply */
+          .id = eDIO_OUTPUT_PIN_J17_VPOS_5019,
+          .port = eDIO_PORT_HET1,
+          .pin = 31u,
+          .open_drain = FALSE,
+          .value = 0,
+          .enabled = TRUE,
+     },
+     {
+          .label = "PowerSWDT",                                 /* N1 */
+          .id = eDIO_OUTPUT_PIN_N1_POW_SWDT,
+          .port = eDIO_PORT_HET1,
+          .pin = 15u,
+          .open_drain = FALSE,
+          .value = 0,
+          .enabled = TRUE,
+     },
+     {
+          .label = "FaultBypassSW",                             /* V6 */
+          .id = eDIO_OUTPUT_PIN_V6_FLT_BYPASS_SW,
+          .port = eDIO_PORT_HET1,
+          .pin = 5u,
+          .open_drain = FALSE,
+          .value = 0,
+          .enabled = TRUE,
+     },
+     {
+          .label = "LedLeftBottom",                             /* HDK LED on the J17 pin */
+          .id = eDIO_OUTPUT_PIN_LED_LEFT_BOTTOM,
+          .port = eDIO_PORT_HET1,
+          .pin = 31u,
           .open_drain = TRUE,
           .value = 0,
+          .enabled = FALSE,
+     },
+     {
+          .label = "RS485 DE",                                  /* H17, DMM DATA10 */
+          .id = eDIO_OUTPUT_PIN_H17_RS485_DE,
+          .port = eDIO_PORT_DMM,
+          .pin = 12u,
+          .open_drain = FALSE,
+          .value = 0,
+          .enabled = TRUE,
+     },
+     {
+          .label = "DemodEna",                                  /* W8, MIBSPI3 SIMO */
+          .id = eDIO_OUTPUT_PIN_W8_DEMOD_ENA,
+          .port = eDIO_PORT_MIBSPI3,
+          .pin = 10u,
+          .open_drain = FALSE,
+          .value = 0,
+          .enabled = TRUE,
+     },
+     {
+          .label = "GainActive2",                               /* V8, MIBSPI3 SOMI */
+          .id = eDIO_OUTPUT_PIN_V8_GAIN_ACTIVE_2,
+          .port = eDIO_PORT_MIBSPI3,
+          .pin = 11u,
+          .open_drain = FALSE,
+          .value = 0,
+          .enabled = TRUE,
+     },
+     {
+          .label = "GainActive1",                               /* W9, MIBSPI3 ENA */
+          .id = eDIO_OUTPUT_PIN_W9_GAIN_ACTIVE_1,
+          .port = eDIO_PORT_MIBSPI3,
+          .pin = 8u,
+          .open_drain = FALSE,
+          .value = 0,
           .enabled = TRUE,
      },
 };
 
+/* Ports, indexed by E_DIO_PORT_ID */
+static const S_DIO_PORT_DEF dio_port_defs[ eDIO_MAX_PORTS ] =
+{
+    [ eDIO_PORTA ] =        { .regs = gioPORTA,    .p_pc0 = NULL,               .privileged = FALSE },
+    [ eDIO_PORTB ] =        { .regs = gioPORTB,    .p_pc0 = NULL,               .privileged = FALSE },
+    [ eDIO_PORT_HET1 ] =    { .regs = hetPORT1,    .p_pc0 = NULL,               .privileged = FALSE },
+    [ eDIO_PORT_HET2 ] =    { .regs = hetPORT2,    .p_pc0 = NULL,               .privileged = FALSE },
+    [ eDIO_PORT_DMM ] =     { .regs = dmmPORT,     .p_pc0 = &dmmREG->PC0,       .privileged = TRUE },
+    [ eDIO_PORT_MIBSPI3 ] = { .regs = mibspiPORT3, .p_pc0 = &mibspiREG3->PC0,   .privileged = FALSE },
+};
+
 /*----------------------------------------------------------------------------\
 |   Private Data Declarations                                                 |
 \----------------------------------------------------------------------------*/
 
+static S_DIO_PIN dio_input_pins[ eDIO_NUM_INPUT_PINS ];
+static S_DIO_PIN dio_output_pins[ eDIO_NUM_OUTPUT_PINS ];
+static S_DIO_DEBOUNCE dio_debounce[ eDIO_MAX_PORTS ];
+
+static U8 dio_edge_pin[ DIO_EDGE_BITS ];                /* E_DIO_INPUT_PIN_ID of each GIO interrupt bit */
+static S_DIO_EDGE_STATE dio_edge_state[ DIO_EDGE_BITS ];
+static volatile U32 dio_edge_suppressed;                /* Interrupt bits turned off by their hold-off */
+static S_DIO_EDGE_EVENT dio_edge_buffer[ DIO_EDGE_QUEUE_LENGTH ];
+static S_RING dio_edge_ring;
+static DIO_EDGE_HANDLER dio_edge_handler = NULL;
+static S_DIO_EDGE_STATS dio_edge_stats;
+
 /*----------------------------------------------------------------------------\
 |   Public Constant Declarations                                              |
 \----------------------------------------------------------------------------*/
@@ -77,6 +257,12 @@ static const S_DIO_OUTPUT_PIN_DEF dio_output_pin_defs[ eDIO_NUM_OUTPUT_PINS ] =
 |   Private Function Declarations                                             |
 \----------------------------------------------------------------------------*/
 
+static U32 dioResolve( S_DIO_PIN *p_pin, BOOLEAN enabled, E_DIO_PORT_ID port, U8 pin );
+static void dioStore( U32 port, volatile uint32 *p_reg, U32 value );
+static U32 dioDebounce( S_DIO_DEBOUNCE *p_db, U32 raw );
+static BOOLEAN dioEdgeInit( const S_DIO_INPUT_PIN_DEF *ptr_cfg );
+static void dioEdgeRearm( void );
+
 /*----------------------------------------------------------------------------\
 |   Public Function Implementations                                           |
 \----------------------------------------------------------------------------*/
@@ -89,63 +275,296 @@ void dioHandlerInit( void )
     gioREG->GCR0   = 1U;
     gioREG->ENACLR = 0xFFU;
     gioREG->LVLCLR = 0xFFU;
+
+    /* MIBSPI3 pins are used as GIO only, its pin registers need the module out of reset */
+    mibspiREG3->GCR0 = 1U;
+
+    memset( dio_input_pins, 0, sizeof( dio_input_pins ) );
+    memset( dio_output_pins, 0, sizeof( dio_output_pins ) );
 }
 
 void set_digital_output( E_DIO_OUTPUT_PIN_ID pin_id, BOOLEAN value )
 {
-    // S_DM_DIGITAL_IO *ptr_dm_digital_outputs = ( S_DM_DIGITAL_IO * ) dmDigitalsAccess();
-    const S_DIO_OUTPUT_PIN_DEF * const ptr_cfg = dioConfigGetDOConfig();
+    const S_DIO_PIN *p_pin;
 
-    if ( ( ptr_cfg[ pin_id ].enabled == TRUE ) && ( pin_id < eDIO_NUM_OUTPUT_PINS ) )
+    if ( pin_id < eDIO_NUM_OUTPUT_PINS )
     {
-        switch ( ptr_cfg[ pin_id ].port )
+        p_pin = &dio_output_pins[ pin_id ];
+        if ( p_pin->mask != 0u )
         {
-            case eDIO_PORTA:
-                gioSetBit( gioPORTA, ptr_cfg[ pin_id ].pin, value );
-                break;
-            case eDIO_PORTB:
-                gioSetBit( gioPORTB, ptr_cfg[ pin_id ].pin, value );
-                break;
-            default:
-                break;
+            dioStore( p_pin->port, ( value == TRUE ) ? &dio_port_defs[ p_pin->port ].regs->DSET :
+                                                       &dio_port_defs[ p_pin->port ].regs->DCLR, p_pin->mask );
         }
-        // ptr_dm_digital_outputs->ptr_digital_io->digital_outputs[ pin_id ].value = value;
     }
 }
 
-BOOLEAN read_digital_input( E_DIO_INPUT_PIN_ID pin_id )
+void toggle_output_pin( E_DIO_OUTPUT_PIN_ID pin_id )
 {
-    BOOLEAN value;
-    // S_DM_DIGITAL_IO *ptr_dm_digital_inputs = ( S_DM_DIGITAL_IO * ) dmDigitalsAccess();
-    const S_DIO_INPUT_PIN_DEF * const ptr_cfg = dioConfigGetDIConfig();
+    const S_DIO_PIN *p_pin;
+    gioPORT_t *regs;
 
-    if ( ( ptr_cfg[ pin_id ].enabled == TRUE ) && ( pin_id < eDIO_NUM_INPUT_PINS ) )
+    if ( pin_id < eDIO_NUM_OUTPUT_PINS )
     {
-        switch ( ptr_cfg[ pin_id ].port )
+        p_pin = &dio_output_pins[ pin_id ];
+        regs = dio_port_defs[ p_pin->port ].regs;
+        if ( p_pin->mask != 0u )
         {
-            case eDIO_PORTA:
-                value = ( BOOLEAN ) gioGetBit( gioPORTA, ptr_cfg[ pin_id ].pin );
-                break;
-            case eDIO_PORTB:
-                value = ( BOOLEAN ) gioGetBit( gioPORTB, ptr_cfg[ pin_id ].pin );
-                break;
-            default:
-                break;
+            dioStore( p_pin->port, ( ( regs->DOUT & p_pin->mask ) != 0u ) ? &regs->DCLR : &regs->DSET, p_pin->mask );
         }
-        // ptr_dm_digital_inputs->ptr_digital_io->digital_inputs[ pin_id ].value = value;
     }
+}
 
-    return value;
+BOOLEAN read_digital_input( E_DIO_INPUT_PIN_ID pin_id )
+{
+    const S_DIO_PIN *p_pin;
+
+    if ( pin_id >= eDIO_NUM_INPUT_PINS )
+    {
+        return FALSE;
+    }
+
+    p_pin = &dio_input_pins[ pin_id ];
+
+    return ( ( dio_port_defs[ p_pin->port ].regs->DIN & p_pin->mask ) != 0u ) ? TRUE : FALSE;
 }
 
+/* Samples and debounces every port at once and publishes the Digitals. The
+ * caller is the single Digitals writer of the data manager.
+ */
 void read_digital_inputs( void )
 {
-    int i;
+    S_DIGITAL_IO digital_io;
+
+    dioSampleInputs( &digital_io.ports );
+    dmDigitalsPublish( &digital_io );
+}
+
+U32 dioReadPort( E_DIO_PORT_ID port )
+{
+    return ( port < eDIO_MAX_PORTS ) ? dio_port_defs[ port ].regs->DIN : 0u;
+}
+
+U32 dioReadOutputPort( E_DIO_PORT_ID port )
+{
+    return ( port < eDIO_MAX_PORTS ) ? dio_port_defs[ port ].regs->DOUT : 0u;
+}
+
+/* Drives the pins selected by mask to the levels in value, in two writes */
+void dioWritePort( E_DIO_PORT_ID port, U32 mask, U32 value )
+{
+    if ( port < eDIO_MAX_PORTS )
+    {
+        dioStore( port, &dio_port_defs[ port ].regs->DSET, mask & value );
+        dioStore( port, &dio_port_defs[ port ].regs->DCLR, mask & ~value );
+    }
+}
+
+/* Raw levels, no debouncing and no edges */
+void dioReadPortState( S_DIO_PORT_STATE *state )
+{
+    U32 i;
+
+    for ( i = 0u; i < eDIO_MAX_PORTS; i++ )
+    {
+        state->inputs[ i ] = dio_port_defs[ i ].regs->DIN;
+        state->outputs[ i ] = dio_port_defs[ i ].regs->DOUT;
+        state->rising[ i ] = 0u;
+        state->falling[ i ] = 0u;
+    }
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dioSampleInputs                                     |
+|                                                                             |
+|   Description         : Reads DIN and DOUT of every port once and steps     |
+|                         the debouncers, all pins of a port in parallel.     |
+|                         Pins that are not debounced inputs follow DIN at    |
+|                         the first sample. Re-arms the edge interrupts       |
+|                         whose hold-off has expired.                         |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : Debounced inputs, outputs and the debounced edges   |
+|                         since the previous call.                            |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : One sampling context, the debounce times count its  |
+|                         calls.                                              |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void dioSampleInputs( S_DIO_PORT_STATE *state )
+{
+    U32 i;
+    U32 toggled;
+
+    for ( i = 0u; i < eDIO_MAX_PORTS; i++ )
+    {
+        toggled = dioDebounce( &dio_debounce[ i ], dio_port_defs[ i ].regs->DIN );
+
+        state->inputs[ i ] = dio_debounce[ i ].stable;
+        state->outputs[ i ] = dio_port_defs[ i ].regs->DOUT;
+        state->rising[ i ] = toggled & dio_debounce[ i ].stable;
+        state->falling[ i ] = toggled & ~dio_debounce[ i ].stable;
+    }
+
+    dioEdgeRearm();
+}
+
+void dioSetEdgeHandler( DIO_EDGE_HANDLER handler )
+{
+    dio_edge_handler = handler;
+}
+
+/* Gatekeeper handler of eGK_SRC_DIO_EDGE, runs in the GK task. Hands every
+ * queued edge to the edge handler, oldest first.
+ */
+void dioEdgeServe( const void *item )
+{
+    S_DIO_EDGE_EVENT event;
+
+    ( void ) item;
+
+    while ( ringPop( &dio_edge_ring, &event ) == TRUE )
+    {
+        if ( dio_edge_handler != NULL )
+        {
+            dio_edge_handler( &event );
+        }
+    }
+}
+
+const S_DIO_EDGE_STATS * dioGetEdgeStats( void )
+{
+    return &dio_edge_stats;
+}
+
+/* GIO high level interrupt. Each OFF1 read returns the highest priority
+ * pending edge and clears its flag. A pin that fires again inside its
+ * hold-off is turned off, dioSampleInputs() turns it back on.
+ */
+#pragma CODE_STATE(dioEdgeInterrupt, 32)
+#pragma INTERRUPT(dioEdgeInterrupt, IRQ)
+void dioEdgeInterrupt( void )
+{
+    U32 now = DIO_TIMESTAMP();
+    U32 offset;
+    U32 bit;
+    U32 pin;
+    BOOLEAN queued = FALSE;
+    BaseType_t woken = pdFALSE;
+    S_DIO_EDGE_STATE *p_state;
+    S_DIO_EDGE_EVENT event;
     const S_DIO_INPUT_PIN_DEF * const ptr_cfg = dioConfigGetDIConfig();
 
-    for ( i = ptr_cfg[ 0 ].id; i < eDIO_NUM_INPUT_PINS; i++ )
+    TRC_ISR_ENTER( eTRC_ISR_GIO );
+
+    while ( ( offset = gioREG->OFF1 ) != 0u )
+    {
+        bit = offset - 1u;
+        if ( ( bit >= DIO_EDGE_BITS ) || ( dio_edge_pin[ bit ] == DIO_EDGE_NO_PIN ) )
+        {
+            continue;
+        }
+
+        pin = dio_edge_pin[ bit ];
+        p_state = &dio_edge_state[ bit ];
+
+        if ( ( now - p_state->last ) < p_state->holdoff )
+        {
+            gioREG->ENACLR = 1UL << bit;
+            atomicOrU32( &dio_edge_suppressed, 1UL << bit );
+            p_state->lost += ( p_state->lost < DIO_EDGE_LOST_MAX ) ? 1u : 0u;
+            dio_edge_stats.suppressed++;
+            continue;
+        }
+
+        event.time = now;
+        event.pin = ( U8 ) pin;
+        event.level = ( U8 ) ( ( dio_port_defs[ ptr_cfg[ pin ].port ].regs->DIN >> ptr_cfg[ pin ].pin ) & 1u );
+        event.lost = p_state->lost;
+
+        if ( ringPush( &dio_edge_ring, &event ) == TRUE )
+        {
+            p_state->last = now;
+            p_state->lost = 0u;
+            dio_edge_stats.events++;
+            queued = TRUE;
+        }
+        else
+        {
+            p_state->lost += ( p_state->lost < DIO_EDGE_LOST_MAX ) ? 1u : 0u;
+            dio_edge_stats.overflow++;
+        }
+    }
+
+    if ( queued == TRUE )
+    {
+        gkSignalFromISR( eGK_SRC_DIO_EDGE, &woken );
+    }
+
+    TRC_ISR_EXIT( eTRC_ISR_GIO );
+
+    portYIELD_FROM_ISR( woken );
+}
+
+void dioBatchClear( S_DIO_BATCH *batch )
+{
+    memset( batch, 0, sizeof( *batch ) );
+}
+
+/* Adds a level to a batch, the last level given for a pin wins */
+void dioBatchOutput( S_DIO_BATCH *batch, E_DIO_OUTPUT_PIN_ID pin_id, BOOLEAN value )
+{
+    const S_DIO_PIN *p_pin;
+
+    if ( pin_id < eDIO_NUM_OUTPUT_PINS )
+    {
+        p_pin = &dio_output_pins[ pin_id ];
+        if ( value == TRUE )
+        {
+            batch->set[ p_pin->port ] |= p_pin->mask;
+            batch->clr[ p_pin->port ] &= ~p_pin->mask;
+        }
+        else
+        {
+            batch->clr[ p_pin->port ] |= p_pin->mask;
+            batch->set[ p_pin->port ] &= ~p_pin->mask;
+        }
+    }
+}
+
+/* Drives a batch, ports in E_DIO_PORT_ID order, rising edges before falling on each port */
+void dioBatchCommit( const S_DIO_BATCH *batch )
+{
+    U32 i;
+
+    for ( i = 0u; i < eDIO_MAX_PORTS; i++ )
+    {
+        dioStore( i, &dio_port_defs[ i ].regs->DSET, batch->set[ i ] );
+        dioStore( i, &dio_port_defs[ i ].regs->DCLR, batch->clr[ i ] );
+    }
+}
+
+/* Drives a batch with one DOUT store per port touched, so all pins of a port
+ * change on the same clock. The read-modify-write of DOUT must not be
+ * interleaved with other writers of the port: call it in an interrupt or a
+ * privileged critical section.
+ */
+void dioBatchCommitAtomic( const S_DIO_BATCH *batch )
+{
+    U32 i;
+    gioPORT_t *regs;
+
+    for ( i = 0u; i < eDIO_MAX_PORTS; i++ )
     {
-        read_digital_input( ptr_cfg[ i ].id );
+        if ( ( batch->set[ i ] | batch->clr[ i ] ) != 0u )
+        {
+            regs = dio_port_defs[ i ].regs;
+            regs->DOUT = ( regs->DOUT | batch->set[ i ] ) & ~batch->clr[ i ];
+        }
     }
 }
 
@@ -157,66 +576,79 @@ const S_DIO_INPUT_PIN_DEF * const dioConfigGetDIConfig( void )
 
 BOOLEAN dioHandlerInitInputPins( void )
 {
-    int i;
+    U32 i;
+    U32 k;
+    U32 bit;
+    U32 samples;
+    U32 in[ eDIO_MAX_PORTS ] = { 0u };
+    U32 pull_off[ eDIO_MAX_PORTS ] = { 0u };
+    U32 pull_up[ eDIO_MAX_PORTS ] = { 0u };
     BOOLEAN ok = TRUE;
     const S_DIO_INPUT_PIN_DEF * const ptr_cfg = dioConfigGetDIConfig();
+    gioPORT_t *regs;
+
+    /* Every pin passes at the first sample unless configured otherwise */
+    memset( dio_debounce, 0, sizeof( dio_debounce ) );
+    for ( i = 0u; i < eDIO_MAX_PORTS; i++ )
+    {
+        dio_debounce[ i ].limit[ 0 ] = 0xFFFFFFFFu;
+    }
+
+    for ( i = 0u; i < eDIO_NUM_INPUT_PINS; i++ )
+    {
+        bit = dioResolve( &dio_input_pins[ i ], ptr_cfg[ i ].enabled, ptr_cfg[ i ].port, ptr_cfg[ i ].pin );
+        if ( bit == 0u )
+        {
+            ok = ( ptr_cfg[ i ].enabled == TRUE ) ? FALSE : ok;
+            continue;
+        }
+
+        in[ ptr_cfg[ i ].port ] |= bit;
+
+        samples = ( ptr_cfg[ i ].debounce == 0u ) ? 1u : ptr_cfg[ i ].debounce;
+        samples = ( samples > DIO_DEBOUNCE_MAX ) ? DIO_DEBOUNCE_MAX : samples;
+        for ( k = 0u; k < DIO_DEBOUNCE_BITS; k++ )
+        {
+            dio_debounce[ ptr_cfg[ i ].port ].limit[ k ] &= ~bit;
+            dio_debounce[ ptr_cfg[ i ].port ].limit[ k ] |= ( ( samples >> k ) & 1u ) ? bit : 0u;
+        }
+
+        if ( ( ptr_cfg[ i ].pull_enable == FALSE ) || ( ptr_cfg[ i ].pull == ePULL_NONE ) )
+        {
+            pull_off[ ptr_cfg[ i ].port ] |= bit;
+        }
+        else if ( ptr_cfg[ i ].pull == ePULL_UP )
+        {
+            pull_up[ ptr_cfg[ i ].port ] |= bit;
+        }
+    }
 
-    for ( i = 0; i < eDIO_NUM_INPUT_PINS; i++ )
+    for ( i = 0u; i < eDIO_MAX_PORTS; i++ )
     {
-        if ( ptr_cfg[ i ].enabled == TRUE )
+        if ( in[ i ] == 0u )
         {
-            switch ( ptr_cfg[ i ].port )
-            {
-                case eDIO_PORTA:
-                    gioPORTA->DIR |= ( uint32 ) ( ( uint32 ) 0U << ptr_cfg[ i ].pin );          /* Set pin direction to input */
-                    if ( ptr_cfg->pull_enable == TRUE )                                         /* Set input pin pull enable/disable */
-                    {
-                        gioPORTA->PULDIS |= ( uint32 ) ( ( uint32 ) 0U << ptr_cfg[ i ].pin );   /* Pull enable */
-                    }
-                    else
-                    {
-                        gioPORTA->PULDIS |= ( uint32 ) ( ( uint32 ) 1U << ptr_cfg[ i ].pin );   /* Pull disable */
-                    }
-                    if ( ptr_cfg[ i ].pull == ePULL_DOWN )                                      /* Set input pin pull up/down */
-                    {
-                        gioPORTA->PSL |= ( uint32 ) ( ( uint32 ) 0U << ptr_cfg[ i ].pin );      /* Pull down */
-                    }
-                    else if ( ptr_cfg[ i ].pull == ePULL_UP )
-                    {
-                        gioPORTA->PSL |= ( uint32 ) ( ( uint32 ) 1U << ptr_cfg[ i ].pin );      /* Pull up */
-                    }
-                    else                                                                        /* Pull none: Leave as from POR */
-                    {
-                        ;
-                    }
-                    break;
-                case eDIO_PORTB:
-                    gioPORTB->DIR |= ( uint32 ) ( ( uint32 ) 0U << ptr_cfg[ i ].pin );          /* Set pin direction to input */
-                    if ( ptr_cfg->pull_enable == TRUE )                                         /* Set input pin pull enable/disable */
-                    {
-                        gioPORTB->PULDIS |= ( uint32 ) ( ( uint32 ) 0U << ptr_cfg[ i ].pin );   /* Pull enable */
-                    }
-                    else
-                    {
-                        gioPORTB->PULDIS |= ( uint32 ) ( ( uint32 ) 1U << ptr_cfg[ i ].pin );   /* Pull disable */
-                    }
-                    if ( ptr_cfg[ i ].pull == ePULL_DOWN )                                      /* Set input pin pull up/down */
-                    {
-                        gioPORTB->PSL |= ( uint32 ) ( ( uint32 ) 0U << ptr_cfg[ i ].pin );      /* Pull down */
-                    }
-                    else if ( ptr_cfg[ i ].pull == ePULL_UP )
-                    {
-                        gioPORTB->PSL |= ( uint32 ) ( ( uint32 ) 1U << ptr_cfg[ i ].pin );      /* Pull up */
-                    }
-                    else                                                                        /* Pull none: Leave as from POR */
-                    {
-                        ;
-                    }
-                    break;
-                default:
-                    break;
-            }
+            continue;
         }
+
+        regs = dio_port_defs[ i ].regs;
+        if ( dio_port_defs[ i ].p_pc0 != NULL )
+        {
+            *dio_port_defs[ i ].p_pc0 &= ~in[ i ];                          /* GIO mode */
+        }
+        regs->PSL = ( regs->PSL & ~in[ i ] ) | pull_up[ i ];                /* Pull select before enable */
+        regs->PULDIS = ( regs->PULDIS & ~in[ i ] ) | pull_off[ i ];
+        regs->DIR &= ~in[ i ];
+    }
+
+    /* Start from the levels present, no edges at the first sample */
+    for ( i = 0u; i < eDIO_MAX_PORTS; i++ )
+    {
+        dio_debounce[ i ].stable = dio_port_defs[ i ].regs->DIN;
+    }
+
+    if ( dioEdgeInit( ptr_cfg ) == FALSE )
+    {
+        ok = FALSE;
     }
 
     return ok;
@@ -230,100 +662,220 @@ const S_DIO_OUTPUT_PIN_DEF * const dioConfigGetDOConfig( void )
 
 BOOLEAN dioHandlerInitOutputPins( void )
 {
-    int i;
+    U32 i;
+    U32 bit;
+    U32 out[ eDIO_MAX_PORTS ] = { 0u };
+    U32 open_drain[ eDIO_MAX_PORTS ] = { 0u };
+    U32 high[ eDIO_MAX_PORTS ] = { 0u };
     BOOLEAN ok = TRUE;
     const S_DIO_OUTPUT_PIN_DEF * const ptr_cfg = dioConfigGetDOConfig();
+    gioPORT_t *regs;
 
-    for ( i = 0; i < eDIO_NUM_OUTPUT_PINS; i++ )
+    for ( i = 0u; i < eDIO_NUM_OUTPUT_PINS; i++ )
     {
-        if ( ptr_cfg[ i ].enabled == TRUE )
+        bit = dioResolve( &dio_output_pins[ i ], ptr_cfg[ i ].enabled, ptr_cfg[ i ].port, ptr_cfg[ i ].pin );
+        if ( bit == 0u )
+        {
+            ok = ( ptr_cfg[ i ].enabled == TRUE ) ? FALSE : ok;
+            continue;
+        }
+
+        out[ ptr_cfg[ i ].port ] |= bit;
+        if ( ptr_cfg[ i ].open_drain == TRUE )
+        {
+            open_drain[ ptr_cfg[ i ].port ] |= bit;
+        }
+        if ( ptr_cfg[ i ].value == TRUE )
         {
-            switch ( ptr_cfg[ i ].port )
-            {
-                case eDIO_PORTA:
-                    gioPORTA->DIR |= ( uint32 ) ( ( uint32 ) 1U << ptr_cfg[ i ].pin );          /* Set pin direction to output */
-                    if ( ptr_cfg[ i ].open_drain == TRUE )
-                    {
-                        gioPORTA->PDR |= ( uint32 ) ( ( uint32 ) 0U << ptr_cfg[ i ].pin );      /* Open drain */
-                    }
-                    else
-                    {
-                        gioPORTA->PDR |= ( uint32 ) ( ( uint32 ) 1U << ptr_cfg[ i ].pin );      /* Not open drain */
-                    }
-                    if ( ptr_cfg[ i ].value == FALSE )
-                    {
-                        gioPORTA->DOUT |= ( uint32 ) ( ( uint32 ) 0U << ptr_cfg[ i ].pin );      /* Set low */
-                    }
-                    else
-                    {
-                        gioPORTA->DOUT |= ( uint32 ) ( ( uint32 ) 1U << ptr_cfg[ i ].pin );      /* Set high */
-                    }
-                    break;
-                case eDIO_PORTB:
-                    gioPORTB->DIR |= ( uint32 ) ( ( uint32 ) 1U << ptr_cfg[ i ].pin );          /* Set pin direction to output */
-                    if ( ptr_cfg[ i ].open_drain == TRUE )
-                    {
-                        gioPORTB->PDR |= ( uint32 ) ( ( uint32 ) 0U << ptr_cfg[ i ].pin );      /* Open drain */
-                    }
-                    else
-                    {
-                        gioPORTB->PDR |= ( uint32 ) ( ( uint32 ) 1U << ptr_cfg[ i ].pin );      /* Not open drain */
-                    }
-                    if ( ptr_cfg[ i ].value == FALSE )
-                    {
-                        gioPORTB->DOUT |= ( uint32 ) ( ( uint32 ) 0U << ptr_cfg[ i ].pin );      /* Set low */
-                    }
-                    else
-                    {
-                        gioPORTB->DOUT |= ( uint32 ) ( ( uint32 ) 1U << ptr_cfg[ i ].pin );      /* Set high */
-                    }
-                    break;
-                default:
-                    break;
-            }
+            high[ ptr_cfg[ i ].port ] |= bit;
+        }
+    }
+
+    for ( i = 0u; i < eDIO_MAX_PORTS; i++ )
+    {
+        if ( out[ i ] == 0u )
+        {
+            continue;
+        }
+
+        regs = dio_port_defs[ i ].regs;
+        regs->DSET = high[ i ];                                             /* Levels before the drivers are on */
+        regs->DCLR = out[ i ] & ~high[ i ];
+        regs->PDR = ( regs->PDR & ~out[ i ] ) | open_drain[ i ];
+        regs->DIR |= out[ i ];
+        if ( dio_port_defs[ i ].p_pc0 != NULL )
+        {
+            *dio_port_defs[ i ].p_pc0 &= ~out[ i ];                         /* GIO mode */
         }
     }
 
     return ok;
 }
 
-void toggle_output_pin( E_DIO_OUTPUT_PIN_ID pin_id )
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+/* Resolves a pin and returns its bit, 0 for a disabled or invalid pin */
+static U32 dioResolve( S_DIO_PIN *p_pin, BOOLEAN enabled, E_DIO_PORT_ID port, U8 pin )
+{
+    p_pin->port = 0u;
+    p_pin->mask = 0u;
+
+    if ( ( enabled == TRUE ) && ( port < eDIO_MAX_PORTS ) && ( pin < DIO_PORT_WIDTH ) )
+    {
+        p_pin->port = ( U32 ) port;
+        p_pin->mask = 1UL << pin;
+    }
+
+    return p_pin->mask;
+}
+
+/* One store to a port register, through the SVC for a privileged port written
+ * from a user mode task. Nothing is stored for an empty mask.
+ */
+static void dioStore( U32 port, volatile uint32 *p_reg, U32 value )
 {
-    S_DIO_OUTPUT_PIN_DEF * ptr_cfg = dioConfigGetDOConfig();
+    if ( value == 0u )
+    {
+        return;
+    }
 
-    if ( ptr_cfg[ pin_id ].enabled == TRUE )
+    if ( ( dio_port_defs[ port ].privileged == TRUE ) &&
+         ( ( _getCPSRValue_() & DIO_CPSR_MODE_MASK ) == DIO_CPSR_MODE_USER ) )
     {
-        switch ( ptr_cfg[ pin_id ].port )
+        ( void ) writePrivRegister32( ( uint32_t * ) p_reg, value );
+    }
+    else
+    {
+        *p_reg = value;
+    }
+}
+
+/* One sample of a port through its vertical counters. A pin whose raw level
+ * differs from its debounced level counts up, one that agrees restarts; at
+ * its limit the debounced level follows. Returns the pins that changed.
+ */
+static U32 dioDebounce( S_DIO_DEBOUNCE *p_db, U32 raw )
+{
+    U32 k;
+    U32 plane;
+    U32 next_carry;
+    U32 delta = raw ^ p_db->stable;
+    U32 carry = delta;
+    U32 reached = delta;
+
+    for ( k = 0u; k < DIO_DEBOUNCE_BITS; k++ )
+    {
+        plane = p_db->count[ k ] & delta;
+        next_carry = plane & carry;
+        plane ^= carry;
+        carry = next_carry;
+        reached &= ~( plane ^ p_db->limit[ k ] );
+        p_db->count[ k ] = plane;
+    }
+
+    p_db->stable ^= reached;
+    for ( k = 0u; k < DIO_DEBOUNCE_BITS; k++ )
+    {
+        p_db->count[ k ] &= ~reached;
+    }
+
+    return reached;
+}
+
+/* Programs the GIO interrupt of every edge input, all on the high level
+ * line. FALSE if an edge input is not on GIO A or B.
+ */
+static BOOLEAN dioEdgeInit( const S_DIO_INPUT_PIN_DEF *ptr_cfg )
+{
+    U32 i;
+    U32 bit;
+    U32 used = 0u;
+    U32 both = 0u;
+    U32 rising = 0u;
+    U32 now = DIO_TIMESTAMP();
+    BOOLEAN ok = TRUE;
+
+    memset( dio_edge_pin, DIO_EDGE_NO_PIN, sizeof( dio_edge_pin ) );
+    memset( dio_edge_state, 0, sizeof( dio_edge_state ) );
+    memset( &dio_edge_stats, 0, sizeof( dio_edge_stats ) );
+    dio_edge_suppressed = 0u;
+    ( void ) ringInit( &dio_edge_ring, dio_edge_buffer, sizeof( S_DIO_EDGE_EVENT ), DIO_EDGE_QUEUE_LENGTH );
+
+    for ( i = 0u; i < eDIO_NUM_INPUT_PINS; i++ )
+    {
+        if ( ( ptr_cfg[ i ].enabled == FALSE ) || ( ptr_cfg[ i ].edge == eDIO_EDGE_NONE ) )
         {
-            case eDIO_PORTA:
-                if ((gioPORTA->DIN & (uint32)((uint32)1U << ptr_cfg[ pin_id ].pin)) != 0U)
-                {
-                    gioPORTA->DCLR = (uint32)1U << ptr_cfg[ pin_id ].pin;
-                }
-                else
-                {
-                    gioPORTA->DSET = (uint32)1U << ptr_cfg[ pin_id ].pin;
-                }
-                break;
-            case eDIO_PORTB:
-                if ((gioPORTB->DIN & (uint32)((uint32)1U << ptr_cfg[ pin_id ].pin)) != 0U)
-                {
-                    gioPORTB->DCLR = (uint32)1U << ptr_cfg[ pin_id ].pin;
-                }
-                else
-                {
-                    gioPORTB->DSET = (uint32)1U << ptr_cfg[ pin_id ].pin;
-                }
-                break;
-            default:
-                break;
+            continue;
         }
+
+        if ( ( ptr_cfg[ i ].port > eDIO_PORTB ) || ( ptr_cfg[ i ].pin >= DIO_EDGE_PINS_PER_PORT ) )
+        {
+            ok = FALSE;                                 /* No interrupt on this pin, it stays polled */
+            continue;
+        }
+
+        bit = ( ( U32 ) ptr_cfg[ i ].port * DIO_EDGE_PINS_PER_PORT ) + ptr_cfg[ i ].pin;
+        dio_edge_pin[ bit ] = ( U8 ) i;
+        dio_edge_state[ bit ].holdoff = ( ( U32 ) ptr_cfg[ i ].edge_holdoff_us * DIO_TICKS_PER_2US ) / 2u;
+        dio_edge_state[ bit ].last = now - dio_edge_state[ bit ].holdoff;
+
+        used |= 1UL << bit;
+        both |= ( ptr_cfg[ i ].edge == eDIO_EDGE_BOTH ) ? ( 1UL << bit ) : 0u;
+        rising |= ( ptr_cfg[ i ].edge == eDIO_EDGE_RISING ) ? ( 1UL << bit ) : 0u;
+    }
+
+    if ( used != 0u )
+    {
+        gioREG->ENACLR = used;
+        gioREG->INTDET = ( gioREG->INTDET & ~used ) | both;
+        gioREG->POL = ( gioREG->POL & ~used ) | rising;
+        gioREG->LVLSET = used;
+        gioREG->FLG = used;                             /* Edges seen while configuring */
+
+        vimChannelMap( DIO_EDGE_VIM, DIO_EDGE_VIM, &dioEdgeInterrupt );
+        vimEnableInterrupt( DIO_EDGE_VIM, SYS_IRQ );
+        gioREG->ENASET = used;
     }
+
+    return ok;
 }
 
-/*----------------------------------------------------------------------------\
-|   Private Function Implementations                                          |
-\----------------------------------------------------------------------------*/
+/* Turns back on the edge interrupts whose hold-off has run out. Edges missed
+ * meanwhile are not replayed, the debounced levels cover them.
+ */
+static void dioEdgeRearm( void )
+{
+    U32 bit;
+    U32 mask;
+    U32 old;
+    U32 now;
+    U32 pending = dio_edge_suppressed;
+
+    if ( pending == 0u )
+    {
+        return;
+    }
+
+    now = DIO_TIMESTAMP();
+    for ( bit = 0u; bit < DIO_EDGE_BITS; bit++ )
+    {
+        mask = 1UL << bit;
+        if ( ( ( pending & mask ) == 0u ) || ( ( now - dio_edge_state[ bit ].last ) < dio_edge_state[ bit ].holdoff ) )
+        {
+            continue;
+        }
+
+        do
+        {
+            old = dio_edge_suppressed;
+        } while ( atomicCasU32( &dio_edge_suppressed, old, old & ~mask ) == FALSE );
+
+        gioREG->FLG = mask;
+        gioREG->ENASET = mask;
+    }
+}
 
 /*----------------------------------------------------------------------------\
 |   End of fw_dio.c module                                                    |
@@ -15,7 +15,13 @@
 |                                                                             |
 |-----------------------------------------------------------------------------|
 |                                                                             |
-|   <Module Header Description>                                               |
+|   Digital I/O.                                                              |
+|                                                                             |
+|   One pin ID space for every pin used as GPIO, whatever the peripheral      |
+|   that owns it: GIO, N2HET, DMM or MIBSPI. All of these expose the same     |
+|   port register layout ( gioPORT_t ), so a pin is a port and a bit. Each    |
+|   pin is resolved to its registers and bit mask once, at init; after that   |
+|   a write is one DSET or DCLR store and a read one DIN load.                |
 |                                                                             |
 \----------------------------------------------------------------------------*/
 
@@ -37,16 +43,29 @@
 
 typedef enum
 {
-    eDIO_PORTA = 0u,
-    eDIO_PORTB,
+    eDIO_PORTA = 0u,                    /* GIO A */
+    eDIO_PORTB,                         /* GIO B */
+    eDIO_PORT_HET1,                     /* N2HET1 pins not driven by the HET program */
+    eDIO_PORT_HET2,
+    eDIO_PORT_DMM,                      /* DMM pins in GIO mode */
+    eDIO_PORT_MIBSPI3,                  /* MIBSPI3 pins in GIO mode */
     eDIO_MAX_PORTS,
 } E_DIO_PORT_ID;
 
+typedef enum
+{
+    eDIO_EDGE_NONE = 0u,                /* Polled only */
+    eDIO_EDGE_RISING,
+    eDIO_EDGE_FALLING,
+    eDIO_EDGE_BOTH,
+} E_DIO_EDGE;
+
 /*
  * Digital input pin IDs
  */
 typedef enum
 {
+    eDIO_INPUT_PIN_H16_AISG_DIR = 0u,
     eDIO_NUM_INPUT_PINS,
 } E_DIO_INPUT_PIN_ID;
 
@@ -59,10 +78,13 @@ typedef struct
     CHAR                label[ 32u ];   /* Label of GPI */
     E_DIO_INPUT_PIN_ID  id;             /* ID of GPI */
     E_DIO_PORT_ID       port;
-    U8                  pin;
+    U8                  pin;            /* Bit of the pin in its port */
     E_PULL_UP_DOWN      pull;
     BOOLEAN             pull_enable;
-    BOOLEAN             value;
+    U8                  debounce;       /* Samples a new level must hold, 1 .. DIO_DEBOUNCE_MAX, 0 is 1 */
+    E_DIO_EDGE          edge;           /* Edge interrupt, GIO A and B pins only */
+    U16                 edge_holdoff_us;    /* Least time between two edge events of the pin, 0 for none */
+    BOOLEAN             value;          /* Unused, the state is in the port bitmaps */
     BOOLEAN             enabled;
 } S_DIO_INPUT_PIN_DEF;
 
@@ -73,6 +95,15 @@ typedef enum
 {
     eDIO_OUTPUT_PIN_LED_6 = 0u,
     eDIO_OUTPUT_PIN_LED_7,
+    eDIO_OUTPUT_PIN_A13_RS485_REB,
+    eDIO_OUTPUT_PIN_J17_VPOS_5019,
+    eDIO_OUTPUT_PIN_N1_POW_SWDT,
+    eDIO_OUTPUT_PIN_V6_FLT_BYPASS_SW,
+    eDIO_OUTPUT_PIN_LED_LEFT_BOTTOM,
+    eDIO_OUTPUT_PIN_H17_RS485_DE,
+    eDIO_OUTPUT_PIN_W8_DEMOD_ENA,
+    eDIO_OUTPUT_PIN_V8_GAIN_ACTIVE_2,
+    eDIO_OUTPUT_PIN_W9_GAIN_ACTIVE_1,
     eDIO_NUM_OUTPUT_PINS,
 } E_DIO_OUTPUT_PIN_ID;
 
@@ -85,16 +116,69 @@ typedef struct
     CHAR                label[ 32u ];   /* Label of GPO */
     E_DIO_OUTPUT_PIN_ID id;             /* ID of GPO */
     E_DIO_PORT_ID       port;
-    U8                  pin;
+    U8                  pin;            /* Bit of the pin in its port */
     BOOLEAN             open_drain;
-    BOOLEAN             value;
+    BOOLEAN             value;          /* Initial level, the state is in the port bitmaps */
     BOOLEAN             enabled;
 } S_DIO_OUTPUT_PIN_DEF;
 
+/*
+ * Runtime digital state: one bitmap word per port, bit n is pin n.
+ * The pin configuration stays in the const tables of fw_dio.c.
+ */
+typedef struct
+{
+    U32                 inputs[ eDIO_MAX_PORTS ];       /* DIN of every port, debounced when sampled */
+    U32                 outputs[ eDIO_MAX_PORTS ];      /* DOUT of every port */
+    U32                 rising[ eDIO_MAX_PORTS ];       /* Debounced edges since the previous sample */
+    U32                 falling[ eDIO_MAX_PORTS ];
+} S_DIO_PORT_STATE;
+
+/*
+ * One edge of an interrupt input, queued by the GIO interrupt
+ */
+typedef struct
+{
+    U32                 time;           /* RTI counter 0 at the interrupt */
+    U8                  pin;            /* E_DIO_INPUT_PIN_ID */
+    U8                  level;          /* Pin level read in the interrupt */
+    U16                 lost;           /* Edges of the pin suppressed or dropped since its previous event */
+} S_DIO_EDGE_EVENT;
+
+typedef void ( *DIO_EDGE_HANDLER )( const S_DIO_EDGE_EVENT *event );
+
+typedef struct
+{
+    U32                 events;         /* Queued */
+    U32                 suppressed;     /* Inside a pin's hold-off, the pin interrupt was turned off */
+    U32                 overflow;       /* Queue full */
+} S_DIO_EDGE_STATS;
+
+/*
+ * Output levels collected per port and driven together by dioBatchCommit(),
+ * one DSET and one DCLR store per port touched.
+ */
+typedef struct
+{
+    U32                 set[ eDIO_MAX_PORTS ];
+    U32                 clr[ eDIO_MAX_PORTS ];
+} S_DIO_BATCH;
+
 /*----------------------------------------------------------------------------\
 |   Public Constant Declarations                                              |
 \----------------------------------------------------------------------------*/
 
+#define DIO_PORT_WIDTH      32u             /* Pins per bitmap word */
+
+#define DIO_DEBOUNCE_BITS   4u              /* Bit planes of the debounce counters */
+#define DIO_DEBOUNCE_MAX    ( ( 1u << DIO_DEBOUNCE_BITS ) - 1u )
+
+#define DIO_EDGE_BITS           16u         /* GIO interrupt pins, A0 .. A7 then B0 .. B7 */
+#define DIO_EDGE_QUEUE_LENGTH   32u         /* Events, power of two */
+
+/* Level of a pin in a port bitmap array */
+#define DIO_BIT( ports, port, pin )     ( ( BOOLEAN ) ( ( ( ports )[ ( port ) ] >> ( pin ) ) & 1u ) )
+
 /*----------------------------------------------------------------------------\
 |   Public Data Declarations                                                  |
 \----------------------------------------------------------------------------*/
@@ -109,8 +193,22 @@ BOOLEAN dioHandlerInitOutputPins( void );
 const S_DIO_INPUT_PIN_DEF * const dioConfigGetDIConfig( void );
 const S_DIO_OUTPUT_PIN_DEF * const dioConfigGetDOConfig( void );
 void set_digital_output( E_DIO_OUTPUT_PIN_ID pin_id, BOOLEAN value );
+void toggle_output_pin( E_DIO_OUTPUT_PIN_ID pin_id );
 BOOLEAN read_digital_input ( E_DIO_INPUT_PIN_ID pin_id );
 void read_digital_inputs( void );
+U32 dioReadPort( E_DIO_PORT_ID port );
+U32 dioReadOutputPort( E_DIO_PORT_ID port );
+void dioWritePort( E_DIO_PORT_ID port, U32 mask, U32 value );
+void dioReadPortState( S_DIO_PORT_STATE *state );
+void dioSampleInputs( S_DIO_PORT_STATE *state );
+void dioBatchClear( S_DIO_BATCH *batch );
+void dioBatchOutput( S_DIO_BATCH *batch, E_DIO_OUTPUT_PIN_ID pin_id, BOOLEAN value );
+void dioBatchCommit( const S_DIO_BATCH *batch );
+void dioBatchCommitAtomic( const S_DIO_BATCH *batch );
+void dioSetEdgeHandler( DIO_EDGE_HANDLER handler );
+void dioEdgeServe( const void *item );
+const S_DIO_EDGE_STATS * dioGetEdgeStats( void );
+void dioEdgeInterrupt( void );
 
 /*----------------------------------------------------------------------------\
 |   End of fw_dio.h header file                                               |
@@ -0,0 +1,323 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_dio_sched.c Module File.                                |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Time-tagged output commands.                                              |
+|                                                                             |
+|   Submit resolves the commands into per port batches, one per step. RTI     |
+|   compare 3, on counter 0, is armed DIO_SCHED_LEAD ahead of each step;      |
+|   the interrupt spins the rest of the lead on the counter and drives the    |
+|   step, so the interrupt latency does not show in the edge time. A step     |
+|   due within the lead of the previous one runs in the same interrupt.       |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Compiler Controls                                                         |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "HL_sys_vim.h"
+
+#include "FreeRTOS.h"
+#include "os_task.h"
+
+#include "fw_dio_sched.h"
+#include "fw_trace.h"
+#include "fw_utils.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    U32                         time;
+    S_DIO_BATCH                 batch;
+} S_DIO_SCHED_STEP;
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define DIO_SCHED_TIMESTAMP()       ( rtiREG1->CNT[ 0 ].FRCx )
+#define DIO_SCHED_VIM               5U                  /* RTI compare 3 */
+#define DIO_SCHED_CMP               3U
+#define DIO_SCHED_INT               ( 1UL << DIO_SCHED_CMP )
+#define DIO_SCHED_LEAD              DIO_SCHED_US( 2u )  /* Interrupt entry budget */
+#define DIO_SCHED_AHEAD_MIN         DIO_SCHED_US( 5u )  /* First step at least this far ahead at submit */
+
+/* Signed distance from now to a time, valid within +/- 57 s */
+#define DIO_SCHED_DUE( t, now )     ( ( S32 ) ( ( t ) - ( now ) ) )
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static S_DIO_SCHED_STEP dio_sched_steps[ DIO_SCHED_COMMANDS_MAX ];
+
+/* What dioSchedGetReport() reads, left alone by a rejected submit */
+static U32 dio_sched_executed[ DIO_SCHED_COMMANDS_MAX ];        /* Port store time of each step */
+static U8 dio_sched_cmd_step[ DIO_SCHED_COMMANDS_MAX ];         /* Step of each command */
+static U32 dio_sched_cmd_time[ DIO_SCHED_COMMANDS_MAX ];
+static U32 dio_sched_commands;
+static U32 dio_sched_count;                                     /* Steps of the sequence */
+static U32 dio_sched_next;                                      /* Next step to drive */
+static volatile BOOLEAN dio_sched_active = FALSE;
+
+/*----------------------------------------------------------------------------\
+|   Private Function Declarations                                             |
+\----------------------------------------------------------------------------*/
+
+static BOOLEAN dioSchedRun( void );
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dioSchedInit                                        |
+|                                                                             |
+|   Description         : Installs the RTI compare 3 interrupt. The compare   |
+|                         interrupt itself is enabled while a sequence runs.  |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : After dioHandlerInitOutputPins(). The compare uses  |
+|                         counter 0, as left by the FreeRTOS tick setup.      |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void dioSchedInit( void )
+{
+    memset( dio_sched_steps, 0, sizeof( dio_sched_steps ) );
+    memset( dio_sched_executed, 0, sizeof( dio_sched_executed ) );
+    dio_sched_commands = 0u;
+    dio_sched_count = 0u;
+    dio_sched_next = 0u;
+    dio_sched_active = FALSE;
+
+    rtiREG1->CLEARINTENA = DIO_SCHED_INT;
+    rtiREG1->INTFLAG = DIO_SCHED_INT;
+
+    vimChannelMap( DIO_SCHED_VIM, DIO_SCHED_VIM, &dioSchedInterrupt );
+    vimEnableInterrupt( DIO_SCHED_VIM, SYS_IRQ );
+}
+
+/* Current time of the sequences */
+U32 dioSchedNow( void )
+{
+    return DIO_SCHED_TIMESTAMP();
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dioSchedSubmit                                      |
+|                                                                             |
+|   Description         : Starts a sequence. Commands are in time order;      |
+|                         those of equal time are one step, the last level    |
+|                         given for a pin in a step wins.                     |
+|                                                                             |
+|   Inputs              : cmds        - Commands, copied.                     |
+|                         count       - 1 .. DIO_SCHED_COMMANDS_MAX.          |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : FALSE if a sequence is running, a command is out    |
+|                         of order or names no output, or the first step is   |
+|                         less than DIO_SCHED_AHEAD_MIN ahead.                |
+|                                                                             |
+|   Warnings            : Times are at most 57 s ahead.                       |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN dioSchedSubmit( const S_DIO_SCHED_CMD *cmds, U32 count )
+{
+    U8 cmd_step[ DIO_SCHED_COMMANDS_MAX ];
+    U32 i;
+    U32 steps = 0u;
+    BOOLEAN ok = TRUE;
+
+    if ( ( dio_sched_active == TRUE ) || ( count == 0u ) || ( count > DIO_SCHED_COMMANDS_MAX ) )
+    {
+        return FALSE;
+    }
+
+    /* The steps are rebuilt in place, the report of the last sequence is
+     * only replaced once this one is armed */
+    for ( i = 0u; i < count; i++ )
+    {
+        if ( ( cmds[ i ].pin >= eDIO_NUM_OUTPUT_PINS ) ||
+             ( ( i > 0u ) && ( DIO_SCHED_DUE( cmds[ i ].time, cmds[ i - 1u ].time ) < 0 ) ) )
+        {
+            return FALSE;
+        }
+
+        if ( ( i == 0u ) || ( cmds[ i ].time != cmds[ i - 1u ].time ) )
+        {
+            dio_sched_steps[ steps ].time = cmds[ i ].time;
+            dioBatchClear( &dio_sched_steps[ steps ].batch );
+            steps++;
+        }
+
+        dioBatchOutput( &dio_sched_steps[ steps - 1u ].batch, cmds[ i ].pin, cmds[ i ].level );
+        cmd_step[ i ] = ( U8 ) ( steps - 1u );
+    }
+
+    /* The check and the arming must not be split by a preemption */
+    taskENTER_CRITICAL();
+
+    if ( DIO_SCHED_DUE( cmds[ 0 ].time, DIO_SCHED_TIMESTAMP() ) < ( S32 ) DIO_SCHED_AHEAD_MIN )
+    {
+        ok = FALSE;
+    }
+    else
+    {
+        for ( i = 0u; i < count; i++ )
+        {
+            dio_sched_executed[ i ] = 0u;
+            dio_sched_cmd_step[ i ] = cmd_step[ i ];
+            dio_sched_cmd_time[ i ] = cmds[ i ].time;
+        }
+        dio_sched_commands = count;
+        dio_sched_count = steps;
+        dio_sched_next = 0u;
+        dio_sched_active = TRUE;
+
+        rtiREG1->CMP[ DIO_SCHED_CMP ].COMPx = dio_sched_steps[ 0 ].time - DIO_SCHED_LEAD;
+        rtiREG1->CMP[ DIO_SCHED_CMP ].UDCPx = 0u;
+        rtiREG1->INTFLAG = DIO_SCHED_INT;
+        rtiREG1->SETINTENA = DIO_SCHED_INT;
+    }
+
+    taskEXIT_CRITICAL();
+
+    return ok;
+}
+
+BOOLEAN dioSchedBusy( void )
+{
+    return dio_sched_active;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dioSchedGetReport                                   |
+|                                                                             |
+|   Description         : Reports the last completed sequence.                |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : report      - Driven time of each command, in       |
+|                                       submit order, and the worst lateness. |
+|                                                                             |
+|   Return              : FALSE while a sequence is running.                  |
+|                                                                             |
+|   Warnings            : None.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN dioSchedGetReport( S_DIO_SCHED_REPORT *report )
+{
+    U32 i;
+    S32 late;
+
+    if ( dio_sched_active == TRUE )
+    {
+        return FALSE;
+    }
+
+    memset( report, 0, sizeof( *report ) );
+    report->commands = dio_sched_commands;
+    for ( i = 0u; i < dio_sched_commands; i++ )
+    {
+        report->executed[ i ] = dio_sched_executed[ dio_sched_cmd_step[ i ] ];
+        late = DIO_SCHED_DUE( report->executed[ i ], dio_sched_cmd_time[ i ] );
+        report->late_max = ( ( i == 0u ) || ( late > report->late_max ) ) ? late : report->late_max;
+    }
+
+    return TRUE;
+}
+
+/* RTI compare 3: drives every step that is due, arms the next */
+#pragma CODE_STATE(dioSchedInterrupt, 32)
+#pragma INTERRUPT(dioSchedInterrupt, IRQ)
+void dioSchedInterrupt( void )
+{
+    TRC_ISR_ENTER( eTRC_ISR_DIO_SCHED );
+
+    rtiREG1->INTFLAG = DIO_SCHED_INT;
+
+    if ( ( dio_sched_active == FALSE ) || ( dioSchedRun() == FALSE ) )
+    {
+        rtiREG1->CLEARINTENA = DIO_SCHED_INT;
+        dio_sched_active = FALSE;
+    }
+
+    TRC_ISR_EXIT( eTRC_ISR_DIO_SCHED );
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+/* Drives the due steps. Returns TRUE with the compare armed for the next
+ * step, FALSE when the sequence has completed.
+ */
+static BOOLEAN dioSchedRun( void )
+{
+    S_DIO_SCHED_STEP *p_step;
+
+    while ( dio_sched_next < dio_sched_count )
+    {
+        p_step = &dio_sched_steps[ dio_sched_next ];
+
+        if ( DIO_SCHED_DUE( p_step->time - DIO_SCHED_LEAD, DIO_SCHED_TIMESTAMP() ) > 0 )
+        {
+            /* A compare only fires on an exact count: check the time after
+             * arming, a match already missed is driven here instead */
+            rtiREG1->CMP[ DIO_SCHED_CMP ].COMPx = p_step->time - DIO_SCHED_LEAD;
+            if ( DIO_SCHED_DUE( p_step->time - DIO_SCHED_LEAD, DIO_SCHED_TIMESTAMP() ) > 0 )
+            {
+                return TRUE;
+            }
+        }
+
+        while ( DIO_SCHED_DUE( p_step->time, DIO_SCHED_TIMESTAMP() ) > 0 )
+        {
+        }
+
+        dioBatchCommitAtomic( &p_step->batch );
+        dio_sched_executed[ dio_sched_next ] = DIO_SCHED_TIMESTAMP();
+        dio_sched_next++;
+    }
+
+    return FALSE;
+}
+
+/*----------------------------------------------------------------------------\
+|   End of fw_dio_sched.c module                                              |
+\----------------------------------------------------------------------------*/
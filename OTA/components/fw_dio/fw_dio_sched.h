@@ -0,0 +1,85 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_dio_sched.h Header File.                                |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Time-tagged output commands.                                              |
+|                                                                             |
+|   A sequence is a list of ( time, pin, level ) commands, times absolute     |
+|   in RTI counter 0 ticks ( 37.5 MHz, the timestamp of fw_log, fw_trace      |
+|   and fw_dio ). Commands of the same time form one step and are driven      |
+|   together, one DOUT store per port, so pins of a port change on the same   |
+|   clock: ADRF5019 supply, gain and demodulator enables switch in order      |
+|   with exact gaps and no busy-wait in a task.                               |
+|                                                                             |
+|   The steps run in the RTI compare 3 interrupt. The report gives the time   |
+|   each command was driven once the sequence has completed.                  |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef fw_dio_sched_H
+#define fw_dio_sched_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "fw_types.h"
+#include "fw_dio.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+#define DIO_SCHED_COMMANDS_MAX      16u
+#define DIO_SCHED_TICKS_PER_2US     75u                 /* RTI counter 0 at 37.5 MHz */
+
+/* Microseconds to RTI counter 0 ticks, up to 57 s */
+#define DIO_SCHED_US( us )          ( ( ( U32 ) ( us ) * DIO_SCHED_TICKS_PER_2US ) / 2u )
+
+/*----------------------------------------------------------------------------\
+|   Public Type Definitions                                                   |
+\----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    U32                         time;               /* RTI counter 0 ticks, absolute */
+    E_DIO_OUTPUT_PIN_ID         pin;
+    BOOLEAN                     level;
+} S_DIO_SCHED_CMD;
+
+typedef struct
+{
+    U32                         commands;           /* Of the last sequence */
+    U32                         executed[ DIO_SCHED_COMMANDS_MAX ];     /* Time of the port store of each command */
+    S32                         late_max;           /* Worst executed - time, ticks */
+} S_DIO_SCHED_REPORT;
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+void dioSchedInit( void );
+U32 dioSchedNow( void );
+BOOLEAN dioSchedSubmit( const S_DIO_SCHED_CMD *cmds, U32 count );
+BOOLEAN dioSchedBusy( void );
+BOOLEAN dioSchedGetReport( S_DIO_SCHED_REPORT *report );
+void dioSchedInterrupt( void );
+
+/*----------------------------------------------------------------------------\
+|   End of fw_dio_sched.h header file                                         |
+\----------------------------------------------------------------------------*/
+
+#endif  /* fw_dio_sched_H */
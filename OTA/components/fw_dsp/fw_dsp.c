@@ -0,0 +1,398 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_dsp.c Module File.                                      |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Fixed-point filters for blocks of channels.                               |
+|                                                                             |
+|   The low-pass and the rate of change are one dual MAC per channel: the     |
+|   input and the state are packed into one word against a packed             |
+|   coefficient pair prepared at init. The moving average keeps a running     |
+|   sum, so its cost does not depend on the length.                           |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Compiler Controls                                                         |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <math.h>
+#include <string.h>
+
+#include "fw_dsp.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define DSP_ROUND_Q15               0x4000L             /* 0.5 before a 15 bit shift */
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dspLowpassInit                                      |
+|                                                                             |
+|   Description         : Prepares the packed coefficients of a one pole      |
+|                         low-pass and clears the outputs.                    |
+|                                                                             |
+|   Inputs              : Filter.                                             |
+|                         Number of channels.                                 |
+|                         Coefficient storage, one word per channel.          |
+|                         Output storage, one Q15 per channel.                |
+|                         Per channel a, Q15 in 1 .. 32767.                   |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : FALSE if an a is out of range.                      |
+|                                                                             |
+|   Warnings            : None.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN dspLowpassInit( S_DSP_LOWPASS *f, U32 channels, U32 *coef, Q15 *y, const Q15 *a )
+{
+    U32 i;
+
+    for ( i = 0u; i < channels; i++ )
+    {
+        if ( a[ i ] <= 0 )
+        {
+            return FALSE;
+        }
+        coef[ i ] = DSP_PACK( DSP_Q15_ONE - a[ i ], a[ i ] );
+    }
+
+    memset( y, 0, channels * sizeof( Q15 ) );
+
+    f->channels = channels;
+    f->p_coef = coef;
+    f->p_y = y;
+
+    return TRUE;
+}
+
+/* y = ( 1 - a ) * y + a * x, rounded. A convex combination, so no saturation */
+void dspLowpass( S_DSP_LOWPASS *f, const Q15 *x )
+{
+    U32 i;
+    const U32 *p_coef = f->p_coef;
+    Q15 *p_y = f->p_y;
+
+    for ( i = 0u; i < f->channels; i++ )
+    {
+        p_y[ i ] = ( Q15 ) ( DSP_SMLAD( DSP_PACK( p_y[ i ], x[ i ] ), p_coef[ i ], DSP_ROUND_Q15 ) >> 15 );
+    }
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dspMovingAverageInit                                |
+|                                                                             |
+|   Description         : Attaches the storage of a moving average and        |
+|                         clears it, the history starts as zeros.             |
+|                                                                             |
+|   Inputs              : Filter.                                             |
+|                         Number of channels.                                 |
+|                         Length, as log2.                                    |
+|                         History of DSP_MOVAVG_WORDS Q15.                    |
+|                         Sum storage, one Q31 per channel.                   |
+|                         Output storage, one Q15 per channel.                |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : FALSE if the length is above DSP_MOVAVG_LOG2_MAX.   |
+|                                                                             |
+|   Warnings            : None.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN dspMovingAverageInit( S_DSP_MOVAVG *f, U32 channels, U32 log2_length, Q15 *history, Q31 *sum, Q15 *y )
+{
+    if ( log2_length > DSP_MOVAVG_LOG2_MAX )
+    {
+        return FALSE;
+    }
+
+    memset( history, 0, DSP_MOVAVG_WORDS( channels, log2_length ) * sizeof( Q15 ) );
+    memset( sum, 0, channels * sizeof( Q31 ) );
+    memset( y, 0, channels * sizeof( Q15 ) );
+
+    f->channels = channels;
+    f->log2_length = log2_length;
+    f->index = 0u;
+    f->p_history = history;
+    f->p_sum = sum;
+    f->p_y = y;
+
+    return TRUE;
+}
+
+void dspMovingAverage( S_DSP_MOVAVG *f, const Q15 *x )
+{
+    U32 i;
+    Q15 *p_row = &f->p_history[ f->index * f->channels ];
+    Q31 *p_sum = f->p_sum;
+    Q15 *p_y = f->p_y;
+
+    /* The row written now holds the oldest inputs */
+    for ( i = 0u; i < f->channels; i++ )
+    {
+        p_sum[ i ] += ( Q31 ) x[ i ] - ( Q31 ) p_row[ i ];
+        p_row[ i ] = x[ i ];
+        p_y[ i ] = ( Q15 ) ( p_sum[ i ] >> f->log2_length );
+    }
+
+    f->index = ( f->index + 1u ) & ( ( ( U32 ) 1u << f->log2_length ) - 1u );
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dspMedianInit                                       |
+|                                                                             |
+|   Description         : Attaches the storage of a median filter and clears  |
+|                         it, the history starts as zeros.                    |
+|                                                                             |
+|   Inputs              : Filter.                                             |
+|                         Number of channels.                                 |
+|                         Length, odd, at most DSP_MEDIAN_MAX.                |
+|                         History of DSP_MEDIAN_WORDS Q15.                    |
+|                         Output storage, one Q15 per channel.                |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : FALSE if the length is even or too long.            |
+|                                                                             |
+|   Warnings            : None.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN dspMedianInit( S_DSP_MEDIAN *f, U32 channels, U32 length, Q15 *history, Q15 *y )
+{
+    if ( ( ( length & 1u ) == 0u ) || ( length > DSP_MEDIAN_MAX ) )
+    {
+        return FALSE;
+    }
+
+    memset( history, 0, DSP_MEDIAN_WORDS( channels, length ) * sizeof( Q15 ) );
+    memset( y, 0, channels * sizeof( Q15 ) );
+
+    f->channels = channels;
+    f->length = length;
+    f->index = 0u;
+    f->p_history = history;
+    f->p_y = y;
+
+    return TRUE;
+}
+
+/* Insertion sort of the column of each channel, short enough to beat a
+ * selection network for the lengths allowed
+ */
+void dspMedian( S_DSP_MEDIAN *f, const Q15 *x )
+{
+    U32 i;
+    U32 k;
+    U32 m;
+    Q15 v;
+    Q15 column[ DSP_MEDIAN_MAX ];
+    Q15 *p_row = &f->p_history[ f->index * f->channels ];
+
+    for ( i = 0u; i < f->channels; i++ )
+    {
+        p_row[ i ] = x[ i ];
+    }
+
+    for ( i = 0u; i < f->channels; i++ )
+    {
+        /* dspMedianInit() keeps the length odd and at most DSP_MEDIAN_MAX */
+        column[ 0 ] = f->p_history[ i ];
+        for ( k = 1u; k < f->length; k++ )
+        {
+            v = f->p_history[ ( k * f->channels ) + i ];
+            for ( m = k; ( m > 0u ) && ( column[ m - 1u ] > v ); m-- )
+            {
+                column[ m ] = column[ m - 1u ];
+            }
+            column[ m ] = v;
+        }
+        f->p_y[ i ] = column[ f->length >> 1 ];
+    }
+
+    f->index = ( f->index + 1u < f->length ) ? ( f->index + 1u ) : 0u;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dspRateInit                                         |
+|                                                                             |
+|   Description         : Prepares the packed gains of a rate of change       |
+|                         filter and clears its state.                        |
+|                                                                             |
+|   Inputs              : Filter.                                             |
+|                         Number of channels.                                 |
+|                         Gain exponent, 0 .. 15.                             |
+|                         Coefficient storage, one word per channel.          |
+|                         Previous input storage, one Q15 per channel.        |
+|                         Output storage, one Q15 per channel.                |
+|                         Per channel gain g, Q15, not -32768.                |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : FALSE if the shift or a gain is out of range.       |
+|                                                                             |
+|   Warnings            : The first output after init is relative to zero.    |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN dspRateInit( S_DSP_RATE *f, U32 channels, U32 shift, U32 *coef, Q15 *previous, Q15 *y, const Q15 *g )
+{
+    U32 i;
+
+    if ( shift > 15u )
+    {
+        return FALSE;
+    }
+
+    for ( i = 0u; i < channels; i++ )
+    {
+        if ( g[ i ] == DSP_Q15_MIN )
+        {
+            return FALSE;
+        }
+        coef[ i ] = DSP_PACK( g[ i ], -g[ i ] );
+    }
+
+    memset( previous, 0, channels * sizeof( Q15 ) );
+    memset( y, 0, channels * sizeof( Q15 ) );
+
+    f->channels = channels;
+    f->shift = shift;
+    f->p_coef = coef;
+    f->p_previous = previous;
+    f->p_y = y;
+
+    return TRUE;
+}
+
+/* g * x - g * previous in one dual MAC, at most 32767 * 65535 so no wrap */
+void dspRate( S_DSP_RATE *f, const Q15 *x )
+{
+    U32 i;
+    const U32 *p_coef = f->p_coef;
+    Q15 *p_previous = f->p_previous;
+    Q15 *p_y = f->p_y;
+    U32 down = 15u - f->shift;
+
+    for ( i = 0u; i < f->channels; i++ )
+    {
+        p_y[ i ] = dspSat15( DSP_SMUAD( DSP_PACK( x[ i ], p_previous[ i ] ), p_coef[ i ] ) >> down );
+        p_previous[ i ] = x[ i ];
+    }
+}
+
+/* Q29 coefficient of a frequency, floating point, for initialisation only */
+S32 dspGoertzelCoef( U32 frequency_hz, U32 sample_hz )
+{
+    DOUBLE w = ( 2.0 * 3.14159265358979323846 * ( DOUBLE ) frequency_hz ) / ( DOUBLE ) sample_hz;
+    DOUBLE coef = 2.0 * cos( w ) * ( DOUBLE ) ( 1L << DSP_GOERTZEL_Q );
+
+    /* 2.0 itself does not fit */
+    return ( coef >= 2147483647.0 ) ? ( S32 ) 0x7FFFFFFFL : ( S32 ) floor( coef + 0.5 );
+}
+
+void dspGoertzelInit( S_DSP_GOERTZEL *g, S32 coef )
+{
+    g->coef = coef;
+    g->s1 = 0;
+    g->s2 = 0;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : dspGoertzelAmplitude                                |
+|                                                                             |
+|   Description         : Ends a block: power s1^2 + s2^2 - coef * s1 * s2,   |
+|                         scaled to the amplitude of a tone at the            |
+|                         frequency ( 2 sqrt( power ) / block ), and clears   |
+|                         the resonator for the next block.                   |
+|                                                                             |
+|   Inputs              : Resonator.                                          |
+|                         Number of inputs in the block.                      |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : Amplitude in input units.                           |
+|                                                                             |
+|   Warnings            : None.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+U32 dspGoertzelAmplitude( S_DSP_GOERTZEL *g, U32 block )
+{
+    S64 s1 = g->s1;
+    S64 s2 = g->s2;
+    S64 power;
+
+    power = ( s1 * s1 ) + ( s2 * s2 ) - ( ( ( ( S64 ) g->coef * s1 ) >> DSP_GOERTZEL_Q ) * s2 );
+
+    g->s1 = 0;
+    g->s2 = 0;
+
+    if ( ( power <= 0 ) || ( block == 0u ) )
+    {
+        return 0u;
+    }
+
+    return ( 2u * dspSqrt64( ( U64 ) power ) ) / block;
+}
+
+/* Integer square root, rounded down, one result bit per iteration */
+U32 dspSqrt64( U64 x )
+{
+    U64 root = 0u;
+    U64 bit = ( U64 ) 1u << 62;
+
+    while ( bit > x )
+    {
+        bit >>= 2;
+    }
+
+    while ( bit != 0u )
+    {
+        if ( x >= root + bit )
+        {
+            x -= root + bit;
+            root = ( root >> 1 ) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return ( U32 ) root;
+}
+
+/*----------------------------------------------------------------------------\
+|   End of fw_dsp.c module                                                    |
+\----------------------------------------------------------------------------*/
@@ -0,0 +1,189 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_dsp.h Header File.                                      |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Fixed-point filters for blocks of channels.                               |
+|                                                                             |
+|   Every filter runs over all its channels in one call. Inputs, outputs      |
+|   and state are separate per channel arrays ( structure of arrays ), so     |
+|   a call walks each array once. The caller owns the storage, sized by the   |
+|   DSP_*_WORDS macros or the channel count.                                  |
+|                                                                             |
+|   On the target the two term products use the Cortex-R5 dual 16 bit MAC     |
+|   ( SMUAD / SMLAD ), elsewhere a model of the instructions in fixed width   |
+|   C types. Both wrap modulo 2^32, so the builds give identical results,     |
+|   see tests/host/test_dsp.c.                                                |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef fw_dsp_H
+#define fw_dsp_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "fw_types.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+#define DSP_Q15_ONE                 32768L              /* 1.0, not representable in a Q15 */
+#define DSP_Q15_MAX                 32767
+#define DSP_Q15_MIN                 ( -32768 )
+
+#define DSP_MOVAVG_LOG2_MAX         8u                  /* 256 samples, the Q31 sum cannot overflow */
+#define DSP_MEDIAN_MAX              9u
+
+#define DSP_GOERTZEL_Q              29u                 /* Coefficient 2 cos( w ) in -2 .. 2 */
+#define DSP_GOERTZEL_INPUT_MAX      2048L               /* |x|, with at most 4096 inputs per block */
+
+/* Two Q15 in one word: hi in bits 31:16, lo in bits 15:0 */
+#define DSP_PACK( hi, lo )          ( ( ( U32 ) ( U16 ) ( hi ) << 16 ) | ( U32 ) ( U16 ) ( lo ) )
+
+/* History sizes, in Q15 */
+#define DSP_MOVAVG_WORDS( channels, log2_length )   ( ( channels ) << ( log2_length ) )
+#define DSP_MEDIAN_WORDS( channels, length )        ( ( channels ) * ( length ) )
+
+/*----------------------------------------------------------------------------\
+|   Public Type Definitions                                                   |
+\----------------------------------------------------------------------------*/
+
+typedef S16                     Q15;
+typedef S32                     Q31;
+
+/* One pole low-pass y += a * ( x - y ). Q15 state, so a step smaller than
+ * 0.5 / a LSB leaves y short of x.
+ */
+typedef struct
+{
+    U32                         channels;
+    U32 *                       p_coef;             /* Per channel DSP_PACK( 1 - a, a ) */
+    Q15 *                       p_y;                /* Per channel output */
+} S_DSP_LOWPASS;
+
+/* Mean of the last 2^log2_length inputs */
+typedef struct
+{
+    U32                         channels;
+    U32                         log2_length;
+    U32                         index;              /* History row written next */
+    Q15 *                       p_history;          /* [ 2^log2_length ][ channels ] */
+    Q31 *                       p_sum;              /* Per channel sum of the history */
+    Q15 *                       p_y;
+} S_DSP_MOVAVG;
+
+/* Median of the last length inputs, length odd */
+typedef struct
+{
+    U32                         channels;
+    U32                         length;
+    U32                         index;
+    Q15 *                       p_history;          /* [ length ][ channels ] */
+    Q15 *                       p_y;
+} S_DSP_MEDIAN;
+
+/* Rate of change y = g * ( x - previous ) * 2^shift, saturated */
+typedef struct
+{
+    U32                         channels;
+    U32                         shift;              /* 0 .. 15 */
+    U32 *                       p_coef;             /* Per channel DSP_PACK( g, -g ) */
+    Q15 *                       p_previous;
+    Q15 *                       p_y;
+} S_DSP_RATE;
+
+/* Goertzel resonator of one frequency. The state grows with the block, at
+ * most DSP_GOERTZEL_INPUT_MAX * block, and is cleared by dspGoertzelAmplitude().
+ */
+typedef struct
+{
+    S32                         coef;               /* 2 cos( 2 pi f / fs ), Q29 */
+    S32                         s1;
+    S32                         s2;
+} S_DSP_GOERTZEL;
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+/* Dual 16 bit multiply and add: hi * hi + lo * lo ( + acc ) */
+#if defined( __TI_ARM__ )
+    #define DSP_SMUAD( x, y )           ( ( S32 ) _smuad( ( int ) ( x ), ( int ) ( y ) ) )
+    #define DSP_SMLAD( x, y, acc )      ( ( S32 ) _smlad( ( int ) ( x ), ( int ) ( y ), ( int ) ( acc ) ) )
+#else
+    #include <stdint.h>
+
+    #define DSP_SMUAD( x, y )           ( ( S32 ) dspSmlad( ( uint32_t ) ( x ), ( uint32_t ) ( y ), 0 ) )
+    #define DSP_SMLAD( x, y, acc )      ( ( S32 ) dspSmlad( ( uint32_t ) ( x ), ( uint32_t ) ( y ), ( int32_t ) ( acc ) ) )
+
+/* SMLAD in the widths of the instruction: 16 x 16 bit signed products, the
+ * sum wraps at 32 bits ( the Q flag is not modelled )
+ */
+static inline int32_t dspSmlad( uint32_t x, uint32_t y, int32_t acc )
+{
+    uint32_t hi = ( uint32_t ) ( ( int32_t ) ( int16_t ) ( uint16_t ) ( x >> 16 ) * ( int32_t ) ( int16_t ) ( uint16_t ) ( y >> 16 ) );
+    uint32_t lo = ( uint32_t ) ( ( int32_t ) ( int16_t ) ( uint16_t ) x * ( int32_t ) ( int16_t ) ( uint16_t ) y );
+
+    return ( int32_t ) ( ( uint32_t ) acc + hi + lo );
+}
+#endif
+
+/* s0 = x + coef * s1 - s2, the product in 64 bits ( SMULL ) */
+static inline void dspGoertzelStep( S_DSP_GOERTZEL *g, S32 x )
+{
+    S32 s0 = x + ( S32 ) ( ( ( S64 ) g->coef * g->s1 ) >> DSP_GOERTZEL_Q ) - g->s2;
+
+    g->s2 = g->s1;
+    g->s1 = s0;
+}
+
+static inline Q15 dspSat15( S32 x )
+{
+    if ( x > DSP_Q15_MAX )
+    {
+        return DSP_Q15_MAX;
+    }
+    if ( x < DSP_Q15_MIN )
+    {
+        return DSP_Q15_MIN;
+    }
+    return ( Q15 ) x;
+}
+
+BOOLEAN dspLowpassInit( S_DSP_LOWPASS *f, U32 channels, U32 *coef, Q15 *y, const Q15 *a );
+void dspLowpass( S_DSP_LOWPASS *f, const Q15 *x );
+
+BOOLEAN dspMovingAverageInit( S_DSP_MOVAVG *f, U32 channels, U32 log2_length, Q15 *history, Q31 *sum, Q15 *y );
+void dspMovingAverage( S_DSP_MOVAVG *f, const Q15 *x );
+
+BOOLEAN dspMedianInit( S_DSP_MEDIAN *f, U32 channels, U32 length, Q15 *history, Q15 *y );
+void dspMedian( S_DSP_MEDIAN *f, const Q15 *x );
+
+BOOLEAN dspRateInit( S_DSP_RATE *f, U32 channels, U32 shift, U32 *coef, Q15 *previous, Q15 *y, const Q15 *g );
+void dspRate( S_DSP_RATE *f, const Q15 *x );
+
+S32 dspGoertzelCoef( U32 frequency_hz, U32 sample_hz );
+void dspGoertzelInit( S_DSP_GOERTZEL *g, S32 coef );
+U32 dspGoertzelAmplitude( S_DSP_GOERTZEL *g, U32 block );
+U32 dspSqrt64( U64 x );
+
+/*----------------------------------------------------------------------------\
+|   End of fw_dsp.h header file                                               |
+\----------------------------------------------------------------------------*/
+
+#endif  /* fw_dsp_H */
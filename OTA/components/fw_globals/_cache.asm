@@ -0,0 +1,33 @@
+;-------------------------------------------------------------------------------
+; Data cache maintenance by address range
+;
+; The internal RAM is normal write back cacheable memory, so a buffer written
+; by the DMA has to be invalidated in the data cache before the CPU reads it.
+; Whole 32 byte lines are invalidated: such buffers must be 32 byte aligned and
+; a multiple of 32 bytes long, or dirty neighbouring data is lost.
+
+        .global     _dCacheInvalidateRange_
+        .text
+        .arm
+
+;-------------------------------------------------------------------------------
+; void _dCacheInvalidateRange_( const void *start, uint32 size )
+
+   .align 4
+_dCacheInvalidateRange_:
+        .asmfunc
+        ADD     A2, A1, A2          ; End of the range
+        BIC     A1, A1, #0x1F       ; First line
+        DSB
+
+_dcir_loop:
+        CMP     A1, A2
+        BHS     _dcir_done
+        MCR     p15, #0, A1, c7, c6, #1     ; DCIMVAC: invalidate line by address
+        ADD     A1, A1, #32
+        B       _dcir_loop
+
+_dcir_done:
+        DSB
+        BX      lr
+        .endasmfunc
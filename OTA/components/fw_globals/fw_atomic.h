@@ -0,0 +1,112 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_atomic.h Header File.                                   |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Lock-free primitives for the Cortex-R5 ( LDREX / STREX, DMB ).            |
+|   Everything here is safe to call from tasks and from ISRs.                 |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef fw_atomic_H
+#define fw_atomic_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "fw_types.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+/* Data memory barrier: orders a payload store against the index store that
+ * publishes it ( and the other way round on the consumer side ).
+ */
+#if defined( __TI_ARM__ )
+    #define ATOMIC_DMB()        asm( " DMB" )
+#else
+    #define ATOMIC_DMB()        __sync_synchronize()
+#endif
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+/* Single attempt compare and swap of a 32 bit word.
+ * Returns TRUE if *p_dst was 'expected' and has been replaced by 'desired'.
+ * A FALSE return may also mean the exclusive reservation was lost to an
+ * interrupt, so callers always retry in a loop after re-reading *p_dst.
+ */
+static inline BOOLEAN atomicCasU32( volatile U32 *p_dst, U32 expected, U32 desired )
+{
+#if defined( __TI_ARM__ )
+    if ( ( U32 ) __ldrex( ( void * ) p_dst ) != expected )
+    {
+        return FALSE;
+    }
+
+    return ( __strex( ( unsigned int ) desired, ( void * ) p_dst ) == 0 ) ? TRUE : FALSE;
+#else
+    return __sync_bool_compare_and_swap( p_dst, expected, desired ) ? TRUE : FALSE;
+#endif
+}
+
+/* Atomically adds 'value' to *p_dst and returns the previous contents.
+ */
+static inline U32 atomicFetchAddU32( volatile U32 *p_dst, U32 value )
+{
+    U32 old;
+
+    do
+    {
+        old = *p_dst;
+    } while ( atomicCasU32( p_dst, old, old + value ) == FALSE );
+
+    return old;
+}
+
+/* Atomically sets 'bits' in *p_dst.
+ */
+static inline void atomicOrU32( volatile U32 *p_dst, U32 bits )
+{
+    U32 old;
+
+    do
+    {
+        old = *p_dst;
+    } while ( atomicCasU32( p_dst, old, old | bits ) == FALSE );
+}
+
+/* Atomically replaces *p_dst by 'value' and returns the previous contents.
+ */
+static inline U32 atomicExchangeU32( volatile U32 *p_dst, U32 value )
+{
+    U32 old;
+
+    do
+    {
+        old = *p_dst;
+    } while ( atomicCasU32( p_dst, old, value ) == FALSE );
+
+    return old;
+}
+
+/*----------------------------------------------------------------------------\
+|   End of fw_atomic.h header file                                            |
+\----------------------------------------------------------------------------*/
+
+#endif  /* fw_atomic_H */
@@ -0,0 +1,54 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_cache.h Header File.                                    |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Cortex-R5 data cache maintenance for DMA buffers, see _cache.asm.         |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef fw_cache_H
+#define fw_cache_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "fw_types.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+#define CACHE_LINE_SIZE             32u                 /* Bytes */
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+/* Discards the cached copy of start .. start + size, whole lines. Privileged
+ * modes only. The range must be line aligned, see _cache.asm.
+ */
+#if defined( __TI_ARM__ )
+void _dCacheInvalidateRange_( const void *start, U32 size );
+#else
+#define _dCacheInvalidateRange_( start, size )
+#endif
+
+/*----------------------------------------------------------------------------\
+|   End of fw_cache.h header file                                             |
+\----------------------------------------------------------------------------*/
+
+#endif  /* fw_cache_H */
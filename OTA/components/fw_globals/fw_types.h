@@ -26,6 +26,10 @@
 |   Header Files                                                              |
 \----------------------------------------------------------------------------*/
 
+#if !defined( __TI_ARM__ )
+    #include <stdint.h>                 /* Host builds, see U32 below */
+#endif
+
 /*----------------------------------------------------------------------------\
 |   Public Constant Definitions                                               |
 \----------------------------------------------------------------------------*/
@@ -58,8 +62,14 @@ typedef signed char             S8;
 typedef char                    CHAR;
 typedef unsigned short          U16;
 typedef signed short            S16;
+#if defined( __TI_ARM__ )
 typedef unsigned long           U32;
 typedef signed long             S32;
+#else
+/* Host builds ( tests/host ): long is 64 bits on LP64 */
+typedef uint32_t                U32;
+typedef int32_t                 S32;
+#endif
 typedef unsigned long long      U64;
 typedef signed long long        S64;
 typedef float                   FLOAT;
@@ -68,7 +78,7 @@ typedef double                  DOUBLE;
 /* Added for general purpose application */
 typedef signed char             portInt8Type;
 typedef void *                  portTaskHandleType;
-typedef signed long             portBaseType;
+typedef signed long             portBaseType;         /* BaseType_t, long on the host too */
 typedef unsigned long           portUnsignedBaseType;
 
 /*----------------------------------------------------------------------------\
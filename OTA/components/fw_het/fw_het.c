@@ -0,0 +1,462 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_het.c Module File.                                      |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   N2HET1 hardware PWM and pulse trains.                                     |
+|                                                                             |
+|   Program of one channel, executed once per LR:                             |
+|                                                                             |
+|     [ DJZ   gate ]  pulse channels only; data = LR clocks left, jumps past  |
+|                     the channel when zero, so the CNT stays parked          |
+|       CNT   period  max = period - 1, counts into register A, GE compare    |
+|       ECMP  duty    compares A, pin low on match, high when the CNT wraps   |
+|                                                                             |
+|   The instruction formats are those of std_nhet.h. The last instruction     |
+|   of the program branches back to address 0.                                |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Compiler Controls                                                         |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "HL_reg_het.h"
+
+#include "fw_het.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    U32                         cnt;                /* HET RAM address of the CNT */
+    U32                         ecmp;               /* HET RAM address of the ECMP */
+    U32                         djz;                /* HET RAM address of the DJZ gate, pulse channels */
+    U32                         period_lr;          /* Current period in LR clocks */
+    BOOLEAN                     running;            /* Loaded into the HET program */
+} S_HET_PWM_STATE;
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define HET_RAM_INSTRUCTIONS        160u
+#define HET_CLOCKS_PER_LR           ( 1u << HET_LR_LOG2 )
+#define HET_PERIOD_LR_MIN           2u
+#define HET_DATA_MAX                0x01FFFFFFu         /* 25 bit data and max fields */
+
+/* Program word */
+#define HET_P_NEXT( addr )          ( ( U32 ) ( addr ) << 13 )
+#define HET_P_OPCODE( op )          ( ( U32 ) ( op ) << 9 )
+#define HET_OP_ECMP                 0x0u
+#define HET_OP_CNT                  0x6u
+#define HET_OP_DJZ                  0xAu
+#define HET_P_CNT_COMP_GE           ( 1u << 5 )         /* Wrap on count >= max, a shorter period applies at once */
+#define HET_P_ECMP_HR               ( 1u << 8 )         /* Match delayed by the HR part of the data */
+#define HET_P_DJZ_SUB               ( 2u << 6 )
+
+/* Control word */
+#define HET_C_COND( addr )          ( ( U32 ) ( addr ) << 13 )
+#define HET_C_EN_PIN_ACTION         ( 1u << 22 )
+#define HET_C_PIN( pin )            ( ( U32 ) ( pin ) << 8 )
+#define HET_C_OPPOSITE_ACTION       ( 1u << 3 )         /* Pin high when the CNT wraps */
+#define HET_C_REG_NONE              ( 3u << 1 )
+
+/* Data word: 25 bit LR value above a 7 bit HR field; the HR field keeps
+ * its top HET_LR_LOG2 bits, so HR clocks shifted left by the difference
+ * are the data word of a compare. */
+#define HET_D_LR( lr )              ( ( U32 ) ( lr ) << 7 )
+#define HET_D_HR( hr )              ( ( U32 ) ( hr ) << ( 7u - HET_LR_LOG2 ) )
+#define HET_D_VALUE( data )         ( ( data ) >> 7 )
+
+#define HET_GCR_ON                  0x00030001u         /* TO, CMS master, ignore suspend */
+#define HET_PFR_VALUE               ( ( U32 ) HET_LR_LOG2 << 8 )      /* LRPFC, HRPFC = /1 */
+
+/* Qualifier of the channel table, the host tests build it writable */
+#ifndef HET_PWM_CONFIG_CONST
+    #define HET_PWM_CONFIG_CONST    const
+#endif
+
+/* Channel table. Pins 5, 15, 17 and 31 of N2HET1 are GPIO in fw_dio.c */
+static HET_PWM_CONFIG_CONST S_HET_PWM_CONFIG het_pwm_config_defs[ eHET_PWM_MAX ] =
+{
+    [ eHET_PWM_HET1_0 ] =
+    {
+        .label = "N2HET1[0] heartbeat",             /* K18, N2HET1_00 in HL_pinmux.c */
+        .id = eHET_PWM_HET1_0,
+        .pin = 0u,
+        .mode = eHET_PWM_CONTINUOUS,
+        .period_ns = 2000000000u,                   /* 1 s on, 1 s off, was toggled by app_task_1000ms */
+        .duty_ns = 1000000000u,
+        .enabled = TRUE,
+    },
+    [ eHET_PWM_HET1_2 ] =
+    {
+        .label = "N2HET1[2] pulses",
+        .id = eHET_PWM_HET1_2,
+        .pin = 2u,
+        .mode = eHET_PWM_PULSES,
+        .period_ns = 10000u,                        /* Defaults of a train, hetPulseStart() sets its own */
+        .duty_ns = 1000u,
+        .enabled = FALSE,
+    },
+};
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static S_HET_PWM_STATE het_pwm_state[ eHET_PWM_MAX ];
+
+/*----------------------------------------------------------------------------\
+|   Private Function Declarations                                             |
+\----------------------------------------------------------------------------*/
+
+static U32 hetNsToHr( U32 ns );
+static U32 hetPeriodLr( U32 period_ns );
+static U32 hetDutyData( U32 duty_ns, U32 period_lr );
+static void hetLoad( U32 addr, U32 program, U32 control, U32 data );
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : hetPwmInit                                          |
+|                                                                             |
+|   Description         : Builds the HET program of the enabled channels,     |
+|                         loads it into N2HET1 RAM and starts N2HET1. Does    |
+|                         nothing when no channel is enabled.                 |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : After dioHandlerInit(), which owns the DIR bits     |
+|                         of the N2HET1 GPIO pins.                            |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void hetPwmInit( void )
+{
+    U32 i;
+    U32 addr = 0u;
+    U32 pins = 0u;
+    U32 size;
+    const S_HET_PWM_CONFIG *p_cfg;
+    S_HET_PWM_STATE *p_state;
+
+    memset( het_pwm_state, 0, sizeof( het_pwm_state ) );
+
+    hetREG1->GCR = 0u;                              /* Program loads only with the HET stopped */
+
+    for ( i = 0u; i < ( U32 ) eHET_PWM_MAX; i++ )
+    {
+        p_cfg = &het_pwm_config_defs[ i ];
+        p_state = &het_pwm_state[ i ];
+        size = ( p_cfg->mode == eHET_PWM_PULSES ) ? 3u : 2u;
+        if ( ( p_cfg->enabled == FALSE ) || ( p_cfg->pin > 31u ) || ( ( addr + size ) > HET_RAM_INSTRUCTIONS ) )
+        {
+            continue;
+        }
+
+        p_state->period_lr = hetPeriodLr( p_cfg->period_ns );
+
+        if ( p_cfg->mode == eHET_PWM_PULSES )
+        {
+            /* Gate closed: skip the CNT and ECMP, the pin holds low */
+            p_state->djz = addr;
+            hetLoad( addr, HET_P_NEXT( addr + 1u ) | HET_P_OPCODE( HET_OP_DJZ ) | HET_P_DJZ_SUB,
+                     HET_C_COND( addr + 3u ) | HET_C_REG_NONE, 0u );
+            addr++;
+        }
+
+        p_state->cnt = addr;
+        hetLoad( addr, HET_P_NEXT( addr + 1u ) | HET_P_OPCODE( HET_OP_CNT ) | HET_P_CNT_COMP_GE,
+                 p_state->period_lr - 1u, HET_D_LR( p_state->period_lr - 1u ) );
+        addr++;
+
+        p_state->ecmp = addr;
+        hetLoad( addr, HET_P_NEXT( addr + 1u ) | HET_P_OPCODE( HET_OP_ECMP ) | HET_P_ECMP_HR,
+                 HET_C_EN_PIN_ACTION | HET_C_COND( addr + 1u ) | HET_C_PIN( p_cfg->pin ) | HET_C_OPPOSITE_ACTION,
+                 hetDutyData( ( p_cfg->mode == eHET_PWM_PULSES ) ? 0u : p_cfg->duty_ns, p_state->period_lr ) );
+        addr++;
+
+        pins |= 1u << p_cfg->pin;
+        p_state->running = TRUE;
+    }
+
+    if ( pins == 0u )
+    {
+        return;
+    }
+
+    /* Close the loop: whatever pointed past the last instruction goes to 0 */
+    hetRAM1->Instruction[ addr - 1u ].Program &= ~HET_P_NEXT( 0x1FFu );
+    hetRAM1->Instruction[ addr - 1u ].Control &= ~HET_C_COND( 0x1FFu );
+    for ( i = 0u; i < ( U32 ) eHET_PWM_MAX; i++ )
+    {
+        p_state = &het_pwm_state[ i ];
+        if ( ( p_state->running != FALSE ) && ( het_pwm_config_defs[ i ].mode == eHET_PWM_PULSES ) &&
+             ( ( p_state->djz + 3u ) == addr ) )
+        {
+            hetRAM1->Instruction[ p_state->djz ].Control &= ~HET_C_COND( 0x1FFu );
+        }
+    }
+
+    hetREG1->PFR = HET_PFR_VALUE;
+    hetREG1->DCLR = pins;
+    hetREG1->DIR |= pins;
+    hetREG1->GCR = HET_GCR_ON;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : hetPwmGetConfig                                     |
+|                                                                             |
+|   Description         : Returns the channel table.                          |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : Table of eHET_PWM_MAX entries.                      |
+|                                                                             |
+|   Warnings            : None.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+const S_HET_PWM_CONFIG * const hetPwmGetConfig( void )
+{
+    return het_pwm_config_defs;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : hetPwmSet                                           |
+|                                                                             |
+|   Description         : Sets period and duty of a continuous channel. The   |
+|                         period in progress ends at the new max, or on the   |
+|                         next LR when the count is already past it.          |
+|                                                                             |
+|   Inputs              : id          - Channel.                              |
+|                         period_ns   - Period, 2 LR clocks at least.         |
+|                         duty_ns     - High time, clamped to the period.     |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : FALSE for a channel not running or not continuous.  |
+|                                                                             |
+|   Warnings            : The period in progress takes the new length, its    |
+|                         edge may fall at the old or the new duty.           |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN hetPwmSet( E_HET_PWM_ID id, U32 period_ns, U32 duty_ns )
+{
+    S_HET_PWM_STATE *p_state;
+    U32 period_lr;
+
+    if ( ( id >= eHET_PWM_MAX ) || ( het_pwm_state[ id ].running == FALSE ) ||
+         ( het_pwm_config_defs[ id ].mode != eHET_PWM_CONTINUOUS ) )
+    {
+        return FALSE;
+    }
+
+    p_state = &het_pwm_state[ id ];
+    period_lr = hetPeriodLr( period_ns );
+
+    /* The count is the HET's own: only the max moves, the count runs on */
+    hetRAM1->Instruction[ p_state->ecmp ].Data = hetDutyData( duty_ns, period_lr );
+    hetRAM1->Instruction[ p_state->cnt ].Control = period_lr - 1u;
+    p_state->period_lr = period_lr;
+
+    return TRUE;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : hetPwmSetDuty                                       |
+|                                                                             |
+|   Description         : Sets the duty of a continuous channel, from the     |
+|                         next compare on. The period is kept.                |
+|                                                                             |
+|   Inputs              : id          - Channel.                              |
+|                         duty_ns     - High time, clamped to the period.     |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : FALSE for a channel not running or not continuous.  |
+|                                                                             |
+|   Warnings            : None.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN hetPwmSetDuty( E_HET_PWM_ID id, U32 duty_ns )
+{
+    if ( ( id >= eHET_PWM_MAX ) || ( het_pwm_state[ id ].running == FALSE ) ||
+         ( het_pwm_config_defs[ id ].mode != eHET_PWM_CONTINUOUS ) )
+    {
+        return FALSE;
+    }
+
+    hetRAM1->Instruction[ het_pwm_state[ id ].ecmp ].Data = hetDutyData( duty_ns, het_pwm_state[ id ].period_lr );
+
+    return TRUE;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : hetPulseStart                                       |
+|                                                                             |
+|   Description         : Starts a train of count pulses on a pulse channel,  |
+|                         width_ns high every period_ns. A one-shot pulse is  |
+|                         a train of one.                                     |
+|                                                                             |
+|   Inputs              : id          - Channel.                              |
+|                         period_ns   - Pulse period, 2 LR clocks at least.   |
+|                         width_ns    - High time, clamped to the period.     |
+|                         count       - Pulses, 1 at least.                   |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : FALSE for a channel not running, not a pulse        |
+|                         channel, still busy, or a train too long for the    |
+|                         25 bit gate count.                                  |
+|                                                                             |
+|   Warnings            : None.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN hetPulseStart( E_HET_PWM_ID id, U32 period_ns, U32 width_ns, U32 count )
+{
+    S_HET_PWM_STATE *p_state;
+    U32 period_lr;
+
+    if ( ( id >= eHET_PWM_MAX ) || ( het_pwm_state[ id ].running == FALSE ) ||
+         ( het_pwm_config_defs[ id ].mode != eHET_PWM_PULSES ) || ( count == 0u ) || ( hetPulseBusy( id ) != FALSE ) )
+    {
+        return FALSE;
+    }
+
+    p_state = &het_pwm_state[ id ];
+    period_lr = hetPeriodLr( period_ns );
+    if ( count > ( HET_DATA_MAX / period_lr ) )
+    {
+        return FALSE;
+    }
+
+    /* Parked counter at max: the first LR through the gate wraps it, which
+     * raises the pin and starts the first pulse */
+    hetRAM1->Instruction[ p_state->ecmp ].Data = hetDutyData( width_ns, period_lr );
+    hetRAM1->Instruction[ p_state->cnt ].Control = period_lr - 1u;
+    hetRAM1->Instruction[ p_state->cnt ].Data = HET_D_LR( period_lr - 1u );
+    p_state->period_lr = period_lr;
+
+    /* Opening the gate last: the train runs count * period LR clocks */
+    hetRAM1->Instruction[ p_state->djz ].Data = HET_D_LR( count * period_lr );
+
+    return TRUE;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : hetPulseBusy                                        |
+|                                                                             |
+|   Description         : Tells whether a pulse train is still running.       |
+|                                                                             |
+|   Inputs              : id          - Channel.                              |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : TRUE while the gate is open.                        |
+|                                                                             |
+|   Warnings            : None.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN hetPulseBusy( E_HET_PWM_ID id )
+{
+    if ( ( id >= eHET_PWM_MAX ) || ( het_pwm_state[ id ].running == FALSE ) ||
+         ( het_pwm_config_defs[ id ].mode != eHET_PWM_PULSES ) )
+    {
+        return FALSE;
+    }
+
+    return ( HET_D_VALUE( hetRAM1->Instruction[ het_pwm_state[ id ].djz ].Data ) != 0u ) ? TRUE : FALSE;
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+/* ns to HR clocks, rounded to the nearest */
+static U32 hetNsToHr( U32 ns )
+{
+    return ( U32 ) ( ( ( ( U64 ) ns * HET_HR_HZ ) + 500000000u ) / 1000000000u );
+}
+
+/* Period in LR clocks, within what the CNT can count */
+static U32 hetPeriodLr( U32 period_ns )
+{
+    U32 lr = ( hetNsToHr( period_ns ) + ( HET_CLOCKS_PER_LR / 2u ) ) >> HET_LR_LOG2;
+
+    if ( lr < HET_PERIOD_LR_MIN )
+    {
+        lr = HET_PERIOD_LR_MIN;
+    }
+    else if ( lr > HET_DATA_MAX )
+    {
+        lr = HET_DATA_MAX;
+    }
+
+    return lr;
+}
+
+/* ECMP data of a high time. A compare at the period never matches: 100 % */
+static U32 hetDutyData( U32 duty_ns, U32 period_lr )
+{
+    U32 hr = hetNsToHr( duty_ns );
+
+    if ( hr >= ( period_lr << HET_LR_LOG2 ) )
+    {
+        return HET_D_LR( period_lr );
+    }
+
+    return HET_D_HR( hr );
+}
+
+static void hetLoad( U32 addr, U32 program, U32 control, U32 data )
+{
+    hetRAM1->Instruction[ addr ].Program = program;
+    hetRAM1->Instruction[ addr ].Control = control;
+    hetRAM1->Instruction[ addr ].Data = data;
+    hetRAM1->Instruction[ addr ].rsvd1 = 0u;
+}
+
+/*----------------------------------------------------------------------------\
+|   End of fw_het.c module                                                    |
+\----------------------------------------------------------------------------*/
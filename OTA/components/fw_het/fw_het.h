@@ -0,0 +1,96 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_het.h Header File.                                      |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   N2HET1 hardware PWM and pulse trains.                                     |
+|                                                                             |
+|   The HET program is built at init from the channel table of fw_het.c,      |
+|   one CNT and one ECMP per channel, plus a DJZ gate in front of pulse       |
+|   channels. Period, duty and pulse counts live in the instruction data      |
+|   fields; an update is a few stores into HET RAM and the pins move on the   |
+|   HET clock, not on task timing.                                            |
+|                                                                             |
+|   Times are in ns. The loop resolution ( LR ) is 32 HR clocks, 426.7 ns;    |
+|   edges land on the HR clock, 13.3 ns at VCLK2 = 75 MHz.                    |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef fw_het_H
+#define fw_het_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "HL_hal_stdtypes.h"
+
+#include "fw_types.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Type Definitions                                                   |
+\----------------------------------------------------------------------------*/
+
+typedef enum
+{
+    eHET_PWM_HET1_0 = 0u,
+    eHET_PWM_HET1_2,
+    eHET_PWM_MAX,
+} E_HET_PWM_ID;
+
+typedef enum
+{
+    eHET_PWM_CONTINUOUS = 0u,           /* Free running PWM */
+    eHET_PWM_PULSES,                    /* Idle low, hetPulseStart() runs N periods */
+} E_HET_PWM_MODE;
+
+typedef struct
+{
+    CHAR                        label[ 32u ];
+    E_HET_PWM_ID                id;
+    U8                          pin;                /* N2HET1 pin, 0 .. 31 */
+    E_HET_PWM_MODE              mode;
+    U32                         period_ns;
+    U32                         duty_ns;            /* High time per period */
+    BOOLEAN                     enabled;
+} S_HET_PWM_CONFIG;
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+#define HET_HR_HZ                   75000000u           /* HR clock, VCLK2 / 1 */
+#define HET_LR_LOG2                 5u                  /* LR = 32 HR clocks */
+
+/*----------------------------------------------------------------------------\
+|   Public Data Declarations                                                  |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+void hetPwmInit( void );
+const S_HET_PWM_CONFIG * const hetPwmGetConfig( void );
+BOOLEAN hetPwmSet( E_HET_PWM_ID id, U32 period_ns, U32 duty_ns );
+BOOLEAN hetPwmSetDuty( E_HET_PWM_ID id, U32 duty_ns );
+BOOLEAN hetPulseStart( E_HET_PWM_ID id, U32 period_ns, U32 width_ns, U32 count );
+BOOLEAN hetPulseBusy( E_HET_PWM_ID id );
+
+/*----------------------------------------------------------------------------\
+|   End of fw_het.h header file                                               |
+\----------------------------------------------------------------------------*/
+
+#endif  /* fw_het_H */
@@ -0,0 +1,305 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_log.c Module File.                                      |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Deferred formatting binary logger.                                        |
+|                                                                             |
+|   Same slot protocol as fw_trace: writers reserve with LDREX / STREX on     |
+|   the ring head and commit by writing the message id last, logDrain() is    |
+|   the only reader. A full ring drops the new record and counts it.          |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Compiler Controls                                                         |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "fw_atomic.h"
+#include "fw_utils.h"
+#include "fw_uart.h"
+#include "fw_log.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    U8                  module;             /* E_LOG_MODULE */
+    U8                  level;              /* E_LOG_LEVEL */
+} S_LOG_MSG_DEF;
+
+typedef struct
+{
+    S_LOG_RECORD *      p_records;
+    U32                 mask;
+    volatile U32        head;               /* Next record to reserve, free running */
+    volatile U32        tail;               /* Next record to drain, free running */
+} S_LOG_RING;
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define LOG_DRAIN_MAX_RECORDS       ( UART_FRAME_PAYLOAD_SIZE / sizeof( S_LOG_RECORD ) )
+
+#define LOG_TIMESTAMP()             ( rtiREG1->CNT[ 0 ].FRCx )
+
+/* Module and level of every message, the format strings stay on the host */
+#define LOG_MSG( id, module, level, format )    { ( module ), ( level ) },
+static const S_LOG_MSG_DEF log_msg_defs[ eLOG_MSG_MAX ] =
+{
+    LOG_MESSAGES
+};
+#undef LOG_MSG
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static S_LOG_RECORD log_high_records[ LOG_HIGH_RING_RECORDS ];
+static S_LOG_RECORD log_low_records[ LOG_LOW_RING_RECORDS ];
+
+static S_LOG_RING log_rings[ eLOG_RING_MAX ] =
+{
+    { .p_records = log_high_records, .mask = LOG_HIGH_RING_RECORDS - 1u, },
+    { .p_records = log_low_records,  .mask = LOG_LOW_RING_RECORDS - 1u,  },
+};
+
+static volatile U32 log_level = LOG_DEFAULT_LEVEL;
+static volatile U32 log_module_mask = LOG_DEFAULT_MODULES;
+
+static S_LOG_STATS log_stats;
+static U32 log_dropped_reported[ eLOG_RING_MAX ];
+
+static S_LOG_RECORD log_frame[ LOG_DRAIN_MAX_RECORDS ];
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Private Function Declarations                                             |
+\----------------------------------------------------------------------------*/
+
+static U32 logCollect( E_LOG_RING ring, U32 count );
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+void logInit( void )
+{
+    U32 i;
+
+    memset( log_high_records, 0, sizeof( log_high_records ) );
+    memset( log_low_records, 0, sizeof( log_low_records ) );
+    memset( &log_stats, 0, sizeof( log_stats ) );
+
+    for ( i = 0u; i < eLOG_RING_MAX; i++ )
+    {
+        log_rings[ i ].head = 0u;
+        log_rings[ i ].tail = 0u;
+        log_dropped_reported[ i ] = 0u;
+    }
+
+    log_level = LOG_DEFAULT_LEVEL;
+    log_module_mask = LOG_DEFAULT_MODULES;
+}
+
+void logSetLevel( E_LOG_LEVEL level )
+{
+    log_level = level;
+}
+
+void logSetModuleMask( U32 mask )
+{
+    log_module_mask = mask;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : logWrite                                            |
+|                                                                             |
+|   Description         : Filters the message on level and module and stores  |
+|                         it with its raw arguments. Use the LOG0 .. LOG3     |
+|                         macros rather than calling this directly.           |
+|                                                                             |
+|   Inputs              : Message id.                                         |
+|                         Number of valid arguments ( 0 .. LOG_MAX_ARGS ).    |
+|                         Arguments.                                          |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Safe from tasks and ISRs, never blocks.             |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void logWrite( E_LOG_MSG_ID id, U32 nargs, U32 arg0, U32 arg1, U32 arg2 )
+{
+    U32 head;
+    E_LOG_RING ring;
+    S_LOG_RING *p_ring;
+    S_LOG_RECORD *p_rec;
+    const S_LOG_MSG_DEF *p_def;
+
+    if ( ( id == eLOG_MSG_NONE ) || ( id >= eLOG_MSG_MAX ) )
+    {
+        return;
+    }
+
+    p_def = &log_msg_defs[ id ];
+    if ( ( p_def->level > log_level ) || ( ( log_module_mask & ( 1u << p_def->module ) ) == 0u ) )
+    {
+        atomicFetchAddU32( &log_stats.filtered, 1u );
+        return;
+    }
+
+    ring = ( p_def->level <= eLOG_LEVEL_WARNING ) ? eLOG_RING_HIGH : eLOG_RING_LOW;
+    p_ring = &log_rings[ ring ];
+
+    do
+    {
+        head = p_ring->head;
+        if ( ( head - p_ring->tail ) > p_ring->mask )
+        {
+            atomicFetchAddU32( &log_stats.dropped[ ring ], 1u );
+            return;
+        }
+    } while ( atomicCasU32( &p_ring->head, head, head + 1u ) == FALSE );
+
+    p_rec = &p_ring->p_records[ head & p_ring->mask ];
+    p_rec->timestamp = LOG_TIMESTAMP();
+    p_rec->nargs = ( U8 ) nargs;
+    p_rec->args[ 0 ] = arg0;
+    p_rec->args[ 1 ] = arg1;
+    p_rec->args[ 2 ] = arg2;
+
+    ATOMIC_DMB();
+    p_rec->id = ( U16 ) id;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : logDrain                                            |
+|                                                                             |
+|   Description         : Sends one UART frame ( stream eUART_STREAM_LOG )    |
+|                         of committed records, errors and warnings first.    |
+|                         Drops since the previous frame are reported with    |
+|                         an eLOG_MSG_DROPPED record per ring.                |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : TRUE if a frame was sent.                           |
+|                                                                             |
+|   Warnings            : Single consumer, call from one task only.           |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN logDrain( void )
+{
+    U32 i;
+    U32 count = 0u;
+    U32 dropped;
+
+    if ( uartIsTxIdle( LOG_DRAIN_UART ) == FALSE )
+    {
+        return FALSE;
+    }
+
+    for ( i = 0u; i < eLOG_RING_MAX; i++ )
+    {
+        dropped = log_stats.dropped[ i ];
+        if ( dropped != log_dropped_reported[ i ] )
+        {
+            log_frame[ count ].timestamp = LOG_TIMESTAMP();
+            log_frame[ count ].id = eLOG_MSG_DROPPED;
+            log_frame[ count ].nargs = 2u;
+            log_frame[ count ].reserved = 0u;
+            log_frame[ count ].args[ 0 ] = i;
+            log_frame[ count ].args[ 1 ] = dropped;
+            log_frame[ count ].args[ 2 ] = 0u;
+            log_dropped_reported[ i ] = dropped;
+            count++;
+        }
+    }
+
+    count = logCollect( eLOG_RING_HIGH, count );
+    count = logCollect( eLOG_RING_LOW, count );
+
+    if ( count == 0u )
+    {
+        return FALSE;
+    }
+
+    return uartSendFrame( LOG_DRAIN_UART, eUART_STREAM_LOG, ( const U8 * ) log_frame, ( U16 ) ( count * sizeof( S_LOG_RECORD ) ) );
+}
+
+const S_LOG_STATS * logGetStats( void )
+{
+    U32 i;
+
+    for ( i = 0u; i < eLOG_RING_MAX; i++ )
+    {
+        log_stats.written[ i ] = log_rings[ i ].head;
+    }
+
+    return &log_stats;
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+/* Moves committed records of one ring into the frame, returns the new count */
+static U32 logCollect( E_LOG_RING ring, U32 count )
+{
+    S_LOG_RING *p_ring = &log_rings[ ring ];
+    S_LOG_RECORD *p_rec;
+
+    while ( count < LOG_DRAIN_MAX_RECORDS )
+    {
+        p_rec = &p_ring->p_records[ p_ring->tail & p_ring->mask ];
+        if ( p_rec->id == eLOG_MSG_NONE )
+        {
+            break;
+        }
+
+        ATOMIC_DMB();
+        log_frame[ count++ ] = *p_rec;
+        p_rec->id = eLOG_MSG_NONE;
+
+        ATOMIC_DMB();
+        p_ring->tail++;
+    }
+
+    return count;
+}
+
+/*----------------------------------------------------------------------------\
+|   End of fw_log.c module                                                    |
+\----------------------------------------------------------------------------*/
@@ -0,0 +1,128 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_log.h Header File.                                      |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Deferred formatting binary logger.                                        |
+|                                                                             |
+|   A log call stores a message id ( fw_log_msgs.h ) and up to three raw      |
+|   32 bit arguments in a lock-free ring, no formatting happens on the        |
+|   target. Errors and warnings go to their own ring so that a burst of       |
+|   debug output cannot push them out. logDrain() ships the records over      |
+|   UART and tools/log_decode.py turns them back into text.                   |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef fw_log_H
+#define fw_log_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "fw_types.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+#define LOG_MAX_ARGS                3u
+#define LOG_HIGH_RING_RECORDS       32u                 /* Errors and warnings, power of two */
+#define LOG_LOW_RING_RECORDS        64u                 /* Info and debug, power of two */
+#define LOG_DRAIN_UART              eUART_2             /* Shared with fw_trace, see fw_trace.h */
+#define LOG_DEFAULT_LEVEL           eLOG_LEVEL_INFO
+#define LOG_DEFAULT_MODULES         0xFFFFFFFFu         /* Bit per E_LOG_MODULE */
+
+/*----------------------------------------------------------------------------\
+|   Public Type Definitions                                                   |
+\----------------------------------------------------------------------------*/
+
+typedef enum
+{
+    eLOG_LEVEL_ERROR = 0u,
+    eLOG_LEVEL_WARNING,
+    eLOG_LEVEL_INFO,
+    eLOG_LEVEL_DEBUG,
+    eLOG_LEVEL_MAX,
+} E_LOG_LEVEL;
+
+/* Note: at most 32 modules, each one is a bit of the module filter mask */
+typedef enum
+{
+    eLOG_MOD_MAIN = 0u,
+    eLOG_MOD_OS,
+    eLOG_MOD_TASKS,
+    eLOG_MOD_DIO,
+    eLOG_MOD_ADC,
+    eLOG_MOD_UART,
+    eLOG_MOD_APP,
+    eLOG_MOD_MAX,
+} E_LOG_MODULE;
+
+typedef enum
+{
+    eLOG_RING_HIGH = 0u,                    /* eLOG_LEVEL_ERROR, eLOG_LEVEL_WARNING */
+    eLOG_RING_LOW,                          /* eLOG_LEVEL_INFO, eLOG_LEVEL_DEBUG */
+    eLOG_RING_MAX,
+} E_LOG_RING;
+
+#include "fw_log_msgs.h"
+
+#define LOG_MSG( id, module, level, format )    id,
+typedef enum
+{
+    LOG_MESSAGES
+    eLOG_MSG_MAX,
+} E_LOG_MSG_ID;
+#undef LOG_MSG
+
+/* Ring record ( 20 bytes, big endian on the wire: ">IHBB3I" ) */
+typedef struct
+{
+    U32                 timestamp;          /* RTI counter 0 free running counter */
+    U16                 id;                 /* E_LOG_MSG_ID, written last to commit the record */
+    U8                  nargs;
+    U8                  reserved;
+    U32                 args[ LOG_MAX_ARGS ];
+} S_LOG_RECORD;
+
+typedef struct
+{
+    U32                 written[ eLOG_RING_MAX ];
+    U32                 dropped[ eLOG_RING_MAX ];       /* Ring full */
+    U32                 filtered;                       /* Below level or module masked */
+} S_LOG_STATS;
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+void logInit( void );
+void logSetLevel( E_LOG_LEVEL level );
+void logSetModuleMask( U32 mask );
+void logWrite( E_LOG_MSG_ID id, U32 nargs, U32 arg0, U32 arg1, U32 arg2 );
+BOOLEAN logDrain( void );
+const S_LOG_STATS * logGetStats( void );
+
+#define LOG0( id )                  logWrite( ( id ), 0u, 0u, 0u, 0u )
+#define LOG1( id, a )               logWrite( ( id ), 1u, ( U32 ) ( a ), 0u, 0u )
+#define LOG2( id, a, b )            logWrite( ( id ), 2u, ( U32 ) ( a ), ( U32 ) ( b ), 0u )
+#define LOG3( id, a, b, c )         logWrite( ( id ), 3u, ( U32 ) ( a ), ( U32 ) ( b ), ( U32 ) ( c ) )
+
+/*----------------------------------------------------------------------------\
+|   End of fw_log.h header file                                               |
+\----------------------------------------------------------------------------*/
+
+#endif  /* fw_log_H */
@@ -0,0 +1,68 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_log_msgs.h Header File.                                 |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Log message table.                                                        |
+|                                                                             |
+|   One LOG_MSG( id, module, level, format ) line per message. The target     |
+|   only keeps module and level, the format strings are compiled out and      |
+|   read back by tools/log_decode.py, which parses this file. Arguments are   |
+|   32 bit integers ( at most LOG_MAX_ARGS ), so use %d, %u, %x but no %s.    |
+|                                                                             |
+|   The position in the table is the message id on the wire, so append new   |
+|   messages at the end and never reorder or delete lines.                    |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef fw_log_msgs_H
+#define fw_log_msgs_H
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+#define LOG_MESSAGES \
+    LOG_MSG( eLOG_MSG_NONE,                 eLOG_MOD_OS,    eLOG_LEVEL_ERROR,   "" ) \
+    LOG_MSG( eLOG_MSG_DROPPED,              eLOG_MOD_OS,    eLOG_LEVEL_WARNING, "Log ring %u dropped %u records in total" ) \
+    LOG_MSG( eLOG_MSG_DIO_INPUTS_INIT,      eLOG_MOD_MAIN,  eLOG_LEVEL_INFO,    "Initializing Digital Inputs" ) \
+    LOG_MSG( eLOG_MSG_DIO_OUTPUTS_INIT,     eLOG_MOD_MAIN,  eLOG_LEVEL_INFO,    "Initializing Digital Outputs" ) \
+    LOG_MSG( eLOG_MSG_CORE_INFO_INIT,       eLOG_MOD_MAIN,  eLOG_LEVEL_INFO,    "Initializing core information" ) \
+    LOG_MSG( eLOG_MSG_PROC_DATA_INIT,       eLOG_MOD_MAIN,  eLOG_LEVEL_INFO,    "Initializing process data of all FreeRTOS tasks" ) \
+    LOG_MSG( eLOG_MSG_CORE_MAIN_START,      eLOG_MOD_MAIN,  eLOG_LEVEL_INFO,    "Core %u scheduler state: MAIN START" ) \
+    LOG_MSG( eLOG_MSG_CORE_STACK_INIT,      eLOG_MOD_MAIN,  eLOG_LEVEL_INFO,    "Initializing the core's stack for FreeRTOS use" ) \
+    LOG_MSG( eLOG_MSG_CORE_INITIALIZED,     eLOG_MOD_MAIN,  eLOG_LEVEL_INFO,    "Core %u scheduler state: INITIALIZED" ) \
+    LOG_MSG( eLOG_MSG_CORE_CREATE_TASKS,    eLOG_MOD_MAIN,  eLOG_LEVEL_INFO,    "Creating core's FreeRTOS tasks" ) \
+    LOG_MSG( eLOG_MSG_CORE_RUNNING,         eLOG_MOD_MAIN,  eLOG_LEVEL_INFO,    "Core %u scheduler state: RUNNING" ) \
+    LOG_MSG( eLOG_MSG_CORE_SCHED_FAILED,    eLOG_MOD_MAIN,  eLOG_LEVEL_ERROR,   "Core %u scheduler state: FAILED" ) \
+    LOG_MSG( eLOG_MSG_TASK_CREATED,         eLOG_MOD_OS,    eLOG_LEVEL_INFO,    "Successfully created task id %u" ) \
+    LOG_MSG( eLOG_MSG_TASK_CREATE_FAILED,   eLOG_MOD_OS,    eLOG_LEVEL_ERROR,   "Unsuccessfully created task id %u. Error: %d" ) \
+    LOG_MSG( eLOG_MSG_TASK_INIT,            eLOG_MOD_OS,    eLOG_LEVEL_INFO,    "Calling init function of task id %u" ) \
+    LOG_MSG( eLOG_MSG_TASK_OVERRUN,         eLOG_MOD_TASKS, eLOG_LEVEL_WARNING, "Task overrun: task id %u, period %u ticks, call %u" ) \
+    LOG_MSG( eLOG_MSG_TASK_CALLCOUNT,       eLOG_MOD_TASKS, eLOG_LEVEL_DEBUG,   "Task id %u callcount: %u" ) \
+    LOG_MSG( eLOG_MSG_TRACE_QUEUE_ERROR,    eLOG_MOD_TASKS, eLOG_LEVEL_WARNING, "Task id %u - Serial Debug Queue Error: %d" ) \
+    LOG_MSG( eLOG_MSG_UART_RX_FRAME,        eLOG_MOD_UART,  eLOG_LEVEL_DEBUG,   "UART %u received frame of %u bytes" ) \
+    LOG_MSG( eLOG_MSG_FPU_UNMARKED_USE,     eLOG_MOD_OS,    eLOG_LEVEL_ERROR,   "VFP used without FPU context: TCB 0x%08x, pc 0x%08x, mode 0x%02x" ) \
+    LOG_MSG( eLOG_MSG_ADC_INIT,             eLOG_MOD_MAIN,  eLOG_LEVEL_INFO,    "Initializing ADC units" ) \
+    LOG_MSG( eLOG_MSG_ADC_ALARM,            eLOG_MOD_ADC,   eLOG_LEVEL_WARNING, "ADC alarm %u active %u, reaction %u ticks" ) \
+    LOG_MSG( eLOG_MSG_HET_INIT,             eLOG_MOD_MAIN,  eLOG_LEVEL_INFO,    "Initializing N2HET PWM channels" ) \
+    LOG_MSG( eLOG_MSG_CTX_BENCH,            eLOG_MOD_OS,    eLOG_LEVEL_INFO,    "Context switch, FPU context %u: %u cycles" ) \
+    LOG_MSG( eLOG_MSG_CTX_BENCH_FAILED,     eLOG_MOD_OS,    eLOG_LEVEL_ERROR,   "Context switch benchmark tasks not created" )
+
+/*----------------------------------------------------------------------------\
+|   End of fw_log_msgs.h header file                                          |
+\----------------------------------------------------------------------------*/
+
+#endif  /* fw_log_msgs_H */
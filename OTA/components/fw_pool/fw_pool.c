@@ -0,0 +1,367 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_pool.c Module File.                                     |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Fixed block memory pools.                                                 |
+|                                                                             |
+|   All classes share one storage array, class after class, so poolOwns()     |
+|   is a range check and the class of a block follows from its address.       |
+|   A free block holds the link to the next one in its first word; the        |
+|   free list of a class is a LIFO, a push to release, a pop to allocate.     |
+|                                                                             |
+|   The storage sits in .kernelHEAP with the heap_4 array it partly           |
+|   replaces.                                                                 |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Compiler Controls                                                         |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "os_task.h"
+
+#include "HL_sys_core.h"
+
+#include "fw_pool.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+/* The classes of pool_defs; the storage is sized from the same numbers */
+#define POOL_32_BLOCK_SIZE          32u
+#define POOL_32_BLOCKS              32u
+#define POOL_64_BLOCK_SIZE          64u
+#define POOL_64_BLOCKS              16u
+#define POOL_128_BLOCK_SIZE         128u
+#define POOL_128_BLOCKS             8u
+#define POOL_256_BLOCK_SIZE         POOL_BLOCK_MAX
+#define POOL_256_BLOCKS             4u
+
+#define POOL_STORAGE_BYTES          ( ( POOL_32_BLOCK_SIZE * POOL_32_BLOCKS ) + ( POOL_64_BLOCK_SIZE * POOL_64_BLOCKS ) + \
+                                      ( POOL_128_BLOCK_SIZE * POOL_128_BLOCKS ) + ( POOL_256_BLOCK_SIZE * POOL_256_BLOCKS ) )
+
+#define POOL_LOCK_NONE              0u                  /* In an interrupt */
+#define POOL_LOCK_CRITICAL          1u                  /* Task */
+#define POOL_LOCK_IRQ               2u                  /* main(), before the scheduler */
+
+#define POOL_CPSR_MODE_MASK         0x1Fu
+#define POOL_CPSR_MODE_IRQ          0x12u
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+typedef struct S_POOL_BLOCK
+{
+    struct S_POOL_BLOCK *       next;
+} S_POOL_BLOCK;
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+/* In ascending block size: the search for a block walks up from the first fit */
+static const S_POOL_DEF pool_defs[ ePOOL_MAX ] =
+{
+    [ ePOOL_32 ] =
+    {
+        .block_size = POOL_32_BLOCK_SIZE,
+        .blocks = POOL_32_BLOCKS,
+    },
+    [ ePOOL_64 ] =
+    {
+        .block_size = POOL_64_BLOCK_SIZE,
+        .blocks = POOL_64_BLOCKS,
+    },
+    [ ePOOL_128 ] =
+    {
+        .block_size = POOL_128_BLOCK_SIZE,
+        .blocks = POOL_128_BLOCKS,
+    },
+    [ ePOOL_256 ] =
+    {
+        .block_size = POOL_256_BLOCK_SIZE,
+        .blocks = POOL_256_BLOCKS,
+    },
+};
+
+#pragma DATA_SECTION( pool_storage, ".kernelHEAP" )
+static U64 pool_storage[ POOL_STORAGE_BYTES / sizeof( U64 ) ];     /* U64 for the 8 byte alignment of portBYTE_ALIGNMENT */
+
+static U8 *pool_base[ ePOOL_MAX ];
+static S_POOL_BLOCK *pool_free[ ePOOL_MAX ];
+static S_POOL_STATS pool_stats[ ePOOL_MAX ];
+
+/*----------------------------------------------------------------------------\
+|   Private Function Declarations                                             |
+\----------------------------------------------------------------------------*/
+
+static U32 poolLock( void );
+static void poolUnlock( U32 lock );
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : poolInit                                            |
+|                                                                             |
+|   Description         : Carves the storage into the classes of pool_defs    |
+|                         and threads every block onto its free list.         |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Called once from main(), before the scheduler       |
+|                         starts and before any pool user.                    |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void poolInit( void )
+{
+    U8 *p_block = ( U8 * ) pool_storage;
+    U32 id;
+    U32 i;
+
+    for ( id = 0u; id < ( U32 ) ePOOL_MAX; id++ )
+    {
+        pool_base[ id ] = p_block;
+        pool_free[ id ] = NULL;
+
+        /* Threaded from the top down, so the first allocations come from the bottom */
+        for ( i = pool_defs[ id ].blocks; i > 0u; i-- )
+        {
+            S_POOL_BLOCK *block = ( S_POOL_BLOCK * ) &p_block[ ( i - 1u ) * pool_defs[ id ].block_size ];
+
+            block->next = pool_free[ id ];
+            pool_free[ id ] = block;
+        }
+
+        p_block += pool_defs[ id ].blocks * pool_defs[ id ].block_size;
+
+        memset( &pool_stats[ id ], 0, sizeof( pool_stats[ id ] ) );
+        pool_stats[ id ].free = pool_defs[ id ].blocks;
+    }
+
+    configASSERT( p_block == ( ( U8 * ) pool_storage + sizeof( pool_storage ) ) );
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : poolAlloc                                           |
+|                                                                             |
+|   Description         : Takes a block from the smallest class that holds    |
+|                         size bytes, or from the next class up with a free   |
+|                         block. Fixed time: a pop per class tried.           |
+|                                                                             |
+|   Inputs              : size        - Bytes needed.                         |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : The block, 8 byte aligned, or NULL when size is     |
+|                         above POOL_BLOCK_MAX or every fitting class is      |
+|                         empty.                                              |
+|                                                                             |
+|   Warnings            : Callable from tasks and interrupts.                 |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void *poolAlloc( U32 size )
+{
+    S_POOL_BLOCK *block = NULL;
+    U32 first;
+    U32 id;
+    U32 used;
+    U32 lock;
+
+    for ( first = 0u; first < ( U32 ) ePOOL_MAX; first++ )
+    {
+        if ( size <= pool_defs[ first ].block_size )
+        {
+            break;
+        }
+    }
+
+    if ( first == ( U32 ) ePOOL_MAX )
+    {
+        return NULL;
+    }
+
+    lock = poolLock();
+
+    for ( id = first; id < ( U32 ) ePOOL_MAX; id++ )
+    {
+        block = pool_free[ id ];
+
+        if ( block != NULL )
+        {
+            pool_free[ id ] = block->next;
+
+            pool_stats[ id ].free--;
+            pool_stats[ id ].allocs++;
+            used = pool_defs[ id ].blocks - pool_stats[ id ].free;
+            if ( used > pool_stats[ id ].used_max )
+            {
+                pool_stats[ id ].used_max = used;
+            }
+            break;
+        }
+
+        pool_stats[ id ].spills++;
+    }
+
+    if ( block == NULL )
+    {
+        pool_stats[ first ].failures++;
+    }
+
+    poolUnlock( lock );
+
+    return block;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : poolFree                                            |
+|                                                                             |
+|   Description         : Returns a block to the free list of its class.      |
+|                                                                             |
+|   Inputs              : p           - Block from poolAlloc().               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : FALSE if p is not the start of a pool block; it is  |
+|                         left alone.                                         |
+|                                                                             |
+|   Warnings            : Callable from tasks and interrupts. A block freed   |
+|                         twice is not detected.                              |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN poolFree( void *p )
+{
+    S_POOL_BLOCK *block = ( S_POOL_BLOCK * ) p;
+    U32 id;
+    U32 lock;
+
+    if ( poolOwns( p ) == FALSE )
+    {
+        return FALSE;
+    }
+
+    for ( id = ( U32 ) ePOOL_MAX - 1u; ( U8 * ) p < pool_base[ id ]; id-- )
+    {
+    }
+
+    if ( ( ( U32 ) ( ( U8 * ) p - pool_base[ id ] ) % pool_defs[ id ].block_size ) != 0u )
+    {
+        return FALSE;
+    }
+
+    lock = poolLock();
+
+    block->next = pool_free[ id ];
+    pool_free[ id ] = block;
+    pool_stats[ id ].free++;
+
+    poolUnlock( lock );
+
+    return TRUE;
+}
+
+/* TRUE if p points into the pool storage */
+BOOLEAN poolOwns( const void *p )
+{
+    const U8 *p_byte = ( const U8 * ) p;
+
+    return ( ( p_byte >= ( const U8 * ) pool_storage ) &&
+             ( p_byte < ( ( const U8 * ) pool_storage + sizeof( pool_storage ) ) ) ) ? TRUE : FALSE;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : poolGetConfig                                       |
+|                                                                             |
+|   Description         : Returns the class table.                            |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : Table of ePOOL_MAX entries.                         |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+const S_POOL_DEF * const poolGetConfig( void )
+{
+    return pool_defs;
+}
+
+/* Counters of one class; a snapshot, read without a lock */
+const S_POOL_STATS * poolGetStats( E_POOL_ID id )
+{
+    return ( id < ePOOL_MAX ) ? &pool_stats[ id ] : NULL;
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+static U32 poolLock( void )
+{
+    if ( ( _getCPSRValue_() & POOL_CPSR_MODE_MASK ) == POOL_CPSR_MODE_IRQ )
+    {
+        return POOL_LOCK_NONE;
+    }
+
+    if ( xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED )
+    {
+        _disable_IRQ_interrupt_();
+        return POOL_LOCK_IRQ;
+    }
+
+    taskENTER_CRITICAL();
+
+    return POOL_LOCK_CRITICAL;
+}
+
+static void poolUnlock( U32 lock )
+{
+    if ( lock == POOL_LOCK_CRITICAL )
+    {
+        taskEXIT_CRITICAL();
+    }
+    else if ( lock == POOL_LOCK_IRQ )
+    {
+        _enable_IRQ_interrupt_();
+    }
+}
+
+/*----------------------------------------------------------------------------\
+|   End of fw_pool.c module                                                   |
+\----------------------------------------------------------------------------*/
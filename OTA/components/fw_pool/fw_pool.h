@@ -0,0 +1,89 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_pool.h Header File.                                     |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Fixed block memory pools.                                                 |
+|                                                                             |
+|   A few size classes, each a free list of equal blocks: allocation and      |
+|   release are O(1) whatever the history, and callable from interrupts.      |
+|   A request takes the smallest class that fits, the next one up when that   |
+|   class is empty.                                                           |
+|                                                                             |
+|   Once the scheduler runs, pvPortMalloc() ( os_heap.c ) takes its blocks    |
+|   from here, and heap_4 only serves what no class can. Frames and events    |
+|   can use poolAlloc() directly.                                             |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef fw_pool_H
+#define fw_pool_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "fw_types.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Type Definitions                                                   |
+\----------------------------------------------------------------------------*/
+
+typedef enum
+{
+    ePOOL_32 = 0u,
+    ePOOL_64,
+    ePOOL_128,
+    ePOOL_256,
+    ePOOL_MAX,
+} E_POOL_ID;
+
+typedef struct
+{
+    U32                         block_size;         /* Bytes, a multiple of 8 */
+    U32                         blocks;
+} S_POOL_DEF;
+
+typedef struct
+{
+    U32                         free;
+    U32                         used_max;           /* High-water mark */
+    U32                         allocs;
+    U32                         spills;             /* Found empty, a larger class tried */
+    U32                         failures;           /* No block here nor above */
+} S_POOL_STATS;
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+#define POOL_BLOCK_MAX              256u                /* Largest class */
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+void poolInit( void );
+void *poolAlloc( U32 size );
+BOOLEAN poolFree( void *p );
+BOOLEAN poolOwns( const void *p );
+const S_POOL_DEF * const poolGetConfig( void );
+const S_POOL_STATS * poolGetStats( E_POOL_ID id );
+
+/*----------------------------------------------------------------------------\
+|   End of fw_pool.h header file                                              |
+\----------------------------------------------------------------------------*/
+
+#endif  /* fw_pool_H */
@@ -0,0 +1,263 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_ring.c Module File.                                     |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Lock-free single producer / single consumer ring buffer.                  |
+|                                                                             |
+|   head and tail are free running, each one is stored by one side only. A    |
+|   DMB before every index store makes the item copies visible first, a DMB   |
+|   after every index load keeps the copies from being hoisted above it.      |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Compiler Controls                                                         |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "fw_atomic.h"
+#include "fw_ring.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Function Declarations                                             |
+\----------------------------------------------------------------------------*/
+
+static void ringCopyIn( S_RING *ring, U32 index, const U8 *src, U32 count );
+static void ringCopyOut( const S_RING *ring, U32 index, U8 *dst, U32 count );
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : ringInit                                            |
+|                                                                             |
+|   Description         : Attaches the storage to an empty ring.              |
+|                                                                             |
+|   Inputs              : Ring.                                               |
+|                         Storage of length * item_size bytes.                |
+|                         Item size in bytes.                                 |
+|                         Number of items, a power of two.                    |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : FALSE if length is not a power of two.              |
+|                                                                             |
+|   Warnings            : Not while either side is using the ring.            |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN ringInit( S_RING *ring, void *buffer, U32 item_size, U32 length )
+{
+    if ( ( buffer == NULL ) || ( item_size == 0u ) || ( RING_IS_POW2( length ) == FALSE ) )
+    {
+        return FALSE;
+    }
+
+    ring->p_buffer = ( U8 * ) buffer;
+    ring->item_size = item_size;
+    ring->mask = length - 1u;
+    ring->head = 0u;
+    ring->tail = 0u;
+    ring->notify = NULL;
+    ring->notify_arg = NULL;
+
+    return TRUE;
+}
+
+void ringSetNotify( S_RING *ring, RING_NOTIFY notify, void *arg )
+{
+    ring->notify_arg = arg;
+    ring->notify = notify;
+}
+
+BOOLEAN ringPush( S_RING *ring, const void *item )
+{
+    return ( ringPushBatch( ring, item, 1u ) == 1u ) ? TRUE : FALSE;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : ringPushBatch                                       |
+|                                                                             |
+|   Description         : Copies in as many of the items as fit and publishes |
+|                         them with a single head update.                     |
+|                                                                             |
+|   Inputs              : Ring.                                               |
+|                         Items, count * item_size bytes.                     |
+|                         Number of items.                                    |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : Number of items pushed, less than count when full.  |
+|                                                                             |
+|   Warnings            : Producer only.                                      |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+U32 ringPushBatch( S_RING *ring, const void *items, U32 count )
+{
+    U32 head = ring->head;
+    U32 space;
+
+    space = ( ring->mask + 1u ) - ( head - ring->tail );
+    ATOMIC_DMB();                           /* Consumer is done with the slots before they are reused */
+
+    if ( count > space )
+    {
+        count = space;
+    }
+
+    if ( count == 0u )
+    {
+        return 0u;
+    }
+
+    ringCopyIn( ring, head, ( const U8 * ) items, count );
+
+    ATOMIC_DMB();
+    ring->head = head + count;
+
+    /* Store head then load tail, the consumer stores tail then loads head:
+     * with a barrier on both sides at least one of them sees the other. So
+     * either the consumer picks these items up in its current pass, or it had
+     * drained up to 'head' and gets notified.
+     */
+    if ( ring->notify != NULL )
+    {
+        ATOMIC_DMB();
+        if ( ring->tail == head )
+        {
+            ring->notify( ring->notify_arg );
+        }
+    }
+
+    return count;
+}
+
+BOOLEAN ringPop( S_RING *ring, void *item )
+{
+    return ( ringPopBatch( ring, item, 1u ) == 1u ) ? TRUE : FALSE;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : ringPopBatch                                        |
+|                                                                             |
+|   Description         : Copies out up to count items and releases them      |
+|                         with a single tail update.                          |
+|                                                                             |
+|   Inputs              : Ring.                                               |
+|                         Destination, count * item_size bytes.               |
+|                         Maximum number of items.                            |
+|                                                                             |
+|   Outputs             : Items.                                              |
+|                                                                             |
+|   Return              : Number of items popped, 0 when empty.               |
+|                                                                             |
+|   Warnings            : Consumer only.                                      |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+U32 ringPopBatch( S_RING *ring, void *items, U32 count )
+{
+    U32 tail = ring->tail;
+    U32 used;
+
+    used = ring->head - tail;
+    ATOMIC_DMB();                           /* Items are read after the head that published them */
+
+    if ( count > used )
+    {
+        count = used;
+    }
+
+    if ( count == 0u )
+    {
+        return 0u;
+    }
+
+    ringCopyOut( ring, tail, ( U8 * ) items, count );
+
+    ATOMIC_DMB();
+    ring->tail = tail + count;
+
+    /* Pairs with the notify check in ringPushBatch() */
+    ATOMIC_DMB();
+
+    return count;
+}
+
+U32 ringCount( const S_RING *ring )
+{
+    return ring->head - ring->tail;
+}
+
+U32 ringFree( const S_RING *ring )
+{
+    return ( ring->mask + 1u ) - ( ring->head - ring->tail );
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+/* Copies count items to the ring starting at free running index, in at most
+ * two pieces when the run wraps past the end of the storage.
+ */
+static void ringCopyIn( S_RING *ring, U32 index, const U8 *src, U32 count )
+{
+    U32 first = index & ring->mask;
+    U32 run = ( ring->mask + 1u ) - first;
+
+    if ( run > count )
+    {
+        run = count;
+    }
+
+    memcpy( &ring->p_buffer[ first * ring->item_size ], src, run * ring->item_size );
+    if ( count > run )
+    {
+        memcpy( ring->p_buffer, &src[ run * ring->item_size ], ( count - run ) * ring->item_size );
+    }
+}
+
+static void ringCopyOut( const S_RING *ring, U32 index, U8 *dst, U32 count )
+{
+    U32 first = index & ring->mask;
+    U32 run = ( ring->mask + 1u ) - first;
+
+    if ( run > count )
+    {
+        run = count;
+    }
+
+    memcpy( dst, &ring->p_buffer[ first * ring->item_size ], run * ring->item_size );
+    if ( count > run )
+    {
+        memcpy( &dst[ run * ring->item_size ], ring->p_buffer, ( count - run ) * ring->item_size );
+    }
+}
+
+/*----------------------------------------------------------------------------\
+|   End of fw_ring.c module                                                   |
+\----------------------------------------------------------------------------*/
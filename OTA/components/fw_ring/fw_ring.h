@@ -0,0 +1,86 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_ring.h Header File.                                     |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Lock-free single producer / single consumer ring buffer.                  |
+|                                                                             |
+|   For ISR to task data paths that do not need a FreeRTOS queue: no          |
+|   critical section and no scheduler call per item. Exactly one context      |
+|   may push ( typically one ISR ) and exactly one may pop ( one task ).      |
+|   The ring holds fixed size items, the item count is a power of two.        |
+|                                                                             |
+|   The optional notify callback runs on the producer side whenever a push    |
+|   may have found the consumer idle, e.g. to signal a gatekeeper. The        |
+|   consumer must then pop until the ring is empty before it sleeps again.    |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef fw_ring_H
+#define fw_ring_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "fw_types.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+#define RING_IS_POW2( n )           ( ( ( n ) != 0u ) && ( ( ( n ) & ( ( n ) - 1u ) ) == 0u ) )
+
+/*----------------------------------------------------------------------------\
+|   Public Type Definitions                                                   |
+\----------------------------------------------------------------------------*/
+
+typedef void ( *RING_NOTIFY )( void *arg );
+
+typedef struct
+{
+    U8 *                p_buffer;           /* length * item_size bytes */
+    U32                 item_size;          /* Bytes */
+    U32                 mask;               /* length - 1 */
+    volatile U32        head;               /* Written by the producer only, free running */
+    volatile U32        tail;               /* Written by the consumer only, free running */
+    RING_NOTIFY         notify;             /* NULL for none */
+    void *              notify_arg;
+} S_RING;
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN ringInit( S_RING *ring, void *buffer, U32 item_size, U32 length );
+void ringSetNotify( S_RING *ring, RING_NOTIFY notify, void *arg );
+
+/* Producer side */
+BOOLEAN ringPush( S_RING *ring, const void *item );
+U32 ringPushBatch( S_RING *ring, const void *items, U32 count );
+
+/* Consumer side */
+BOOLEAN ringPop( S_RING *ring, void *item );
+U32 ringPopBatch( S_RING *ring, void *items, U32 count );
+
+/* Either side, the result may be stale by the time it is used */
+U32 ringCount( const S_RING *ring );
+U32 ringFree( const S_RING *ring );
+
+/*----------------------------------------------------------------------------\
+|   End of fw_ring.h header file                                              |
+\----------------------------------------------------------------------------*/
+
+#endif  /* fw_ring_H */
@@ -0,0 +1,469 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_timebase.c Module File.                                 |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   High resolution timebase.                                                 |
+|                                                                             |
+|   The armed timers are a list in expiry order; compare 2 always holds the   |
+|   expiry of the head, or a point TB_ARM_MAX ahead when the head is further  |
+|   than the 32 bit compare can reach. The list is changed by tasks in a      |
+|   critical section and by the compare interrupt.                            |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Compiler Controls                                                         |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "HL_sys_core.h"
+#include "HL_sys_vim.h"
+
+#include "FreeRTOS.h"
+#include "os_task.h"
+#include "os_semphr.h"
+
+#include "fw_timebase.h"
+#include "fw_trace.h"
+#include "fw_utils.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define TB_CNT                      1U                  /* RTI counter */
+#define TB_CMP                      2U                  /* RTI compare */
+#define TB_COMPARE_VIM              4U                  /* RTI compare 2 */
+#define TB_OVERFLOW_VIM             7U                  /* RTI counter 1 overflow */
+
+#define TB_GCTRL_CNT1EN             ( 1UL << 1 )
+#define TB_COMPCTRL_COMPSEL2        ( 1UL << 8 )        /* Compare 2 on counter 1 */
+#define TB_INT_COMPARE              ( 1UL << TB_CMP )
+#define TB_INT_OVERFLOW             ( 1UL << 18 )       /* OVL1INT */
+
+#define TB_ARM_MIN                  38u                 /* 1 us: a compare written closer could be passed */
+#define TB_ARM_MAX                  0x40000000u         /* Half the reach of the 32 bit compare */
+#define TB_SLEEP_SPIN_US            20u                 /* Shorter sleeps spin: less than two context switches */
+
+#define TB_CPSR_MODE_MASK           0x1Fu
+#define TB_CPSR_MODE_IRQ            0x12u
+
+#define TB_LOCK_NONE                0u                  /* In the compare interrupt */
+#define TB_LOCK_CRITICAL            1u                  /* Task */
+#define TB_LOCK_IRQ                 2u                  /* main(), before the scheduler */
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static volatile U32 tb_high;                            /* Counter 1 overflows */
+static S_TB_TIMER *tb_timers = NULL;                    /* Armed, in expiry order */
+
+/*----------------------------------------------------------------------------\
+|   Private Function Declarations                                             |
+\----------------------------------------------------------------------------*/
+
+static U32 tbLock( void );
+static void tbUnlock( U32 lock );
+static void tbLink( S_TB_TIMER *timer );
+static BOOLEAN tbUnlink( S_TB_TIMER *timer );
+static void tbArm( void );
+static void tbSleepWake( void *arg, BaseType_t *p_woken );
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : tbInit                                              |
+|                                                                             |
+|   Description         : Starts RTI counter 1 from zero, attaches compare 2  |
+|                         to it and installs the compare and overflow         |
+|                         interrupts.                                         |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Once, before any other use of the timebase.         |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void tbInit( void )
+{
+    tb_high = 0u;
+    tb_timers = NULL;
+
+    rtiREG1->GCTRL &= ~TB_GCTRL_CNT1EN;
+    rtiREG1->CNT[ TB_CNT ].UCx = 0u;
+    rtiREG1->CNT[ TB_CNT ].FRCx = 0u;
+    rtiREG1->CNT[ TB_CNT ].CPUCx = 1u;                          /* RTICLK / 2 */
+    rtiREG1->COMPCTRL |= TB_COMPCTRL_COMPSEL2;
+    rtiREG1->INTFLAG = TB_INT_COMPARE | TB_INT_OVERFLOW;
+
+    vimChannelMap( TB_COMPARE_VIM, TB_COMPARE_VIM, &tbCompareInterrupt );
+    vimChannelMap( TB_OVERFLOW_VIM, TB_OVERFLOW_VIM, &tbOverflowInterrupt );
+    vimEnableInterrupt( TB_COMPARE_VIM, SYS_IRQ );
+    vimEnableInterrupt( TB_OVERFLOW_VIM, SYS_IRQ );
+
+    rtiREG1->SETINTENA = TB_INT_COMPARE | TB_INT_OVERFLOW;
+    rtiREG1->GCTRL |= TB_GCTRL_CNT1EN;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : tbNowTicks                                          |
+|                                                                             |
+|   Description         : Reads the 64 bit timebase. The high word, the       |
+|                         counter and the overflow flag are read in that      |
+|                         order and read again if the high word moved, so an  |
+|                         overflow still pending, when interrupts are         |
+|                         masked, is counted from its flag once.              |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : Ticks of 26.7 ns since tbInit().                    |
+|                                                                             |
+|   Warnings            : None.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+U64 tbNowTicks( void )
+{
+    U32 high;
+    U32 low;
+    U32 pending;
+
+    /* An overflow counted after high was read clears the flag: tb_high moved, read again */
+    do
+    {
+        high = tb_high;
+        low = rtiREG1->CNT[ TB_CNT ].FRCx;
+        pending = rtiREG1->INTFLAG & TB_INT_OVERFLOW;
+    } while ( high != tb_high );
+
+    if ( ( pending != 0u ) && ( low < 0x80000000u ) )
+    {
+        high++;
+    }
+
+    return ( ( U64 ) high << 32 ) | low;
+}
+
+U64 tbNowUs( void )
+{
+    return TB_TICKS_TO_US( tbNowTicks() );
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : tbTimerStart                                        |
+|                                                                             |
+|   Description         : Arms a one-shot timer us from now; an armed timer   |
+|                         is restarted.                                       |
+|                                                                             |
+|   Inputs              : timer       - Caller owned, untouched until it      |
+|                                       fires or is cancelled.                |
+|                         us          - Delay.                                |
+|                         callback    - Called in the compare interrupt.      |
+|                         arg         - Passed to the callback.               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : From tasks, timer callbacks and main().             |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void tbTimerStart( S_TB_TIMER *timer, U32 us, TB_CALLBACK callback, void *arg )
+{
+    tbTimerStartAt( timer, tbNowTicks() + TB_US_TO_TICKS( us ), callback, arg );
+}
+
+/* Arms a one-shot timer for an absolute time in timebase ticks */
+void tbTimerStartAt( S_TB_TIMER *timer, U64 expiry, TB_CALLBACK callback, void *arg )
+{
+    U32 lock = tbLock();
+
+    ( void ) tbUnlink( timer );
+    timer->expiry = expiry;
+    timer->callback = callback;
+    timer->arg = arg;
+    tbLink( timer );
+
+    tbUnlock( lock );
+}
+
+/* Disarms a timer. Returns FALSE if it was not armed: fired or never started */
+BOOLEAN tbTimerCancel( S_TB_TIMER *timer )
+{
+    BOOLEAN armed;
+    U32 lock = tbLock();
+
+    armed = tbUnlink( timer );
+
+    tbUnlock( lock );
+
+    return armed;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : tbSleepInit                                         |
+|                                                                             |
+|   Description         : Creates the binary semaphore of a sleeper, once,    |
+|                         so that tbSleepUs() allocates nothing.              |
+|                                                                             |
+|   Inputs              : sleep       - Sleeper of the calling task.          |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : FALSE if there was no heap for the semaphore.       |
+|                                                                             |
+|   Warnings            : From main() or the init of the task, before the     |
+|                         first tbSleepUs(); the semaphore is never deleted.  |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN tbSleepInit( S_TB_SLEEP *sleep )
+{
+    memset( sleep, 0, sizeof( *sleep ) );
+
+    sleep->wake = xSemaphoreCreateBinary();
+    configASSERT( sleep->wake != NULL );
+
+    return ( sleep->wake != NULL ) ? TRUE : FALSE;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : tbSleepUs                                           |
+|                                                                             |
+|   Description         : Blocks the calling task for us microseconds on the  |
+|                         one-shot timer and the semaphore of its sleeper.    |
+|                         Sleeps shorter than two context switches, and any   |
+|                         sleep before the scheduler has started, spin on     |
+|                         the timebase instead.                               |
+|                                                                             |
+|   Inputs              : sleep       - Sleeper of the calling task.          |
+|                         us          - Delay.                                |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : FALSE, at once, if the sleeper has no semaphore.    |
+|                                                                             |
+|   Warnings            : One task per sleeper. The notification value of     |
+|                         the task is left alone, it belongs to the data      |
+|                         manager and the gatekeeper.                         |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN tbSleepUs( S_TB_SLEEP *sleep, U32 us )
+{
+    U64 end = tbNowTicks() + TB_US_TO_TICKS( us );
+
+    if ( ( us < TB_SLEEP_SPIN_US ) || ( xTaskGetSchedulerState() != taskSCHEDULER_RUNNING ) )
+    {
+        while ( tbNowTicks() < end )
+        {
+        }
+        return TRUE;
+    }
+
+    configASSERT( sleep->wake != NULL );
+    if ( sleep->wake == NULL )
+    {
+        return FALSE;
+    }
+
+    /* A give left by a timer that fired before the last sleep waited */
+    ( void ) xSemaphoreTake( sleep->wake, 0u );
+
+    tbTimerStartAt( &sleep->timer, end, &tbSleepWake, ( void * ) sleep->wake );
+
+    /* Only the timer gives the semaphore, and it is disarmed before it does */
+    while ( sleep->timer.armed == TRUE )
+    {
+        ( void ) xSemaphoreTake( sleep->wake, portMAX_DELAY );
+    }
+
+    return TRUE;
+}
+
+/* RTI compare 2: calls the callbacks of the expired timers, arms the next */
+#pragma CODE_STATE(tbCompareInterrupt, 32)
+#pragma INTERRUPT(tbCompareInterrupt, IRQ)
+void tbCompareInterrupt( void )
+{
+    S_TB_TIMER *timer;
+    BaseType_t woken = pdFALSE;
+
+    TRC_ISR_ENTER( eTRC_ISR_TIMEBASE );
+
+    rtiREG1->INTFLAG = TB_INT_COMPARE;
+
+    while ( ( ( timer = tb_timers ) != NULL ) && ( timer->expiry <= tbNowTicks() ) )
+    {
+        tb_timers = timer->next;
+        timer->next = NULL;
+        timer->armed = FALSE;
+        timer->callback( timer->arg, &woken );
+    }
+    tbArm();
+
+    TRC_ISR_EXIT( eTRC_ISR_TIMEBASE );
+
+    portYIELD_FROM_ISR( woken );
+}
+
+/* RTI counter 1 overflow: the high word of the timebase */
+#pragma CODE_STATE(tbOverflowInterrupt, 32)
+#pragma INTERRUPT(tbOverflowInterrupt, IRQ)
+void tbOverflowInterrupt( void )
+{
+    rtiREG1->INTFLAG = TB_INT_OVERFLOW;
+    tb_high++;
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+/* Keeps the compare interrupt out of a list change. The interrupt itself
+ * needs nothing; before the scheduler a critical section would leave IRQs
+ * masked until it starts, so main() masks them itself.
+ */
+static U32 tbLock( void )
+{
+    if ( ( _getCPSRValue_() & TB_CPSR_MODE_MASK ) == TB_CPSR_MODE_IRQ )
+    {
+        return TB_LOCK_NONE;
+    }
+
+    if ( xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED )
+    {
+        _disable_IRQ_interrupt_();
+        return TB_LOCK_IRQ;
+    }
+
+    taskENTER_CRITICAL();
+
+    return TB_LOCK_CRITICAL;
+}
+
+static void tbUnlock( U32 lock )
+{
+    if ( lock == TB_LOCK_CRITICAL )
+    {
+        taskEXIT_CRITICAL();
+    }
+    else if ( lock == TB_LOCK_IRQ )
+    {
+        _enable_IRQ_interrupt_();
+    }
+}
+
+/* Inserts after the timers of the same expiry; a new head rearms the compare */
+static void tbLink( S_TB_TIMER *timer )
+{
+    S_TB_TIMER **pp_link = &tb_timers;
+
+    while ( ( *pp_link != NULL ) && ( ( *pp_link )->expiry <= timer->expiry ) )
+    {
+        pp_link = &( *pp_link )->next;
+    }
+
+    timer->next = *pp_link;
+    timer->armed = TRUE;
+    *pp_link = timer;
+
+    if ( tb_timers == timer )
+    {
+        tbArm();
+    }
+}
+
+static BOOLEAN tbUnlink( S_TB_TIMER *timer )
+{
+    S_TB_TIMER **pp_link = &tb_timers;
+
+    if ( timer->armed == FALSE )
+    {
+        return FALSE;
+    }
+
+    while ( ( *pp_link != NULL ) && ( *pp_link != timer ) )
+    {
+        pp_link = &( *pp_link )->next;
+    }
+
+    if ( *pp_link == timer )
+    {
+        *pp_link = timer->next;
+    }
+    timer->next = NULL;
+    timer->armed = FALSE;
+
+    return TRUE;
+}
+
+/* Compare 2 to the head expiry, at least TB_ARM_MIN ahead so that it cannot
+ * be passed before it is written; a late head fires on the next microsecond.
+ * A compare with no timer armed fires once and finds nothing.
+ */
+static void tbArm( void )
+{
+    U64 now;
+    U64 target;
+
+    if ( tb_timers == NULL )
+    {
+        return;
+    }
+
+    now = tbNowTicks();
+    target = tb_timers->expiry;
+    if ( target < ( now + TB_ARM_MIN ) )
+    {
+        target = now + TB_ARM_MIN;
+    }
+    else if ( ( target - now ) > TB_ARM_MAX )
+    {
+        target = now + TB_ARM_MAX;
+    }
+
+    rtiREG1->CMP[ TB_CMP ].COMPx = ( U32 ) target;
+}
+
+static void tbSleepWake( void *arg, BaseType_t *p_woken )
+{
+    ( void ) xSemaphoreGiveFromISR( ( SemaphoreHandle_t ) arg, p_woken );
+}
+
+/*----------------------------------------------------------------------------\
+|   End of fw_timebase.c module                                               |
+\----------------------------------------------------------------------------*/
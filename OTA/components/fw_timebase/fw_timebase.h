@@ -0,0 +1,95 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_timebase.h Header File.                                 |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   High resolution timebase.                                                 |
+|                                                                             |
+|   RTI counter 1 at 37.5 MHz, extended to 64 bits by its overflow            |
+|   interrupt: a monotonic clock that does not wrap in the life of the        |
+|   product and is never reset. Counter 0 stays with the FreeRTOS tick.       |
+|                                                                             |
+|   One-shot timers run on RTI compare 2, attached to counter 1; their        |
+|   callbacks are called in the compare interrupt. tbSleepUs() blocks the     |
+|   calling task on such a timer and a semaphore instead of spinning; both    |
+|   are in an S_TB_SLEEP the task owns, set up once by tbSleepInit().         |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef fw_timebase_H
+#define fw_timebase_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "FreeRTOS.h"
+#include "os_semphr.h"
+
+#include "fw_types.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+#define TB_TICKS_PER_2US            75u                 /* RTI counter 1 at 37.5 MHz */
+
+#define TB_US_TO_TICKS( us )        ( ( ( U64 ) ( us ) * TB_TICKS_PER_2US ) / 2u )
+#define TB_TICKS_TO_US( ticks )     ( ( ( U64 ) ( ticks ) * 2u ) / TB_TICKS_PER_2US )
+
+/*----------------------------------------------------------------------------\
+|   Public Type Definitions                                                   |
+\----------------------------------------------------------------------------*/
+
+/* Called in the compare interrupt; FromISR calls pass p_woken on */
+typedef void ( *TB_CALLBACK )( void *arg, BaseType_t *p_woken );
+
+/* A one-shot timer: owned by the caller, zeroed before its first start */
+typedef struct S_TB_TIMER
+{
+    struct S_TB_TIMER *         next;
+    U64                         expiry;             /* Timebase ticks */
+    TB_CALLBACK                 callback;
+    void *                      arg;
+    BOOLEAN                     armed;
+} S_TB_TIMER;
+
+/* A sleeper: owned by the task that sleeps on it */
+typedef struct
+{
+    S_TB_TIMER                  timer;
+    SemaphoreHandle_t           wake;               /* Given by the timer */
+} S_TB_SLEEP;
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+void tbInit( void );
+U64 tbNowTicks( void );
+U64 tbNowUs( void );
+void tbTimerStart( S_TB_TIMER *timer, U32 us, TB_CALLBACK callback, void *arg );
+void tbTimerStartAt( S_TB_TIMER *timer, U64 expiry, TB_CALLBACK callback, void *arg );
+BOOLEAN tbTimerCancel( S_TB_TIMER *timer );
+BOOLEAN tbSleepInit( S_TB_SLEEP *sleep );
+BOOLEAN tbSleepUs( S_TB_SLEEP *sleep, U32 us );
+void tbCompareInterrupt( void );
+void tbOverflowInterrupt( void );
+
+/*----------------------------------------------------------------------------\
+|   End of fw_timebase.h header file                                          |
+\----------------------------------------------------------------------------*/
+
+#endif  /* fw_timebase_H */
@@ -0,0 +1,352 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_trace.c Module File.                                    |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Binary RTOS event trace recorder.                                         |
+|                                                                             |
+|   Writers ( tasks, the kernel and ISRs ) reserve a slot by advancing the    |
+|   head index with LDREX / STREX, fill it in and commit it by writing the    |
+|   event id last. The single reader ( trcDrain ) stops at the first slot     |
+|   that is not committed yet, so a writer pre-empted half way through a      |
+|   record can never hand out a torn event. When the ring is full new         |
+|   events are dropped and counted, the recorder never blocks.                |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Compiler Controls                                                         |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "HL_sys_pmu.h"
+
+#include "fw_atomic.h"
+#include "fw_utils.h"
+#include "fw_uart.h"
+#include "fw_trace.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define TRC_BUFFER_MASK             ( TRC_BUFFER_EVENTS - 1u )
+#define TRC_NAME_CHUNK              4u
+#define TRC_NAME_MAX                16u
+
+#define TRC_TIMESTAMP()             ( rtiREG1->CNT[ 0 ].FRCx )
+
+#if ( TRC_MEASURE_OVERHEAD == 1 )
+    #define TRC_CYCLES()            _pmuGetCycleCount_()
+#else
+    #define TRC_CYCLES()            0u
+#endif
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static S_TRC_EVENT trc_buffer[ TRC_BUFFER_EVENTS ];
+static volatile U32 trc_head;               /* Next slot to reserve, free running */
+static volatile U32 trc_tail;               /* Next slot to drain, free running */
+static volatile BOOLEAN trc_enabled = FALSE;
+
+static S_TRC_STATS trc_stats;
+static U32 trc_dropped_reported;            /* Drop count already announced to the host */
+
+static S_TRC_EVENT trc_frame[ TRC_DRAIN_MAX_EVENTS ];
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Private Function Declarations                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : trcInit                                             |
+|                                                                             |
+|   Description         : Clears the ring and starts recording. Must run      |
+|                         before the first task is created so that the task   |
+|                         names reach the trace.                              |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : None.                                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void trcInit( void )
+{
+    memset( trc_buffer, 0, sizeof( trc_buffer ) );
+    memset( &trc_stats, 0, sizeof( trc_stats ) );
+    trc_head = 0u;
+    trc_tail = 0u;
+    trc_dropped_reported = 0u;
+
+#if ( TRC_MEASURE_OVERHEAD == 1 )
+    _pmuEnableCountersGlobal_();
+    _pmuStartCounters_( pmuCYCLE_COUNTER );
+#endif
+
+    trc_enabled = ( TRC_ENABLED == 1 ) ? TRUE : FALSE;
+}
+
+void trcEnable( BOOLEAN enable )
+{
+    trc_enabled = ( ( TRC_ENABLED == 1 ) && ( enable == TRUE ) ) ? TRUE : FALSE;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : trcRecord                                           |
+|                                                                             |
+|   Description         : Appends one event to the ring. Wait free apart      |
+|                         from the STREX retry, which only repeats when an    |
+|                         interrupt recorded an event in between.             |
+|                                                                             |
+|   Inputs              : Event id ( E_TRC_EVENT_ID ).                        |
+|                         Event argument.                                     |
+|                         Object id ( handle or E_TRC_ISR_ID ).               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Called from the scheduler and from ISRs, keep it    |
+|                         short.                                              |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void trcRecord( U16 event, U16 arg, U32 object )
+{
+    U32 head;
+    U32 start;
+    U32 cycles;
+    S_TRC_EVENT *p_slot;
+
+    if ( trc_enabled == FALSE )
+    {
+        return;
+    }
+
+    start = TRC_CYCLES();
+
+    do
+    {
+        head = trc_head;
+        if ( ( head - trc_tail ) >= TRC_BUFFER_EVENTS )
+        {
+            atomicFetchAddU32( &trc_stats.dropped, 1u );
+            return;
+        }
+    } while ( atomicCasU32( &trc_head, head, head + 1u ) == FALSE );
+
+    p_slot = &trc_buffer[ head & TRC_BUFFER_MASK ];
+    p_slot->timestamp = TRC_TIMESTAMP();
+    p_slot->arg = arg;
+    p_slot->object = object;
+
+    /* Payload must be visible before the slot is marked committed */
+    ATOMIC_DMB();
+    p_slot->event = event;
+
+    cycles = TRC_CYCLES() - start;
+    trc_stats.last_cycles = cycles;
+    if ( cycles > trc_stats.max_cycles )
+    {
+        trc_stats.max_cycles = cycles;
+    }
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : trcNameObject                                       |
+|                                                                             |
+|   Description         : Attaches a readable name to a handle ( queue,       |
+|                         semaphore, ... ) for the host converter. The name   |
+|                         is sent as up to four eTRC_EVT_OBJECT_NAME records  |
+|                         of four characters each.                            |
+|                                                                             |
+|   Inputs              : Object handle.                                      |
+|                         NUL terminated name, truncated to 16 characters.    |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : The name records use the timestamp field for the    |
+|                         handle, so they are written directly rather than    |
+|                         through trcRecord().                                |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void trcNameObject( const void *object, const CHAR *name )
+{
+    U32 head;
+    U32 chunk;
+    U32 packed;
+    U32 i;
+    BOOLEAN end = FALSE;
+    S_TRC_EVENT *p_slot;
+
+    if ( ( trc_enabled == FALSE ) || ( name == NULL ) )
+    {
+        return;
+    }
+
+    for ( chunk = 0u; ( chunk < ( TRC_NAME_MAX / TRC_NAME_CHUNK ) ) && ( end == FALSE ); chunk++ )
+    {
+        packed = 0u;
+        for ( i = 0u; i < TRC_NAME_CHUNK; i++ )
+        {
+            if ( ( end == FALSE ) && ( *name == '\0' ) )
+            {
+                end = TRUE;
+            }
+            packed = ( packed << 8 ) | ( ( end == FALSE ) ? ( U32 ) ( U8 ) *name++ : 0u );
+        }
+
+        do
+        {
+            head = trc_head;
+            if ( ( head - trc_tail ) >= TRC_BUFFER_EVENTS )
+            {
+                atomicFetchAddU32( &trc_stats.dropped, 1u );
+                return;
+            }
+        } while ( atomicCasU32( &trc_head, head, head + 1u ) == FALSE );
+
+        p_slot = &trc_buffer[ head & TRC_BUFFER_MASK ];
+        p_slot->timestamp = ( U32 ) object;
+        p_slot->arg = ( U16 ) chunk;
+        p_slot->object = packed;
+        ATOMIC_DMB();
+        p_slot->event = eTRC_EVT_OBJECT_NAME;
+    }
+}
+
+void trcTaskCreate( const void *task, const CHAR *name, U16 priority )
+{
+    trcRecord( eTRC_EVT_TASK_CREATE, priority, ( U32 ) task );
+    trcNameObject( task, name );
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : trcDrain                                            |
+|                                                                             |
+|   Description         : Moves up to TRC_DRAIN_MAX_EVENTS committed events   |
+|                         into one UART frame ( stream eUART_STREAM_TRACE ).  |
+|                         Returns immediately while the previous frame is     |
+|                         still being transmitted. New drops since the last   |
+|                         frame are reported with an eTRC_EVT_DROPPED record. |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : TRUE if a frame was sent.                           |
+|                                                                             |
+|   Warnings            : Single consumer, call from one task only.           |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN trcDrain( void )
+{
+    U32 count = 0u;
+    U32 dropped;
+    S_TRC_EVENT *p_slot;
+
+    if ( uartIsTxIdle( TRC_DRAIN_UART ) == FALSE )
+    {
+        return FALSE;
+    }
+
+    dropped = trc_stats.dropped;
+    if ( dropped != trc_dropped_reported )
+    {
+        trc_frame[ count ].timestamp = TRC_TIMESTAMP();
+        trc_frame[ count ].event = eTRC_EVT_DROPPED;
+        trc_frame[ count ].arg = 0u;
+        trc_frame[ count ].object = dropped;
+        trc_dropped_reported = dropped;
+        count++;
+    }
+
+    while ( count < TRC_DRAIN_MAX_EVENTS )
+    {
+        p_slot = &trc_buffer[ trc_tail & TRC_BUFFER_MASK ];
+        if ( p_slot->event == eTRC_EVT_NONE )
+        {
+            break;
+        }
+
+        ATOMIC_DMB();
+        trc_frame[ count++ ] = *p_slot;
+        p_slot->event = eTRC_EVT_NONE;
+
+        /* Slot must read as free before writers may reuse it */
+        ATOMIC_DMB();
+        trc_tail++;
+    }
+
+    if ( count == 0u )
+    {
+        return FALSE;
+    }
+
+    if ( uartSendFrame( TRC_DRAIN_UART, eUART_STREAM_TRACE, ( const U8 * ) trc_frame, ( U16 ) ( count * sizeof( S_TRC_EVENT ) ) ) == FALSE )
+    {
+        return FALSE;
+    }
+
+    trc_stats.drained += count;
+
+    return TRUE;
+}
+
+const S_TRC_STATS * trcGetStats( void )
+{
+    trc_stats.recorded = trc_head;
+    return &trc_stats;
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   End of fw_trace.c module                                                  |
+\----------------------------------------------------------------------------*/
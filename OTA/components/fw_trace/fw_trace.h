@@ -0,0 +1,143 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_trace.h Header File.                                    |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Binary RTOS event trace recorder.                                         |
+|                                                                             |
+|   Every event is a fixed 12 byte record ( timestamp, event id, argument,    |
+|   object id ) written into a lock-free RAM ring by the FreeRTOS trace       |
+|   macros ( see FreeRTOSConfig.h ) and by the ISR entry / exit hooks.        |
+|   trcDrain() empties the ring over UART in framed blocks from a low         |
+|   priority task, tools/trace2chrome.py turns the capture into a             |
+|   Chrome trace / Perfetto JSON file.                                        |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef fw_trace_H
+#define fw_trace_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "fw_types.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+#define TRC_ENABLED                 1
+
+#define TRC_BUFFER_EVENTS           512u                /* Ring size, must be a power of two */
+#define TRC_DRAIN_MAX_EVENTS        20u                 /* Events per UART frame */
+#define TRC_DRAIN_UART              eUART_2             /* SCI3, see note below */
+#define TRC_MEASURE_OVERHEAD        1                   /* Keep PMU cycle statistics of trcRecord() */
+
+/* Note: SCI3 is the only UART routed on this board ( the SCI4 balls are muxed
+ * to N2HET1[17/19] ). The trace frames share it with the STX / ETX traffic and
+ * are told apart by the sync bytes and CRC. At 9600 baud the drain sustains
+ * roughly 75 events/s, so use trcEnable() to take short captures around the
+ * problem rather than leaving the recorder running.
+ */
+
+/* Timestamps are the RTI counter 0 free running counter, which FreeRTOS
+ * programs to RTICLK / 2 ( see os_port.c ).
+ */
+#define TRC_TIMESTAMP_HZ            37500000u
+
+/*----------------------------------------------------------------------------\
+|   Public Type Definitions                                                   |
+\----------------------------------------------------------------------------*/
+
+/* Note: the numbering is shared with tools/trace2chrome.py, append only */
+typedef enum
+{
+    eTRC_EVT_NONE = 0u,                     /* Slot reserved but not committed yet */
+    eTRC_EVT_OBJECT_NAME,                   /* timestamp = object, arg = chunk index, object = 4 name chars */
+    eTRC_EVT_TASK_CREATE,                   /* arg = priority */
+    eTRC_EVT_TASK_SWITCHED_IN,              /* arg = priority */
+    eTRC_EVT_TASK_SWITCHED_OUT,
+    eTRC_EVT_TASK_DELAY_UNTIL,              /* object = wake tick */
+    eTRC_EVT_QUEUE_CREATE,                  /* arg = queue length */
+    eTRC_EVT_QUEUE_SEND,                    /* arg = messages waiting before the send */
+    eTRC_EVT_QUEUE_SEND_FAILED,
+    eTRC_EVT_QUEUE_SEND_FROM_ISR,
+    eTRC_EVT_QUEUE_RECEIVE,                 /* arg = messages waiting before the receive */
+    eTRC_EVT_QUEUE_RECEIVE_FAILED,
+    eTRC_EVT_QUEUE_RECEIVE_FROM_ISR,
+    eTRC_EVT_QUEUE_BLOCK_ON_SEND,
+    eTRC_EVT_QUEUE_BLOCK_ON_RECEIVE,
+    eTRC_EVT_ISR_ENTER,                     /* object = E_TRC_ISR_ID */
+    eTRC_EVT_ISR_EXIT,                      /* object = E_TRC_ISR_ID */
+    eTRC_EVT_DROPPED,                       /* Inserted by the drain, object = total events lost */
+    eTRC_EVT_USER,                          /* Free for application markers */
+    eTRC_EVT_MAX,
+} E_TRC_EVENT_ID;
+
+typedef enum
+{
+    eTRC_ISR_SCI3 = 0u,
+    eTRC_ISR_SCI4,
+    eTRC_ISR_ADC,
+    eTRC_ISR_GIO,
+    eTRC_ISR_DIO_SCHED,
+    eTRC_ISR_TIMEBASE,
+    eTRC_ISR_MAX,
+} E_TRC_ISR_ID;
+
+/* Ring record, the target is big endian so the host decodes it as ">IHHI" */
+typedef struct
+{
+    U32                 timestamp;
+    U16                 event;              /* E_TRC_EVENT_ID, written last to commit the slot */
+    U16                 arg;
+    U32                 object;             /* Task / queue handle or E_TRC_ISR_ID */
+} S_TRC_EVENT;
+
+typedef struct
+{
+    U32                 recorded;           /* Events committed to the ring */
+    U32                 dropped;            /* Events lost because the ring was full */
+    U32                 drained;            /* Events sent to the host */
+    U32                 last_cycles;        /* Cost of the last trcRecord() in CPU cycles */
+    U32                 max_cycles;         /* Worst case, includes any interrupt that nested in */
+} S_TRC_STATS;
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+void trcInit( void );
+void trcEnable( BOOLEAN enable );
+void trcRecord( U16 event, U16 arg, U32 object );
+void trcNameObject( const void *object, const CHAR *name );
+void trcTaskCreate( const void *task, const CHAR *name, U16 priority );
+BOOLEAN trcDrain( void );
+const S_TRC_STATS * trcGetStats( void );
+
+#if ( TRC_ENABLED == 1 )
+    #define TRC_ISR_ENTER( id )     trcRecord( eTRC_EVT_ISR_ENTER, 0u, ( U32 ) ( id ) )
+    #define TRC_ISR_EXIT( id )      trcRecord( eTRC_EVT_ISR_EXIT, 0u, ( U32 ) ( id ) )
+#else
+    #define TRC_ISR_ENTER( id )
+    #define TRC_ISR_EXIT( id )
+#endif
+
+/*----------------------------------------------------------------------------\
+|   End of fw_trace.h header file                                             |
+\----------------------------------------------------------------------------*/
+
+#endif  /* fw_trace_H */
@@ -0,0 +1,466 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_twheel.c Module File.                                   |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Hierarchical timer wheel.                                                 |
+|                                                                             |
+|   Level n has 64 slots of 64^n ticks. A timer goes on the lowest level      |
+|   whose span holds its distance from the wheel position, in the slot of     |
+|   its expiry. When the level 0 index wraps, the current slot of level 1     |
+|   is cascaded: its timers are placed again, now closer, and so on up.       |
+|   The level 0 slot of each tick is spliced whole onto the expired list.     |
+|                                                                             |
+|   Two clocks: tw_ticks is counted by the tick interrupt, tw_now is the      |
+|   position the gatekeeper has stepped the wheel to. An expiry is taken      |
+|   from tw_ticks, a slot from the distance to tw_now. tw_now lags while      |
+|   there is nothing to do, by less than a level 0 turn since the tick        |
+|   wakes the gatekeeper at every cascade.                                    |
+|                                                                             |
+|   Every list change is in a critical section of its own, so none holds      |
+|   interrupts off for longer than one timer move.                            |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Compiler Controls                                                         |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "os_task.h"
+
+#include "gatekeeper.h"
+#include "fw_timebase.h"
+#include "fw_twheel.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define TW_SLOTS                    ( 1UL << TW_SLOT_BITS )
+#define TW_SLOT_MASK                ( TW_SLOTS - 1u )
+#define TW_SLOT( ticks, level )     ( ( ( ticks ) >> ( TW_SLOT_BITS * ( level ) ) ) & TW_SLOT_MASK )
+
+#define TW_LIST_EMPTY( head )       ( ( head )->next == ( head ) )
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static S_TW_LINK tw_wheel[ TW_LEVELS ][ TW_SLOTS ];
+static S_TW_LINK tw_expired;                    /* Due, callbacks not yet called */
+static S_TW_LINK tw_cascade;                    /* Taken off a slot, to be placed again */
+static volatile U32 tw_ticks;                   /* Counted by the tick interrupt */
+static U32 tw_now;                              /* Wheel position */
+static S_TB_TIMER tw_tick_timer;
+static S_TW_STATS tw_stats;
+
+/*----------------------------------------------------------------------------\
+|   Private Function Declarations                                             |
+\----------------------------------------------------------------------------*/
+
+static void twTick( void *arg, BaseType_t *p_woken );
+static void twAdvance( void );
+static BOOLEAN twPopExpired( TW_CALLBACK *p_callback, void **p_arg );
+static void twArm( S_TW_TIMER *timer, U32 delay );
+static void twPlace( S_TW_TIMER *timer );
+static U32 twMsToTicks( U32 ms );
+static void twListInit( S_TW_LINK *head );
+static void twListAppend( S_TW_LINK *head, S_TW_LINK *link );
+static void twListRemove( S_TW_LINK *link );
+static void twListSplice( S_TW_LINK *from, S_TW_LINK *to );
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : twInit                                              |
+|                                                                             |
+|   Description         : Empties the wheel and starts its tick on the        |
+|                         timebase.                                           |
+|                                                                             |
+|   Inputs              : None.                                               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : After tbInit().                                     |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void twInit( void )
+{
+    U32 level;
+    U32 slot;
+
+    for ( level = 0u; level < TW_LEVELS; level++ )
+    {
+        for ( slot = 0u; slot < TW_SLOTS; slot++ )
+        {
+            twListInit( &tw_wheel[ level ][ slot ] );
+        }
+    }
+    twListInit( &tw_expired );
+    twListInit( &tw_cascade );
+
+    tw_ticks = 0u;
+    tw_now = 0u;
+    memset( &tw_stats, 0, sizeof( tw_stats ) );
+
+    memset( &tw_tick_timer, 0, sizeof( tw_tick_timer ) );
+    tbTimerStart( &tw_tick_timer, TW_TICK_US, &twTick, NULL );
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : twStart                                             |
+|                                                                             |
+|   Description         : Arms a timer; an armed timer is moved. The          |
+|                         callback runs between delay_ms and one tick more    |
+|                         from now, then every period_ms if not 0.            |
+|                                                                             |
+|   Inputs              : timer       - Caller owned, zeroed before its       |
+|                                       first start.                          |
+|                         delay_ms    - First expiry, up to TW_DELAY_MAX.     |
+|                         period_ms   - Period, 0 for a one-shot.             |
+|                         callback    - Called in the gatekeeper task.        |
+|                         arg         - Passed to the callback.               |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Task context only, callbacks included.              |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void twStart( S_TW_TIMER *timer, U32 delay_ms, U32 period_ms, TW_CALLBACK callback, void *arg )
+{
+    U32 delay = twMsToTicks( delay_ms );
+
+    taskENTER_CRITICAL();
+
+    if ( timer->link.next != NULL )
+    {
+        twListRemove( &timer->link );
+        tw_stats.active--;
+    }
+    timer->delay = delay;
+    timer->period = ( period_ms == 0u ) ? 0u : twMsToTicks( period_ms );
+    timer->callback = callback;
+    timer->arg = arg;
+    twArm( timer, delay );
+
+    taskEXIT_CRITICAL();
+}
+
+/* Arms a started timer again with its first delay, the usual move of an
+ * inter-byte or response timeout */
+void twRestart( S_TW_TIMER *timer )
+{
+    taskENTER_CRITICAL();
+
+    if ( timer->link.next != NULL )
+    {
+        twListRemove( &timer->link );
+        tw_stats.active--;
+    }
+    twArm( timer, timer->delay );
+
+    taskEXIT_CRITICAL();
+}
+
+/* Disarms a timer, also one expired whose callback has not run yet. Returns
+ * FALSE if it was idle */
+BOOLEAN twStop( S_TW_TIMER *timer )
+{
+    BOOLEAN armed = FALSE;
+
+    taskENTER_CRITICAL();
+
+    if ( timer->link.next != NULL )
+    {
+        twListRemove( &timer->link );
+        tw_stats.active--;
+        armed = TRUE;
+    }
+
+    taskEXIT_CRITICAL();
+
+    return armed;
+}
+
+BOOLEAN twActive( const S_TW_TIMER *timer )
+{
+    return ( timer->link.next != NULL ) ? TRUE : FALSE;
+}
+
+/*----------------------------------------------------------------------------\
+|                                                                             |
+|   Procedure           : twServe                                             |
+|                                                                             |
+|   Description         : Gatekeeper handler. Steps the wheel up to the tick  |
+|                         count and calls the expired timers, at most         |
+|                         TW_CALLBACKS_PER_SERVE; the rest waits for the      |
+|                         next pass, after the other gatekeeper sources.      |
+|                                                                             |
+|   Inputs              : item        - NULL, event only source.              |
+|                                                                             |
+|   Outputs             : None.                                               |
+|                                                                             |
+|   Return              : None.                                               |
+|                                                                             |
+|   Warnings            : Gatekeeper task only.                               |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+void twServe( const void *item )
+{
+    U32 calls = 0u;
+    TW_CALLBACK callback;
+    void *arg;
+
+    ( void ) item;
+    tw_stats.serves++;
+
+    while ( calls < TW_CALLBACKS_PER_SERVE )
+    {
+        if ( twPopExpired( &callback, &arg ) == TRUE )
+        {
+            callback( arg );
+            calls++;
+        }
+        else if ( tw_now != tw_ticks )
+        {
+            twAdvance();
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if ( calls == TW_CALLBACKS_PER_SERVE )
+    {
+        gkSignal( eGK_SRC_TIMER_WHEEL );
+    }
+}
+
+const S_TW_STATS * twGetStats( void )
+{
+    return &tw_stats;
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+/* Timebase callback, every TW_TICK_US without drift. Wakes the gatekeeper
+ * when the slot of the tick holds timers or a cascade is due */
+static void twTick( void *arg, BaseType_t *p_woken )
+{
+    U32 t = tw_ticks + 1u;
+    S_TW_LINK *p_slot = &tw_wheel[ 0 ][ t & TW_SLOT_MASK ];
+
+    ( void ) arg;
+    tw_ticks = t;
+    tbTimerStartAt( &tw_tick_timer, tw_tick_timer.expiry + TB_US_TO_TICKS( TW_TICK_US ), &twTick, NULL );
+
+    if ( ( tw_stats.active != 0u ) &&
+         ( ( ( t & TW_SLOT_MASK ) == 0u ) || ( TW_LIST_EMPTY( p_slot ) == FALSE ) || ( TW_LIST_EMPTY( &tw_expired ) == FALSE ) ) )
+    {
+        gkSignalFromISR( eGK_SRC_TIMER_WHEEL, p_woken );
+    }
+}
+
+/* One wheel tick: cascades where the lower index wrapped, then moves the
+ * level 0 slot to the expired list */
+static void twAdvance( void )
+{
+    U32 t;
+    U32 level;
+    S_TW_LINK *link;
+
+    taskENTER_CRITICAL();
+    t = tw_now + 1u;
+    tw_now = t;
+    for ( level = 1u; ( level < TW_LEVELS ) && ( TW_SLOT( t, level - 1u ) == 0u ); level++ )
+    {
+        twListSplice( &tw_wheel[ level ][ TW_SLOT( t, level ) ], &tw_cascade );
+    }
+    taskEXIT_CRITICAL();
+
+    do
+    {
+        taskENTER_CRITICAL();
+        link = tw_cascade.next;
+        if ( link != &tw_cascade )
+        {
+            twListRemove( link );
+            twPlace( ( S_TW_TIMER * ) link );
+            tw_stats.cascaded++;
+        }
+        taskEXIT_CRITICAL();
+    } while ( link != &tw_cascade );
+
+    /* Unless an empty wheel has meanwhile been moved on by twArm() */
+    taskENTER_CRITICAL();
+    if ( tw_now == t )
+    {
+        twListSplice( &tw_wheel[ 0 ][ TW_SLOT( t, 0u ) ], &tw_expired );
+    }
+    taskEXIT_CRITICAL();
+}
+
+/* Takes the first expired timer, arming a periodic one again */
+static BOOLEAN twPopExpired( TW_CALLBACK *p_callback, void **p_arg )
+{
+    S_TW_TIMER *timer;
+    U32 late;
+    BOOLEAN found = FALSE;
+
+    taskENTER_CRITICAL();
+
+    if ( TW_LIST_EMPTY( &tw_expired ) == FALSE )
+    {
+        timer = ( S_TW_TIMER * ) tw_expired.next;
+        twListRemove( &timer->link );
+
+        late = tw_now - timer->expiry;
+        tw_stats.late_max = ( late > tw_stats.late_max ) ? late : tw_stats.late_max;
+        tw_stats.fired++;
+
+        if ( timer->period != 0u )
+        {
+            timer->expiry += timer->period;
+            twPlace( timer );
+        }
+        else
+        {
+            tw_stats.active--;
+        }
+
+        *p_callback = timer->callback;
+        *p_arg = timer->arg;
+        found = TRUE;
+    }
+
+    taskEXIT_CRITICAL();
+
+    return found;
+}
+
+/* Places an idle timer delay ticks after the current tick. An empty wheel
+ * first catches up with the tick count, there is nothing to step through */
+static void twArm( S_TW_TIMER *timer, U32 delay )
+{
+    if ( tw_stats.active == 0u )
+    {
+        tw_now = tw_ticks;
+    }
+
+    timer->expiry = tw_ticks + delay + 1u;
+    twPlace( timer );
+
+    tw_stats.active++;
+    tw_stats.active_max = ( tw_stats.active > tw_stats.active_max ) ? tw_stats.active : tw_stats.active_max;
+}
+
+/* Links a timer into the slot of its expiry; one already due goes to the
+ * expired list. Further than the wheel spans, it waits in the last slot of
+ * the top level and is placed again from there. */
+static void twPlace( S_TW_TIMER *timer )
+{
+    U32 delta = timer->expiry - tw_now;
+    U32 when = timer->expiry;
+    U32 level = 0u;
+
+    if ( ( S32 ) delta <= 0 )
+    {
+        twListAppend( &tw_expired, &timer->link );
+        return;
+    }
+
+    if ( delta >= TW_RANGE )
+    {
+        when = tw_now + TW_RANGE - 1u;
+        delta = TW_RANGE - 1u;
+    }
+
+    while ( ( level < ( TW_LEVELS - 1u ) ) && ( delta >= ( 1UL << ( TW_SLOT_BITS * ( level + 1u ) ) ) ) )
+    {
+        level++;
+    }
+
+    twListAppend( &tw_wheel[ level ][ TW_SLOT( when, level ) ], &timer->link );
+}
+
+static U32 twMsToTicks( U32 ms )
+{
+    U32 ticks = ( U32 ) ( ( ( U64 ) ms * 1000u ) / TW_TICK_US );
+
+    return ( ticks > TW_DELAY_MAX ) ? TW_DELAY_MAX : ticks;
+}
+
+static void twListInit( S_TW_LINK *head )
+{
+    head->next = head;
+    head->prev = head;
+}
+
+static void twListAppend( S_TW_LINK *head, S_TW_LINK *link )
+{
+    link->prev = head->prev;
+    link->next = head;
+    head->prev->next = link;
+    head->prev = link;
+}
+
+/* Unlinks a node; a NULL next marks its timer idle */
+static void twListRemove( S_TW_LINK *link )
+{
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->next = NULL;
+    link->prev = NULL;
+}
+
+/* Moves every node of from to the tail of to, in order */
+static void twListSplice( S_TW_LINK *from, S_TW_LINK *to )
+{
+    if ( TW_LIST_EMPTY( from ) == TRUE )
+    {
+        return;
+    }
+
+    from->next->prev = to->prev;
+    to->prev->next = from->next;
+    from->prev->next = to;
+    to->prev = from->prev;
+    twListInit( from );
+}
+
+/*----------------------------------------------------------------------------\
+|   End of fw_twheel.c module                                                 |
+\----------------------------------------------------------------------------*/
@@ -0,0 +1,99 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : fw_twheel.h Header File.                                   |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Hierarchical timer wheel.                                                 |
+|                                                                             |
+|   Millisecond timers for protocol timeouts and retries, as many as the      |
+|   callers have S_TW_TIMER objects for. Start, stop and restart are O(1);    |
+|   a timer is a node on a slot list, nothing is allocated or queued.         |
+|                                                                             |
+|   The wheel is stepped by one timebase timer at TW_TICK_US. The tick only   |
+|   counts, and wakes the gatekeeper when a slot holds timers; expiry and     |
+|   the callbacks run there, at most TW_CALLBACKS_PER_SERVE at a time.        |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef fw_twheel_H
+#define fw_twheel_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "fw_types.h"
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+#define TW_TICK_US                  1000u               /* One wheel tick */
+#define TW_SLOT_BITS                6u                  /* 64 slots a level */
+#define TW_LEVELS                   4u
+#define TW_RANGE                    ( 1UL << ( TW_SLOT_BITS * TW_LEVELS ) )     /* Ticks the levels span, 4.6 h */
+#define TW_DELAY_MAX                ( TW_RANGE - ( 1UL << TW_SLOT_BITS ) - 1u )  /* Leaves a level 0 turn for a late gatekeeper */
+#define TW_CALLBACKS_PER_SERVE      16u
+
+/*----------------------------------------------------------------------------\
+|   Public Type Definitions                                                   |
+\----------------------------------------------------------------------------*/
+
+typedef void ( *TW_CALLBACK )( void *arg );
+
+typedef struct S_TW_LINK
+{
+    struct S_TW_LINK *          next;               /* NULL while the timer is idle */
+    struct S_TW_LINK *          prev;
+} S_TW_LINK;
+
+/* A timer: owned by the caller, zeroed before its first start */
+typedef struct
+{
+    S_TW_LINK                   link;               /* First member, a link is its timer */
+    U32                         expiry;             /* Wheel ticks */
+    U32                         delay;              /* Ticks, the delay of twRestart() */
+    U32                         period;             /* Ticks, 0 for a one-shot */
+    TW_CALLBACK                 callback;           /* Called in the gatekeeper task */
+    void *                      arg;
+} S_TW_TIMER;
+
+typedef struct
+{
+    U32                         active;             /* Timers armed or expired and not yet called */
+    U32                         active_max;
+    U32                         fired;
+    U32                         cascaded;           /* Timers moved down a level */
+    U32                         late_max;           /* Ticks between expiry and callback */
+    U32                         serves;
+} S_TW_STATS;
+
+/*----------------------------------------------------------------------------\
+|   Public Function Declarations                                              |
+\----------------------------------------------------------------------------*/
+
+void twInit( void );
+void twStart( S_TW_TIMER *timer, U32 delay_ms, U32 period_ms, TW_CALLBACK callback, void *arg );
+void twRestart( S_TW_TIMER *timer );
+BOOLEAN twStop( S_TW_TIMER *timer );
+BOOLEAN twActive( const S_TW_TIMER *timer );
+void twServe( const void *item );
+const S_TW_STATS * twGetStats( void );
+
+/*----------------------------------------------------------------------------\
+|   End of fw_twheel.h header file                                            |
+\----------------------------------------------------------------------------*/
+
+#endif  /* fw_twheel_H */
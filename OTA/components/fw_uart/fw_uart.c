@@ -36,6 +36,11 @@
 #include "os_queue.h"
 
 #include "fw_uart.h"
+#include "fw_crc.h"
+#include "fw_trace.h"
+#include "fw_log.h"
+#include "gatekeeper.h"
+#include "dm_history.h"
 
 /*----------------------------------------------------------------------------\
 |   Public Constant Definitions                                               |
@@ -74,6 +79,7 @@ static const S_UART_CONFIG uart_config_defs [ eUART_MAX ] = { { .id = eUART_0,
 
 static uint8 sci_rx_buffer [ eUART_MAX ] [ sizeof(S_UART_INFO) ];
 static uint8 sci_rx_buffer_idx [ eUART_MAX ];
+static uint8 uart_tx_frame [ eUART_MAX ] [ UART_FRAME_PAYLOAD_SIZE + UART_FRAME_OVERHEAD ];
 
 /** @struct g_sciTransfer
  *   @brief Interrupt mode globals
@@ -101,6 +107,7 @@ void uart_init( void ) {
     uint32_t timeout;
 
     xUARTQueueHandle = xQueueCreate( UART_QUEUE_LENGTH, UART_QUEUE_ITEM_SIZE );
+    trcNameObject( xUARTQueueHandle, "UART RX" );
     const S_UART_CONFIG *const p_cfg = uartGetConfig();
 
     for ( i = 0; i < eUART_MAX; i++ ) {
@@ -213,9 +220,54 @@ const S_UART_CONFIG* const uartGetConfig( void ) {
     return uart_config_defs;
 }
 
+/* TRUE when the interrupt driven transmitter of this UART has nothing left
+ * to send, i.e. sciSend() may be called again.
+ */
+BOOLEAN uartIsTxIdle( E_UART_ID id ) {
+    if ( ( id >= eUART_MAX ) || ( uart_config_defs [ id ].enabled == FALSE ) ) {
+        return FALSE;
+    }
+
+    return ( g_sciTransfer_t [ id ].tx_length == 0U ) ? TRUE : FALSE;
+}
+
+/* Non blocking binary frame transmit:
+ *   SYNC_0 SYNC_1 stream len_hi len_lo payload[ len ] crc32[ 4 ]
+ * The CRC ( fw_crc, big endian ) covers stream, length and payload.
+ * The payload is copied, so the caller's buffer is free on return.
+ * Returns FALSE if the UART is busy, disabled or the payload is too long.
+ */
+BOOLEAN uartSendFrame( E_UART_ID id, E_UART_STREAM stream, const U8 *data,
+        U16 length ) {
+    uint8 *p_frame;
+    uint32 crc;
+
+    if ( ( length > UART_FRAME_PAYLOAD_SIZE ) || ( uartIsTxIdle( id ) == FALSE ) ) {
+        return FALSE;
+    }
+
+    p_frame = &uart_tx_frame [ id ] [ 0 ];
+    p_frame [ 0 ] = UART_FRAME_SYNC_0;
+    p_frame [ 1 ] = UART_FRAME_SYNC_1;
+    p_frame [ 2 ] = ( uint8 ) stream;
+    p_frame [ 3 ] = ( uint8 ) ( length >> 8 );
+    p_frame [ 4 ] = ( uint8 ) ( length );
+    memcpy( &p_frame [ 5 ], data, length );
+
+    crc = crc32( &p_frame [ 2 ], length + 3U );
+    p_frame [ 5 + length ] = ( uint8 ) ( crc >> 24 );
+    p_frame [ 6 + length ] = ( uint8 ) ( crc >> 16 );
+    p_frame [ 7 + length ] = ( uint8 ) ( crc >> 8 );
+    p_frame [ 8 + length ] = ( uint8 ) ( crc );
+
+    sciSend( UART( id ), length + UART_FRAME_OVERHEAD, p_frame );
+
+    return TRUE;
+}
+
 void sciNotification( sciBASE_t *sci, uint32 flags ) {
     uint8 ch;
-    BaseType_t xHigherPriorityTaskWoken;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     S_UART_INFO sci_info;
     /* Determine which SCI RX buffer array index to use:
      *   eUART_0 .. eUART_3 corresponding to sciREG1 .. sciREG3
@@ -250,8 +302,8 @@ void sciNotification( sciBASE_t *sci, uint32 flags ) {
                 memcpy( &sci_info.payload, &sci_rx_buffer [ sci_idx ] [ 0 ],
                         sci_info.payload_length );
 
-                /* Send to queue */
-                xQueueSendFromISR( xUARTQueueHandle, &sci_info,
+                /* Hand over to the gatekeeper */
+                gkPostFromISR( eGK_SRC_UART_RX, &sci_info,
                         &xHigherPriorityTaskWoken );
 
                 /* Reset for next packet */
@@ -283,6 +335,22 @@ void sciNotification( sciBASE_t *sci, uint32 flags ) {
     default:
         break;
     }
+
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+
+/* Gatekeeper handler of eGK_SRC_UART_RX, runs in the GK task.
+ *   STX 'H' history level ETX ( ASCII digits ): dump a data manager history
+ */
+void uartRxFrameHandler( const void *item ) {
+    const S_UART_INFO *p_info = ( const S_UART_INFO* ) item;
+
+    LOG2( eLOG_MSG_UART_RX_FRAME, p_info->id, p_info->payload_length );
+
+    if ( ( p_info->payload_length == 5U ) && ( p_info->payload [ 1 ] == 'H' ) ) {
+        dmHistoryRequest( ( U32 ) ( p_info->payload [ 2 ] - '0' ),
+                ( U32 ) ( p_info->payload [ 3 ] - '0' ) );
+    }
 }
 
 /* SourceId : SCI_SourceId_002 */
@@ -929,6 +997,7 @@ void sci3HighLevelInterrupt( void ) {
     uint32 vec = sciREG3->INTVECT0;
     uint8 byte;
     /* USER CODE BEGIN (37) */
+    TRC_ISR_ENTER( eTRC_ISR_SCI3 );
     /* USER CODE END */
 
     switch ( vec ) {
@@ -983,6 +1052,7 @@ void sci3HighLevelInterrupt( void ) {
         break;
     }
     /* USER CODE BEGIN (38) */
+    TRC_ISR_EXIT( eTRC_ISR_SCI3 );
     /* USER CODE END */
 }
 
@@ -998,6 +1068,7 @@ void sci4HighLevelInterrupt( void ) {
     uint32 vec = sciREG4->INTVECT0;
     uint8 byte;
     /* USER CODE BEGIN (41) */
+    TRC_ISR_ENTER( eTRC_ISR_SCI4 );
     /* USER CODE END */
 
     switch ( vec ) {
@@ -1052,6 +1123,7 @@ void sci4HighLevelInterrupt( void ) {
         break;
     }
     /* USER CODE BEGIN (42) */
+    TRC_ISR_EXIT( eTRC_ISR_SCI4 );
     /* USER CODE END */
 }
 
@@ -47,6 +47,11 @@
 #define SCI_IDLE_INT            ( 0x00000800U )     /* Halcogen doesn't generate this in HL_sci.h */
 #define SCI_TIMEOUT             10000
 
+#define UART_FRAME_SYNC_0       0xA5u               /* Binary frame: SYNC_0 SYNC_1 stream len_hi len_lo payload crc32 */
+#define UART_FRAME_SYNC_1       0x5Au
+#define UART_FRAME_PAYLOAD_SIZE 252u                /* Bytes */
+#define UART_FRAME_OVERHEAD     9u                  /* 2 sync, stream, 2 length, 4 crc */
+
 #define UART( x )               ( ( ( x ) == eUART_0 ) ? sciREG1 : ( ( x ) == eUART_1 ) ? sciREG2 : ( ( x ) == eUART_2 ) ? sciREG3 : sciREG4 )
 #define UART_IDX( x )           ( ( ( x ) == sciREG1 ) ? eUART_0 : ( ( x ) == sciREG2 ) ? eUART_1 : ( ( x ) == sciREG3 ) ? eUART_2 : eUART_3 )
 
@@ -67,6 +72,16 @@ typedef enum
     eUART_MAX,
 } E_UART_ID;
 
+/* Binary frame streams multiplexed on a debug UART
+ */
+typedef enum
+{
+    eUART_STREAM_TRACE = 1u,
+    eUART_STREAM_LOG,
+    eUART_STREAM_HISTORY,
+    eUART_STREAM_MAX,
+} E_UART_STREAM;
+
 /* Note: Baud rate determines the prescaler value
  */
 typedef enum
@@ -139,6 +154,9 @@ extern xQueueHandle xUARTQueueHandle;
 
 void uart_init( void );
 const S_UART_CONFIG * const uartGetConfig( void );
+BOOLEAN uartIsTxIdle( E_UART_ID id );
+BOOLEAN uartSendFrame( E_UART_ID id, E_UART_STREAM stream, const U8 *data, U16 length );
+void uartRxFrameHandler( const void *item );
 
 /*----------------------------------------------------------------------------\
 |   End of fw_uart.h header file                                              |
@@ -29,6 +29,7 @@
 
 #include <stdint.h>
 
+#include "fw_timebase.h"
 #include "fw_utils.h"
 
 /*----------------------------------------------------------------------------\
@@ -59,36 +60,15 @@
 |   Public Function Implementations                                           |
 \----------------------------------------------------------------------------*/
 
+/* Spins on the timebase ( RTI counter 1 ), the FreeRTOS tick counter is left
+ * alone. A task that can block should use tbSleepUs() instead.
+ */
 void delayMicroseconds( uint32_t microseconds )
 {
-    static uint8_t initialized = 0;
+    U64 end = tbNowTicks() + TB_US_TO_TICKS( microseconds );
 
-    // Initialize timer on first use
-    if ( !initialized )
+    while ( tbNowTicks() < end )
     {
-        // Stop RTI
-        rtiREG1->GCTRL = 0x0;
-
-        // Configure for microsecond counting (RTICLK = 80MHz)
-        rtiREG1->CNT[0].CPUCx = 79;  // Divide by 80 for 1MHz
-
-        // Enable counter 0
-        rtiREG1->GCTRL |= 0x1;
-
-        initialized = 1;
-    }
-
-    uint32_t start = rtiREG1->CNT[0].FRCx;
-    uint32_t target = start + microseconds;
-
-    if ( target < start )
-    {
-        while ( rtiREG1->CNT[ 0 ].FRCx >= start ) ;
-        while ( rtiREG1->CNT[ 0 ].FRCx < target ) ;
-    }
-    else
-    {
-        while ( rtiREG1->CNT[ 0 ].FRCx < target ) ;
     }
 }
 
@@ -42,7 +42,21 @@ typedef volatile struct rtiBase
         volatile uint32_t UCx;     // 0x0014, 0x0034: Up Counter x
         volatile uint32_t CPUCx;   // 0x0018, 0x0038: Compare Up Counter x
         volatile uint32_t reserved; // 0x001C, 0x003C: Reserved
+        volatile uint32_t CAFRCx;  // 0x0020, 0x0040: Capture Free Running Counter x
+        volatile uint32_t CAUCx;   // 0x0024, 0x0044: Capture Up Counter x
+        volatile uint32_t rsvd[2]; // 0x0028, 0x0048: Reserved
     } CNT[2];
+    struct
+    {
+        volatile uint32_t COMPx;   // 0x0050 + 8 * x: Compare x
+        volatile uint32_t UDCPx;   // 0x0054 + 8 * x: Update Compare x
+    } CMP[4];
+    volatile uint32_t TBLCOMP;    // 0x0070: External Clock Timebase Low Compare
+    volatile uint32_t TBHCOMP;    // 0x0074: External Clock Timebase High Compare
+    volatile uint32_t rsvd1[2];   // 0x0078: Reserved
+    volatile uint32_t SETINTENA;  // 0x0080: Set Interrupt Enable Register
+    volatile uint32_t CLEARINTENA; // 0x0084: Clear Interrupt Enable Register
+    volatile uint32_t INTFLAG;    // 0x0088: Interrupt Flag Register
 } rtiBASE_t;
 
 /*----------------------------------------------------------------------------\
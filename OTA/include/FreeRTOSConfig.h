@@ -156,6 +156,29 @@
 #define INCLUDE_xTaskGetIdleTaskHandle      1
 
 /* USER CODE BEGIN (4) */
+
+/* Binary event trace recorder ( components/fw_trace ).
+ * The macros expand inside os_tasks.c / os_queue.c, where pxCurrentTCB and
+ * the TCB / queue structures are visible.
+ */
+#include "fw_trace.h"
+
+#if ( TRC_ENABLED == 1 )
+#define traceTASK_CREATE( pxNewTCB )                trcTaskCreate( ( pxNewTCB ), ( pxNewTCB )->pcTaskName, ( U16 ) ( pxNewTCB )->uxPriority )
+#define traceTASK_SWITCHED_IN()                     trcRecord( eTRC_EVT_TASK_SWITCHED_IN, ( U16 ) pxCurrentTCB->uxPriority, ( U32 ) pxCurrentTCB )
+#define traceTASK_SWITCHED_OUT()                    trcRecord( eTRC_EVT_TASK_SWITCHED_OUT, 0u, ( U32 ) pxCurrentTCB )
+#define traceTASK_DELAY_UNTIL( x )                  trcRecord( eTRC_EVT_TASK_DELAY_UNTIL, 0u, ( U32 ) ( x ) )
+#define traceQUEUE_CREATE( pxNewQueue )             trcRecord( eTRC_EVT_QUEUE_CREATE, ( U16 ) ( pxNewQueue )->uxLength, ( U32 ) ( pxNewQueue ) )
+#define traceQUEUE_SEND( pxQueue )                  trcRecord( eTRC_EVT_QUEUE_SEND, ( U16 ) ( pxQueue )->uxMessagesWaiting, ( U32 ) ( pxQueue ) )
+#define traceQUEUE_SEND_FAILED( pxQueue )           trcRecord( eTRC_EVT_QUEUE_SEND_FAILED, ( U16 ) ( pxQueue )->uxMessagesWaiting, ( U32 ) ( pxQueue ) )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )         trcRecord( eTRC_EVT_QUEUE_SEND_FROM_ISR, ( U16 ) ( pxQueue )->uxMessagesWaiting, ( U32 ) ( pxQueue ) )
+#define traceQUEUE_RECEIVE( pxQueue )               trcRecord( eTRC_EVT_QUEUE_RECEIVE, ( U16 ) ( pxQueue )->uxMessagesWaiting, ( U32 ) ( pxQueue ) )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue )        trcRecord( eTRC_EVT_QUEUE_RECEIVE_FAILED, ( U16 ) ( pxQueue )->uxMessagesWaiting, ( U32 ) ( pxQueue ) )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )      trcRecord( eTRC_EVT_QUEUE_RECEIVE_FROM_ISR, ( U16 ) ( pxQueue )->uxMessagesWaiting, ( U32 ) ( pxQueue ) )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )      trcRecord( eTRC_EVT_QUEUE_BLOCK_ON_SEND, ( U16 ) ( pxQueue )->uxMessagesWaiting, ( U32 ) ( pxQueue ) )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )   trcRecord( eTRC_EVT_QUEUE_BLOCK_ON_RECEIVE, ( U16 ) ( pxQueue )->uxMessagesWaiting, ( U32 ) ( pxQueue ) )
+#endif
+
 /* USER CODE END */
 
 
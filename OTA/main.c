@@ -13,17 +13,22 @@
 #include "app_task_1000ms.h"
 #include "app_task_2000ms.h"
 #include "app_task_5000ms.h"
+#include "ctx_bench.h"
 #include "data_manager.h"
 #include "fw_adc.h"
+#include "fw_adc_tone.h"
 #include "fw_dio.h"
-#include "fw_gio_dmm.h"
-#include "fw_gio_het.h"
+#include "fw_dio_sched.h"
+#include "fw_het.h"
+#include "fw_pool.h"
+#include "fw_timebase.h"
+#include "fw_twheel.h"
 #include "fw_uart.h"
 #include "setup.h"
+#include "gatekeeper.h"
 
-#include "fw_gio_dmm.h"
-#include "fw_gio_het.h"
-#include "fw_gio_mibspi.h"
+#include "fw_trace.h"
+#include "fw_log.h"
 
 /**
  * main.c
@@ -33,6 +38,13 @@ int main( void ) {
     portBaseType free_rtos_ok = pdFAIL; /* Defensively assume OS is down */
     S_UART_INFO tx_info;
 
+    /* Trace recorder and logger first, so that the whole start-up is captured */
+    trcInit();
+    logInit();
+
+    /* Fixed block pools, before their first user */
+    poolInit();
+
     /* Enable global interrupts */
     // _enable_interrupt_();
     dmDataManagerInit();
@@ -40,19 +52,34 @@ int main( void ) {
     /* Enable global interrupts */
     _enable_interrupt_();
 
+    /* High resolution timebase, before anything that waits on it */
+    tbInit();
+    twInit();
+
     /* CAUTION:
      *   Call to dioHandlerInit must precede GIO initializations
      */
     dioHandlerInit();
 
-    // printf( "Initializing Digital Inputs\n" );
+    LOG0( eLOG_MSG_DIO_INPUTS_INIT );
     dioHandlerInitInputPins();
 
-    // printf( "Initializing Digital Outputs\n" );
+    LOG0( eLOG_MSG_DIO_OUTPUTS_INIT );
     dioHandlerInitOutputPins();
+    dioSchedInit();
+
+    LOG0( eLOG_MSG_HET_INIT );
+    hetPwmInit();
+
+    LOG0( eLOG_MSG_ADC_INIT );
+    adcToneInit();
+    adc_init();
 
     uart_init();
 
+    /* Gatekeeper queues, must exist before the tasks copy their handles */
+    gkInit();
+
     tx_info.id = eUART_2; /* SCI1 */
     tx_info.sci = UART( eUART_2 );
 
@@ -93,34 +120,36 @@ int main( void ) {
     app_task_5000ms_init();
 
     /* FreeRTOS initialization and execution section */
-    // printf( "Initializing core information\n" );                     /* Core's info initialization */
+    LOG0( eLOG_MSG_CORE_INFO_INIT );                                  /* Core's info initialization */
     tskInitCoreInfo();
 
-    // printf( "Initializing process data of all FreeRTOS tasks\n" );   /* Tasks process data initialization */
+    LOG0( eLOG_MSG_PROC_DATA_INIT );                                  /* Tasks process data initialization */
     tskInitProcData();
 
-    // printf( "Core's scheduler state: MAIN START\n" );                /* Update core scheduler state: "In main" */
+    LOG1( eLOG_MSG_CORE_MAIN_START, coreid );                         /* Update core scheduler state: "In main" */
     CoreInfo [ coreid ].corestate = CORE_STATE_MAINSTART;
 
-    // printf( "Initializing the core's stack for FreeRTOS use\n" );    /* Initialize the core's stack for FreeRTOS use */
+    LOG0( eLOG_MSG_CORE_STACK_INIT );                                 /* Initialize the core's stack for FreeRTOS use */
     tskInitCoreStack( coreid );
 
-    // printf( "Core's scheduler state: INITIALIZED\n" );               /* Core's FreeRTOS scheduler initialized */
+    LOG1( eLOG_MSG_CORE_INITIALIZED, coreid );                        /* Core's FreeRTOS scheduler initialized */
     CoreInfo [ coreid ].corestate = CORE_STATE_SCHEDOK;
 
     // TODO: serial queue
 
-    // printf( "Creating core's FreeRTOS tasks!\r\n" );              /* Create the core tasks for FreeRTOS */
+    ctxBenchInit();                                                   /* Context switch benchmark, when enabled */
+
+    LOG0( eLOG_MSG_CORE_CREATE_TASKS );                            /* Create the core tasks for FreeRTOS */
     free_rtos_ok = tskCreateCoreTasks( coreid );
 
     if ( pdPASS == free_rtos_ok ) /* Successfully created tasks */
     {
         CoreInfo [ coreid ].corestate = CORE_STATE_APPOK; /* Core Scheduler will be put in running state */
 
-        // printf("Core's scheduler state: RUNNING\n");                 /* Start the FreeRTOS scheduler */
+        LOG1( eLOG_MSG_CORE_RUNNING, coreid );                         /* Start the FreeRTOS scheduler */
         vTaskStartScheduler(); /* Should never return from this call */
 
-        // printf("Core's scheduler state: FAILED\n");                  /* Core Scheduler failed to enter running state */
+        LOG1( eLOG_MSG_CORE_SCHED_FAILED, coreid );                    /* Core Scheduler failed to enter running state */
         CoreInfo [ coreid ].corestate = CORE_STATE_SCHEDFAIL;
     }
 
@@ -55,6 +55,7 @@
 #include "HL_sys_dma.h"
 
 /* USER CODE BEGIN (0) */
+#include "fw_trace.h"
 /* USER CODE END */
 #pragma WEAK(esmGroup1Notification)
 void esmGroup1Notification(esmBASE_t *esm, uint32 channel)
@@ -113,6 +114,8 @@ void gioNotification(gioPORT_t *port, uint32 bit)
 {
 /*  enter user code between the USER CODE BEGIN and USER CODE END. */
 /* USER CODE BEGIN (22) */
+    TRC_ISR_ENTER( eTRC_ISR_GIO );
+    TRC_ISR_EXIT( eTRC_ISR_GIO );
 /* USER CODE END */
 }
 
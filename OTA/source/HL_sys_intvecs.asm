@@ -44,6 +44,7 @@
     .ref _c_int00
     .ref vPortSWI
     .ref phantomInterrupt
+    .ref vPortUndefHandler
     .def resetEntry
 
 ;-------------------------------------------------------------------------------
@@ -52,7 +53,7 @@
 resetEntry
         b   _c_int00
 undefEntry
-        b   undefEntry
+        b   vPortUndefHandler
         b   vPortSWI
 prefetchEntry
         b   prefetchEntry
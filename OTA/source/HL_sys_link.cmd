@@ -55,12 +55,19 @@ MEMORY
     VECTORS (X)  : origin=0x00000000 length=0x00000020
     KERNEL  (RX) : origin=0x00000020 length=0x00008000 
     FLASH0  (RX) : origin=0x00008020 length=0x001F7FE0
-    FLASH1  (RX) : origin=0x00200000 length=0x00200000
+    FLASH1  (RX) : origin=0x00200000 length=0x001E0000
     STACKS  (RW) : origin=0x08000000 length=0x00000800
     KRAM    (RW) : origin=0x08000800 length=0x00000800
     RAM     (RW) : origin=(0x08000800+0x00000800) length=(0x0007F800 - 0x00000800)
     
 /* USER CODE BEGIN (2) */
+    /* ADC calibration table ( fw_adc_cal ), alone in the last sector of bank 1, taken off FLASH1 above.
+       No section goes there, only the ECC of its erased words ( vfill ): flash ECC checking is always
+       on, and adcCalInit() reads the sector before the production tool has programmed the table.
+       Loading the application erases the sector, the table is programmed after it */
+    ADCCAL  (R)  : origin=0x003E0000 length=0x00020000 vfill=0xffffffff
+    ECC_CAL (R)  : origin=(0xf0400000 + (start(ADCCAL) >> 3)) length=(size(ADCCAL) >> 3)
+                   ECC={algorithm=algoL2R5F021, input_range=ADCCAL}
 /* USER CODE END */
 }
 
@@ -87,6 +94,8 @@ SECTIONS
     .data         : {} > RAM    
 
 /* USER CODE BEGIN (4) */
+    /* ADC calibration table ( fw_adc_cal ), see ADCCAL */
+    adc_cal_flash = 0x003E0000;
 /* USER CODE END */
 }
 
@@ -97,6 +106,14 @@ SECTIONS
 /* Misc                                                                       */
 
 /* USER CODE BEGIN (6) */
+/* F021 flash ECC, for ECC_CAL */
+ECC
+{
+    algoL2R5F021 : address_mask = 0xfffffff8
+                   hamming_mask = R4
+                   parity_mask  = 0x0c
+                   mirroring    = F021
+}
 /* USER CODE END */
 
 /*----------------------------------------------------------------------------*/
@@ -81,6 +81,8 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "os_task.h"
 
+#include "fw_pool.h"
+
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
 /* Block sizes must not get too small. */
@@ -119,6 +121,13 @@ static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert );
  */
 static void prvHeapInit( void );
 
+/*
+ * The heap_4 allocator proper.  pvPortMalloc() and vPortFree() put the fixed
+ * block pools of fw_pool.c in front of it.
+ */
+static void *prvHeapMalloc( size_t xWantedSize );
+static void prvHeapFree( void *pv );
+
 /*-----------------------------------------------------------*/
 
 
@@ -145,6 +154,47 @@ static size_t xBlockAllocatedBit = 0;
 
 void *pvPortMalloc( size_t xWantedSize )
 {
+void *pvReturn = NULL;
+
+	/* Objects created before the scheduler starts (task stacks, TCBs, queues)
+	live for good and are taken from heap_4, where they cannot fragment
+	anything.  Once it runs, whatever fits a pool block is taken from the
+	pools in fixed time; heap_4 keeps the larger requests, and the smaller
+	ones while the pools that fit are empty (counted as pool failures). */
+	if( ( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED ) && ( xWantedSize <= POOL_BLOCK_MAX ) )
+	{
+		pvReturn = poolAlloc( ( uint32_t ) xWantedSize );
+	}
+
+	if( pvReturn != NULL )
+	{
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	else
+	{
+		pvReturn = prvHeapMalloc( xWantedSize );
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+	if( poolOwns( pv ) != FALSE )
+	{
+		traceFREE( pv, 0 );
+		( void ) poolFree( pv );
+	}
+	else
+	{
+		prvHeapFree( pv );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void *prvHeapMalloc( size_t xWantedSize )
+{
 BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
 void *pvReturn = NULL;
 
@@ -293,7 +343,7 @@ void *pvReturn = NULL;
 }
 /*-----------------------------------------------------------*/
 
-void vPortFree( void *pv )
+static void prvHeapFree( void *pv )
 {
 uint8_t *puc = ( uint8_t * ) pv;
 BlockLink_t *pxLink;
@@ -77,6 +77,7 @@
 #include "HL_sys_core.h"
 
 /* USER CODE BEGIN (1) */
+#include "fw_log.h"
 /* USER CODE END */
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
@@ -139,6 +140,24 @@ uint32_t ulTaskHasFPUContext = 0;
 
 /*-----------------------------------------------------------*/
 /* USER CODE BEGIN (5) */
+
+extern void * volatile pxCurrentTCB;
+
+/* Number of tasks that used the VFP without vPortTaskUsesFPU(). */
+volatile uint32_t ulFPUTrapCount = 0;
+
+/* Called by vPortUndefHandler, in undefined instruction mode, on the first
+VFP instruction of a task that has no floating point context. The task keeps
+the context it has just been given, so this only reports it. Set usesfpu in
+the task's S_TASK_CONFIG entry to get rid of the report. A trap taken from an
+ISR ( mode in ulSPSR is IRQ or FIQ ) means the ISR uses the VFP, which the port
+does not support at all: the interrupted task is left unmarked and the handler
+hangs once this returns. */
+void vPortFPUTrap( uint32_t ulSPSR, uint32_t ulAddress )
+{
+	ulFPUTrapCount++;
+	LOG3( eLOG_MSG_FPU_UNMARKED_USE, ( uint32_t ) pxCurrentTCB, ulAddress, ulSPSR & 0x1FUL );
+}
 /* USER CODE END */
 
 /*-----------------------------------------------------------*/
@@ -353,8 +372,9 @@ static void prvSetupTimerInterrupt(void)
 	/* Use the internal counter. */
 	portRTI_TBCTRL_REG = 0x00000000U;
 
-	/* COMPSEL0 will use the RTIFRC0 counter. */
-	portRTI_COMPCTRL_REG = 0x00000000U;
+	/* COMPSEL0 will use the RTIFRC0 counter. Counter 1 and its compares
+	 * belong to the timebase ( fw_timebase ). */
+	portRTI_COMPCTRL_REG &= 0xFFFFFFFEUL;
 
 	/* Initialise the counter and the prescale counter registers. */
 	portRTI_CNT0_UC0_REG  =  0x00000000U;
@@ -365,9 +385,9 @@ static void prvSetupTimerInterrupt(void)
 	portRTI_CNT0_COMP0_REG = ( configCPU_CLOCK_HZ / 2 ) / configTICK_RATE_HZ;
 	portRTI_CNT0_UDCP0_REG = ( configCPU_CLOCK_HZ / 2 ) / configTICK_RATE_HZ;
 
-	/* Clear interrupts. */
-	portRTI_INTFLAG_REG     =  0x0007000FU;
-	portRTI_CLEARINTENA_REG	= 0x00070F0FU;
+	/* Clear the compare 0 and counter 0 overflow interrupts only. */
+	portRTI_INTFLAG_REG     =  0x00020001U;
+	portRTI_CLEARINTENA_REG	= 0x00020101U;
 
 	/* Enable the compare 0 interrupt. */
 	portRTI_SETINTENA_REG = 0x00000001U;
@@ -59,6 +59,7 @@
         .ref   ulTaskHasFPUContext
         .ref   pxCurrentTCB
         .ref   ulCriticalNesting;
+        .ref   vPortFPUTrap
 
 ;/*-----------------------------------------------------------*/
 ;
@@ -158,6 +159,13 @@ portRESTORE_CONTEXT .macro
         ; Test the flag
         CMP     R1, #0
 
+        ; Only tasks with a floating point context run with the VFP enabled,
+        ; a VFP instruction in any other task traps to vPortUndefHandler.
+        FMRX    R2, FPEXC
+        BICEQ   R2, R2, #0x40000000
+        ORRNE   R2, R2, #0x40000000
+        FMXR    FPEXC, R2
+
         ; If the task is not using a floating point context then skip the
         ; VFP register loads.
         BEQ     $+16
@@ -340,12 +348,72 @@ swiPortTaskUsesFPU
         ldr     r12, ulTaskHasFPUContextConst
         mov     r11, #1
         str     r11, [r12]
+        fmrx    r11, FPEXC
+        orr     r11, r11, #0x40000000
+        fmxr    FPEXC, r11
         mov     r11, #0
         fmxr    FPSCR, r11
         bx      r14
 
         .endasmfunc
 ;-------------------------------------------------------------------------------
+; Undefined instruction handler
+;
+; The VFP is disabled while a task without floating point context runs, so
+; its first VFP instruction ends up here. The task is given a floating point
+; context from now on, vPortFPUTrap() reports it and the instruction is
+; retried. Anything else is a genuine undefined instruction and hangs here,
+; as the HALCoGen default vector did.
+
+        .def    vPortUndefHandler
+        .asmfunc
+vPortUndefHandler
+        stmfd   sp!, {r0-r4, r12, lr}
+        fmrx    r0, FPEXC
+        tst     r0, #0x40000000
+        bne     vPortUndefHang
+
+        ; Address of the trapped instruction, to return to it
+        mrs     r0, spsr
+        tst     r0, #0x20
+        subeq   r1, lr, #4
+        subne   r1, lr, #2
+        str     r1, [sp, #24]
+
+        ; Trapped in IRQ or FIQ mode: an ISR used the VFP. No context covers
+        ; that, so report it and hang without marking the interrupted task.
+        and     r2, r0, #0x1F
+        cmp     r2, #0x12
+        cmpne   r2, #0x11
+        beq     vPortUndefISR
+
+        ; Enable the VFP and mark the current task as using it
+        fmrx    r2, FPEXC
+        orr     r2, r2, #0x40000000
+        fmxr    FPEXC, r2
+        mov     r2, #0
+        fmxr    FPSCR, r2
+        ldr     r12, ulTaskHasFPUContextConst
+        mov     r2, #1
+        str     r2, [r12]
+
+        ; vPortFPUTrap( spsr, address ), on an 8 byte aligned stack ( AAPCS )
+        ; whatever the undefined mode stack alignment was on entry
+        mov     r4, sp
+        bic     sp, sp, #7
+        bl      vPortFPUTrap
+        mov     sp, r4
+        ldmfd   sp!, {r0-r4, r12, pc}^
+
+vPortUndefISR
+        mov     r4, sp
+        bic     sp, sp, #7
+        bl      vPortFPUTrap
+
+vPortUndefHang
+        b       vPortUndefHang
+        .endasmfunc
+;-------------------------------------------------------------------------------
 ; swiRaisePrivilege
 
 ; Must return zero in R0 if caller was in user mode
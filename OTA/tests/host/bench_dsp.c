@@ -0,0 +1,250 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : bench_dsp.c Module File.                                   |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   fw_dsp cost per sample.                                                   |
+|                                                                             |
+|   Every filter runs over 16 channels, once as one block call and once as    |
+|   16 single channel filters called in turn, the layout a per channel        |
+|   structure would give. Reported: nanoseconds and cycles per channel        |
+|   sample. Cycles are time stamp counter ticks on x86 hosts and read 0       |
+|   elsewhere. They are host cycles and only rank the filters and the two     |
+|   layouts; the target figure needs the PMU cycle counter.                   |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+    #include <x86intrin.h>
+    #define BENCH_CYCLES()          ( ( uint64_t ) __rdtsc() )
+#else
+    #define BENCH_CYCLES()          ( ( uint64_t ) 0u )
+#endif
+
+#include "host_test.h"
+
+#include "fw_dsp.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define BENCH_CHANNELS              16u
+#define BENCH_STEPS                 200000u
+#define BENCH_INPUT_ROWS            256u                /* Inputs cycled through, power of 2 */
+#define BENCH_MOVAVG_LOG2           4u
+#define BENCH_MEDIAN_LENGTH         5u
+#define BENCH_RATE_SHIFT            3u
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+typedef enum
+{
+    eFILTER_LOWPASS = 0u,
+    eFILTER_MOVAVG,
+    eFILTER_MEDIAN,
+    eFILTER_RATE,
+    eFILTER_GOERTZEL,
+    eFILTER_MAX,
+} E_FILTER;
+
+/* One filter of every kind over channels channels, with its storage */
+typedef struct
+{
+    U32                         channels;
+    S_DSP_LOWPASS               lowpass;
+    U32                         lowpass_coef[ BENCH_CHANNELS ];
+    Q15                         lowpass_y[ BENCH_CHANNELS ];
+    S_DSP_MOVAVG                movavg;
+    Q15                         movavg_history[ DSP_MOVAVG_WORDS( BENCH_CHANNELS, BENCH_MOVAVG_LOG2 ) ];
+    Q31                         movavg_sum[ BENCH_CHANNELS ];
+    Q15                         movavg_y[ BENCH_CHANNELS ];
+    S_DSP_MEDIAN                median;
+    Q15                         median_history[ DSP_MEDIAN_WORDS( BENCH_CHANNELS, BENCH_MEDIAN_LENGTH ) ];
+    Q15                         median_y[ BENCH_CHANNELS ];
+    S_DSP_RATE                  rate;
+    U32                         rate_coef[ BENCH_CHANNELS ];
+    Q15                         rate_previous[ BENCH_CHANNELS ];
+    Q15                         rate_y[ BENCH_CHANNELS ];
+    S_DSP_GOERTZEL              goertzel[ BENCH_CHANNELS ];
+} S_BENCH_BANK;
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static const char * const bench_names[ eFILTER_MAX ] =
+{
+    [ eFILTER_LOWPASS ] = "low-pass",
+    [ eFILTER_MOVAVG ] = "moving average 16",
+    [ eFILTER_MEDIAN ] = "median 5",
+    [ eFILTER_RATE ] = "rate",
+    [ eFILTER_GOERTZEL ] = "goertzel step",
+};
+
+static Q15 bench_input[ BENCH_INPUT_ROWS ][ BENCH_CHANNELS ];
+static S_BENCH_BANK bench_block;
+static S_BENCH_BANK bench_single[ BENCH_CHANNELS ];
+static volatile S32 bench_sink;
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+static void benchBankInit( S_BENCH_BANK *b, U32 channels, U32 first )
+{
+    Q15 a[ BENCH_CHANNELS ];
+    Q15 g[ BENCH_CHANNELS ];
+    U32 i;
+
+    for ( i = 0u; i < channels; i++ )
+    {
+        a[ i ] = ( Q15 ) ( 1000 + ( 500 * ( first + i ) ) );
+        g[ i ] = ( Q15 ) ( 4096 - ( 300 * ( first + i ) ) );
+        dspGoertzelInit( &b->goertzel[ i ], dspGoertzelCoef( 50u * ( first + i + 1u ), 1000u ) );
+    }
+
+    b->channels = channels;
+    ( void ) dspLowpassInit( &b->lowpass, channels, b->lowpass_coef, b->lowpass_y, a );
+    ( void ) dspMovingAverageInit( &b->movavg, channels, BENCH_MOVAVG_LOG2, b->movavg_history, b->movavg_sum, b->movavg_y );
+    ( void ) dspMedianInit( &b->median, channels, BENCH_MEDIAN_LENGTH, b->median_history, b->median_y );
+    ( void ) dspRateInit( &b->rate, channels, BENCH_RATE_SHIFT, b->rate_coef, b->rate_previous, b->rate_y, g );
+}
+
+/* One step of a filter of a bank over its channels */
+static void benchStep( S_BENCH_BANK *b, E_FILTER filter, const Q15 *x )
+{
+    U32 i;
+
+    switch ( filter )
+    {
+        case eFILTER_LOWPASS:
+            dspLowpass( &b->lowpass, x );
+            break;
+
+        case eFILTER_MOVAVG:
+            dspMovingAverage( &b->movavg, x );
+            break;
+
+        case eFILTER_MEDIAN:
+            dspMedian( &b->median, x );
+            break;
+
+        case eFILTER_RATE:
+            dspRate( &b->rate, x );
+            break;
+
+        default:
+            for ( i = 0u; i < b->channels; i++ )
+            {
+                dspGoertzelStep( &b->goertzel[ i ], ( S32 ) x[ i ] >> 4 );
+            }
+            break;
+    }
+}
+
+/* Time per channel sample of BENCH_STEPS steps over all channels */
+static void benchRun( E_FILTER filter, BOOLEAN block, double *ns, double *cycles )
+{
+    uint64_t start_ns;
+    uint64_t start_cycles;
+    U32 step;
+    U32 i;
+
+    start_ns = hostNowNs();
+    start_cycles = BENCH_CYCLES();
+
+    for ( step = 0u; step < BENCH_STEPS; step++ )
+    {
+        const Q15 *x = bench_input[ step & ( BENCH_INPUT_ROWS - 1u ) ];
+
+        if ( block == TRUE )
+        {
+            benchStep( &bench_block, filter, x );
+        }
+        else
+        {
+            for ( i = 0u; i < BENCH_CHANNELS; i++ )
+            {
+                benchStep( &bench_single[ i ], filter, &x[ i ] );
+            }
+        }
+
+        /* The Goertzel state must not grow past one block */
+        if ( ( filter == eFILTER_GOERTZEL ) && ( ( step % 1000u ) == 999u ) )
+        {
+            for ( i = 0u; i < BENCH_CHANNELS; i++ )
+            {
+                bench_sink += ( S32 ) dspGoertzelAmplitude( ( block == TRUE ) ? &bench_block.goertzel[ i ] : &bench_single[ i ].goertzel[ 0 ], 1000u );
+            }
+        }
+    }
+
+    *cycles = ( double ) ( BENCH_CYCLES() - start_cycles ) / ( double ) ( BENCH_STEPS * BENCH_CHANNELS );
+    *ns = ( double ) ( hostNowNs() - start_ns ) / ( double ) ( BENCH_STEPS * BENCH_CHANNELS );
+
+    bench_sink += bench_block.lowpass_y[ 0 ] + bench_single[ 0 ].median_y[ 0 ];
+}
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+int main( void )
+{
+    uint32_t seed = 0x600DF00Du;
+    double block_ns, block_cycles;
+    double single_ns, single_cycles;
+    U32 filter;
+    U32 r;
+    U32 i;
+
+    for ( r = 0u; r < BENCH_INPUT_ROWS; r++ )
+    {
+        for ( i = 0u; i < BENCH_CHANNELS; i++ )
+        {
+            bench_input[ r ][ i ] = ( Q15 ) ( hostRand( &seed ) >> 16 );
+        }
+    }
+
+    benchBankInit( &bench_block, BENCH_CHANNELS, 0u );
+    for ( i = 0u; i < BENCH_CHANNELS; i++ )
+    {
+        benchBankInit( &bench_single[ i ], 1u, i );
+    }
+
+    printf( "dsp: %u channels, %u steps, per channel sample\n", BENCH_CHANNELS, BENCH_STEPS );
+    printf( "%-20s %12s %12s %12s %12s\n", "", "block ns", "block cyc", "single ns", "single cyc" );
+
+    for ( filter = 0u; filter < eFILTER_MAX; filter++ )
+    {
+        benchRun( ( E_FILTER ) filter, TRUE, &block_ns, &block_cycles );
+        benchRun( ( E_FILTER ) filter, FALSE, &single_ns, &single_cycles );
+
+        printf( "%-20s %12.2f %12.1f %12.2f %12.1f\n", bench_names[ filter ], block_ns, block_cycles, single_ns, single_cycles );
+    }
+
+    return HOST_RESULT();
+}
+
+/*----------------------------------------------------------------------------\
+|   End of bench_dsp.c module                                                 |
+\----------------------------------------------------------------------------*/
@@ -0,0 +1,241 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : bench_gatekeeper.c Module File.                            |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Gatekeeper latency, polling against event driven, on a model.             |
+|                                                                             |
+|   gatekeeper.c is not built here: both gatekeepers are pthread models of    |
+|   it, a mutex and condition variable standing in for the queue and the      |
+|   task notification. A producer thread posts time-stamped items at random   |
+|   intervals into a 5 item queue ( UART_QUEUE_LENGTH ). The polling model    |
+|   is the old task_C0_GK: wake every period, receive at most one item. The   |
+|   event driven model follows gkServe(): block until signalled, drain the    |
+|   queue. Reported: post to service latency, wake-ups and items dropped on   |
+|   a full queue. The period is 10 ms here, 100 ms on the target; the         |
+|   polling latency scales with it, the event driven one does not.            |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "host_test.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define BENCH_ITEMS                 400u
+#define BENCH_QUEUE_LENGTH          5u
+#define BENCH_PERIOD_NS             10000000u           /* Polling period */
+#define BENCH_GAP_MAX_US            10000u              /* Producer gap, uniform 0 .. 10 ms */
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+typedef enum
+{
+    eMODEL_POLLING = 0u,
+    eMODEL_EVENT,
+} E_MODEL;
+
+typedef struct
+{
+    pthread_mutex_t             lock;
+    pthread_cond_t              notify;
+    uint64_t                    items[ BENCH_QUEUE_LENGTH ];    /* Post times */
+    unsigned                    head;
+    unsigned                    count;
+    uint32_t                    pending;                        /* Notification bits */
+    int                         done;
+} S_BENCH_QUEUE;
+
+typedef struct
+{
+    E_MODEL                     model;
+    S_BENCH_QUEUE               queue;
+    uint64_t                    latency[ BENCH_ITEMS ];
+    size_t                      served;
+    unsigned                    wakeups;
+    unsigned                    dropped;
+} S_BENCH;
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+/* gkPost(): queue without blocking, then set the source bit */
+static void benchPost( S_BENCH *b, uint64_t now )
+{
+    S_BENCH_QUEUE *q = &b->queue;
+
+    pthread_mutex_lock( &q->lock );
+    if ( q->count == BENCH_QUEUE_LENGTH )
+    {
+        b->dropped++;
+    }
+    else
+    {
+        q->items[ ( q->head + q->count ) % BENCH_QUEUE_LENGTH ] = now;
+        q->count++;
+        q->pending |= 1u;
+        pthread_cond_signal( &q->notify );
+    }
+    pthread_mutex_unlock( &q->lock );
+}
+
+/* xQueueReceive( ..., 0 ), called with the lock held */
+static int benchReceive( S_BENCH *b )
+{
+    S_BENCH_QUEUE *q = &b->queue;
+
+    if ( q->count == 0u )
+    {
+        return 0;
+    }
+
+    b->latency[ b->served++ ] = hostNowNs() - q->items[ q->head ];
+    q->head = ( q->head + 1u ) % BENCH_QUEUE_LENGTH;
+    q->count--;
+
+    return 1;
+}
+
+static void *benchProducer( void *arg )
+{
+    S_BENCH *b = ( S_BENCH * ) arg;
+    uint32_t seed = 0x2545F491u;
+    unsigned i;
+
+    for ( i = 0u; i < BENCH_ITEMS; i++ )
+    {
+        usleep( hostRand( &seed ) % BENCH_GAP_MAX_US );
+        benchPost( b, hostNowNs() );
+    }
+
+    usleep( 2u * ( BENCH_PERIOD_NS / 1000u ) );
+
+    pthread_mutex_lock( &b->queue.lock );
+    b->queue.done = 1;
+    pthread_cond_signal( &b->queue.notify );
+    pthread_mutex_unlock( &b->queue.lock );
+
+    return NULL;
+}
+
+static void *benchGatekeeper( void *arg )
+{
+    S_BENCH *b = ( S_BENCH * ) arg;
+    S_BENCH_QUEUE *q = &b->queue;
+    struct timespec next;
+    int done = 0;
+
+    clock_gettime( CLOCK_MONOTONIC, &next );
+
+    while ( done == 0 )
+    {
+        if ( b->model == eMODEL_POLLING )
+        {
+            /* vTaskDelayUntil( period ), then one receive */
+            next.tv_nsec += BENCH_PERIOD_NS;
+            if ( next.tv_nsec >= 1000000000 )
+            {
+                next.tv_nsec -= 1000000000;
+                next.tv_sec++;
+            }
+            clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL );
+
+            pthread_mutex_lock( &q->lock );
+            b->wakeups++;
+            ( void ) benchReceive( b );
+            done = q->done && ( q->count == 0u );
+            pthread_mutex_unlock( &q->lock );
+        }
+        else
+        {
+            /* xTaskNotifyWait( portMAX_DELAY ), then drain */
+            pthread_mutex_lock( &q->lock );
+            while ( ( q->pending == 0u ) && ( q->done == 0 ) )
+            {
+                pthread_cond_wait( &q->notify, &q->lock );
+            }
+            b->wakeups++;
+            q->pending = 0u;
+            while ( benchReceive( b ) != 0 )
+            {
+            }
+            done = q->done;
+            pthread_mutex_unlock( &q->lock );
+        }
+    }
+
+    return NULL;
+}
+
+static void benchRun( E_MODEL model, const char *name )
+{
+    static S_BENCH b;
+    pthread_t producer;
+    pthread_t gatekeeper;
+    char label[ 64 ];
+
+    memset( &b, 0, sizeof( b ) );
+    b.model = model;
+    pthread_mutex_init( &b.queue.lock, NULL );
+    pthread_cond_init( &b.queue.notify, NULL );
+
+    pthread_create( &gatekeeper, NULL, benchGatekeeper, &b );
+    pthread_create( &producer, NULL, benchProducer, &b );
+    pthread_join( producer, NULL );
+    pthread_join( gatekeeper, NULL );
+
+    snprintf( label, sizeof( label ), "%s latency", name );
+    for ( size_t i = 0u; i < b.served; i++ )
+    {
+        b.latency[ i ] /= 1000u;
+    }
+    hostReport( label, b.latency, b.served, "us" );
+    printf( "%-28s wake-ups %u, served %zu, dropped %u\n", name, b.wakeups, b.served, b.dropped );
+
+    HOST_CHECK( ( b.served + b.dropped ) == BENCH_ITEMS );
+
+    pthread_cond_destroy( &b.queue.notify );
+    pthread_mutex_destroy( &b.queue.lock );
+}
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+int main( void )
+{
+    printf( "gatekeeper: %u items, queue %u, poll period %u ms\n",
+            BENCH_ITEMS, BENCH_QUEUE_LENGTH, BENCH_PERIOD_NS / 1000000u );
+
+    benchRun( eMODEL_POLLING, "polling" );
+    benchRun( eMODEL_EVENT, "event driven" );
+
+    return HOST_RESULT();
+}
+
+/*----------------------------------------------------------------------------\
+|   End of bench_gatekeeper.c module                                          |
+\----------------------------------------------------------------------------*/
@@ -0,0 +1,338 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : bench_pool.c Module File.                                  |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Block pools against heap_4 under fragmentation.                           |
+|                                                                             |
+|   fw_pool.c and os_heap.c are included here with their locks stubbed:       |
+|   the critical section of the pools and the scheduler suspension of         |
+|   heap_4 cost nothing, so only the allocators are measured. Both walk       |
+|   from the same seed through requests up to POOL_BLOCK_MAX bytes, freed     |
+|   in random order so heap_4 splits and merges its free list as it does      |
+|   in the field. Then pvPortMalloc() itself, pools in front of heap_4.       |
+|                                                                             |
+|   Reported: the latency distributions of allocation and release, the        |
+|   failures, and the longest free list heap_4 walked. Checked: blocks are    |
+|   8 byte aligned and everything comes back on the last release.             |
+|                                                                             |
+|   On the host a heap_4 block header is 16 bytes, 8 on the target, so the    |
+|   heap fills somewhat sooner here.                                          |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "host_test.h"
+
+#include "FreeRTOS.h"
+#include "os_task.h"
+
+/*----------------------------------------------------------------------------\
+|   Target Stand-ins                                                          |
+\----------------------------------------------------------------------------*/
+
+static void benchEnter( void );
+static void benchExit( void );
+
+#undef taskENTER_CRITICAL
+#undef taskEXIT_CRITICAL
+#define taskENTER_CRITICAL()        benchEnter()
+#define taskEXIT_CRITICAL()         benchExit()
+
+/* A failed assertion is counted instead of spinning with the interrupts off */
+#undef configASSERT
+#define configASSERT( x )           HOST_CHECK( x )
+
+#include "fw_pool.c"
+
+/* heap_4 keeps addresses in uint32_t; 64 bit host pointers need the full width */
+#define uint32_t                    uintptr_t
+#include "os_heap.c"
+#undef uint32_t
+
+#define BENCH_CPSR_SYSTEM           0x1Fu
+
+uint32 _getCPSRValue_( void )
+{
+    return BENCH_CPSR_SYSTEM;
+}
+
+BaseType_t xTaskGetSchedulerState( void )
+{
+    return taskSCHEDULER_RUNNING;
+}
+
+void vTaskSuspendAll( void )
+{
+    benchEnter();
+}
+
+BaseType_t xTaskResumeAll( void )
+{
+    benchExit();
+    return pdFALSE;
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define BENCH_OPS                   400000u
+#define BENCH_LIVE_MAX              48u                 /* Below the 60 pool blocks */
+#define BENCH_LIVE_MIN              16u
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+typedef void *( *BENCH_ALLOC )( size_t size );
+typedef void ( *BENCH_FREE )( void *p );
+
+typedef struct
+{
+    const char *                name;
+    BENCH_ALLOC                 alloc;
+    BENCH_FREE                  release;
+} S_BENCH_ALLOCATOR;
+
+/*----------------------------------------------------------------------------\
+|   Private Function Declarations                                             |
+\----------------------------------------------------------------------------*/
+
+static void *benchPoolAlloc( size_t size );
+static void benchPoolFree( void *p );
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static const S_BENCH_ALLOCATOR bench_allocators[] =
+{
+    { "poolAlloc/poolFree",         &benchPoolAlloc,    &benchPoolFree },
+    { "prvHeapMalloc/prvHeapFree",  &prvHeapMalloc,     &prvHeapFree },
+    { "pvPortMalloc/vPortFree",     &pvPortMalloc,      &vPortFree },
+};
+
+static U64 bench_sections;
+static U32 bench_depth;
+
+static void *bench_live[ BENCH_LIVE_MAX ];
+static uint64_t bench_alloc_ns[ BENCH_OPS ];
+static uint64_t bench_free_ns[ BENCH_OPS ];
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+static void benchEnter( void )
+{
+    bench_sections++;
+    bench_depth++;
+}
+
+static void benchExit( void )
+{
+    HOST_CHECK( bench_depth > 0u );
+    bench_depth--;
+}
+
+static void *benchPoolAlloc( size_t size )
+{
+    return poolAlloc( ( U32 ) size );
+}
+
+static void benchPoolFree( void *p )
+{
+    HOST_CHECK( poolFree( p ) == TRUE );
+}
+
+/* Mostly small requests, as the events and frames of the firmware */
+static size_t benchSize( uint32_t *p_seed )
+{
+    U32 r = hostRand( p_seed ) % 100u;
+    size_t size;
+
+    if ( r < 50u )
+    {
+        size = 4u + ( hostRand( p_seed ) % 29u );                       /* 4 to 32 */
+    }
+    else if ( r < 75u )
+    {
+        size = 33u + ( hostRand( p_seed ) % 32u );
+    }
+    else if ( r < 90u )
+    {
+        size = 65u + ( hostRand( p_seed ) % 64u );
+    }
+    else
+    {
+        size = 129u + ( hostRand( p_seed ) % 128u );
+    }
+
+    return size;
+}
+
+/* Free blocks on the heap_4 list: the length of a failed search */
+static U32 benchHeapFreeBlocks( void )
+{
+    const BlockLink_t *block;
+    U32 blocks = 0u;
+
+    if ( pxEnd == NULL )
+    {
+        return 0u;
+    }
+
+    for ( block = xStart.pxNextFreeBlock; block != pxEnd; block = block->pxNextFreeBlock )
+    {
+        blocks++;
+    }
+
+    return blocks;
+}
+
+/* The same walk for every allocator: the seed is reset for each */
+static void benchRun( const S_BENCH_ALLOCATOR *p_alc )
+{
+    uint32_t seed = 0x9E3779B9u;
+    size_t heap_free = xPortGetFreeHeapSize();
+    size_t allocs = 0u;
+    size_t frees = 0u;
+    U32 failures = 0u;
+    U32 list_max = 0u;
+    U32 live = 0u;
+    U32 blocks;
+    uint64_t start;
+    uint64_t ns;
+    void *p;
+    U32 op;
+    U32 k;
+
+    for ( op = 0u; op < BENCH_OPS; op++ )
+    {
+        /* Drifts between the limits, so the live set grows and shrinks */
+        BOOLEAN grow = ( live < BENCH_LIVE_MIN ) ||
+                       ( ( live < BENCH_LIVE_MAX ) && ( ( hostRand( &seed ) & 1u ) == 0u ) );
+
+        if ( grow == TRUE )
+        {
+            size_t size = benchSize( &seed );
+
+            start = hostNowNs();
+            p = p_alc->alloc( size );
+            ns = hostNowNs() - start;
+
+            bench_alloc_ns[ allocs ] = ns;
+            allocs++;
+
+            if ( p == NULL )
+            {
+                failures++;
+                continue;
+            }
+
+            HOST_CHECK( ( ( uintptr_t ) p & portBYTE_ALIGNMENT_MASK ) == 0u );
+            memset( p, 0x5A, size );
+            bench_live[ live ] = p;
+            live++;
+        }
+        else
+        {
+            k = hostRand( &seed ) % live;
+            p = bench_live[ k ];
+            live--;
+            bench_live[ k ] = bench_live[ live ];
+
+            start = hostNowNs();
+            p_alc->release( p );
+            ns = hostNowNs() - start;
+
+            bench_free_ns[ frees ] = ns;
+            frees++;
+        }
+
+        if ( ( op % 1024u ) == 0u )
+        {
+            blocks = benchHeapFreeBlocks();
+            if ( blocks > list_max )
+            {
+                list_max = blocks;
+            }
+        }
+    }
+
+    while ( live > 0u )
+    {
+        live--;
+        p_alc->release( bench_live[ live ] );
+    }
+
+    printf( "%s: %zu allocations, %u failed, heap_4 free list up to %u blocks\n",
+            p_alc->name, allocs, failures, list_max );
+    hostReport( "  alloc", bench_alloc_ns, allocs, "ns" );
+    hostReport( "  free", bench_free_ns, frees, "ns" );
+
+    /* Everything back: the pools refilled, heap_4 merged into one block */
+    for ( k = 0u; k < ( U32 ) ePOOL_MAX; k++ )
+    {
+        HOST_CHECK( pool_stats[ k ].free == pool_defs[ k ].blocks );
+    }
+    HOST_CHECK( xPortGetFreeHeapSize() == heap_free );
+    HOST_CHECK( benchHeapFreeBlocks() <= 1u );
+    HOST_CHECK( bench_depth == 0u );
+}
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+int main( void )
+{
+    uint64_t start;
+    U32 i;
+
+    poolInit();
+
+    /* heap_4 sets itself up on its first allocation */
+    prvHeapFree( prvHeapMalloc( 1u ) );
+
+    printf( "pool: %u bytes in %u classes, heap_4: %u bytes, %u requests of 4 to %u bytes, %u to %u live\n",
+            ( unsigned ) POOL_STORAGE_BYTES, ( unsigned ) ePOOL_MAX, ( unsigned ) configTOTAL_HEAP_SIZE,
+            BENCH_OPS, POOL_BLOCK_MAX, BENCH_LIVE_MIN, BENCH_LIVE_MAX );
+
+    /* The clock itself, to be taken off the figures below */
+    for ( i = 0u; i < BENCH_OPS; i++ )
+    {
+        start = hostNowNs();
+        bench_alloc_ns[ i ] = hostNowNs() - start;
+    }
+    hostReport( "clock", bench_alloc_ns, BENCH_OPS, "ns" );
+
+    for ( i = 0u; i < ( sizeof( bench_allocators ) / sizeof( bench_allocators[ 0 ] ) ); i++ )
+    {
+        benchRun( &bench_allocators[ i ] );
+    }
+
+    printf( "%u lock sections, stubbed\n", ( unsigned ) bench_sections );
+
+    return HOST_RESULT();
+}
+
+/*----------------------------------------------------------------------------\
+|   End of bench_pool.c module                                                |
+\----------------------------------------------------------------------------*/
@@ -0,0 +1,319 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : bench_ring.c Module File.                                  |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   fw_ring throughput against a queue shaped like xQueueSendFromISR().       |
+|                                                                             |
+|   The queue model does per item what the FreeRTOS call does: enter a        |
+|   critical section ( a mutex here, interrupt masking on the target ),       |
+|   check space, copy the item, check the receive waiting list, leave. The    |
+|   ring is fw_ring itself, one item at a time and in batches of 8. Each      |
+|   path moves the same 12 byte items, first within one thread, then          |
+|   between a producer and a consumer thread that yield when blocked.         |
+|                                                                             |
+|   On an x86 host ATOMIC_DMB() is a full fence, several per item on the      |
+|   single item ring path; batches pay them once per batch.                   |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "host_test.h"
+
+#include "fw_ring.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define BENCH_LENGTH                64u
+#define BENCH_BATCH                 8u
+#define BENCH_ITEMS                 4000000u
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    U32                         word[ 3 ];
+} S_BENCH_ITEM;
+
+typedef enum
+{
+    ePATH_QUEUE = 0u,
+    ePATH_RING,
+    ePATH_RING_BATCH,
+    ePATH_MAX,
+} E_PATH;
+
+/* xQueueSendFromISR() / xQueueReceive() shape */
+typedef struct
+{
+    pthread_mutex_t             lock;
+    S_BENCH_ITEM                items[ BENCH_LENGTH ];
+    U32                         head;
+    U32                         count;
+    U32                         waiting;            /* Tasks blocked on receive */
+    U32                         woken;
+} S_BENCH_QUEUE;
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static const char * const bench_names[ ePATH_MAX ] =
+{
+    [ ePATH_QUEUE ] = "queue",
+    [ ePATH_RING ] = "ring",
+    [ ePATH_RING_BATCH ] = "ring, batches of 8",
+};
+
+static S_BENCH_QUEUE bench_queue = { .lock = PTHREAD_MUTEX_INITIALIZER };
+static S_RING bench_ring;
+static S_BENCH_ITEM bench_storage[ BENCH_LENGTH ];
+static volatile U32 bench_sink;
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+static U32 benchQueueSend( const S_BENCH_ITEM *item )
+{
+    U32 ok = 0u;
+
+    pthread_mutex_lock( &bench_queue.lock );
+    if ( bench_queue.count < BENCH_LENGTH )
+    {
+        memcpy( &bench_queue.items[ ( bench_queue.head + bench_queue.count ) % BENCH_LENGTH ], item, sizeof( *item ) );
+        bench_queue.count++;
+        if ( bench_queue.waiting != 0u )
+        {
+            bench_queue.woken++;
+        }
+        ok = 1u;
+    }
+    pthread_mutex_unlock( &bench_queue.lock );
+
+    return ok;
+}
+
+static U32 benchQueueReceive( S_BENCH_ITEM *item )
+{
+    U32 ok = 0u;
+
+    pthread_mutex_lock( &bench_queue.lock );
+    if ( bench_queue.count > 0u )
+    {
+        memcpy( item, &bench_queue.items[ bench_queue.head ], sizeof( *item ) );
+        bench_queue.head = ( bench_queue.head + 1u ) % BENCH_LENGTH;
+        bench_queue.count--;
+        ok = 1u;
+    }
+    pthread_mutex_unlock( &bench_queue.lock );
+
+    return ok;
+}
+
+/* Moves up to count items in, returns how many went */
+static U32 benchSend( E_PATH path, S_BENCH_ITEM *items, U32 count )
+{
+    U32 n = 0u;
+
+    switch ( path )
+    {
+        case ePATH_QUEUE:
+            while ( ( n < count ) && ( benchQueueSend( &items[ n ] ) != 0u ) )
+            {
+                n++;
+            }
+            break;
+
+        case ePATH_RING:
+            while ( ( n < count ) && ( ringPush( &bench_ring, &items[ n ] ) == TRUE ) )
+            {
+                n++;
+            }
+            break;
+
+        default:
+            n = ringPushBatch( &bench_ring, items, count );
+            break;
+    }
+
+    return n;
+}
+
+static U32 benchReceive( E_PATH path, S_BENCH_ITEM *items, U32 count )
+{
+    U32 n = 0u;
+
+    switch ( path )
+    {
+        case ePATH_QUEUE:
+            while ( ( n < count ) && ( benchQueueReceive( &items[ n ] ) != 0u ) )
+            {
+                n++;
+            }
+            break;
+
+        case ePATH_RING:
+            while ( ( n < count ) && ( ringPop( &bench_ring, &items[ n ] ) == TRUE ) )
+            {
+                n++;
+            }
+            break;
+
+        default:
+            n = ringPopBatch( &bench_ring, items, count );
+            break;
+    }
+
+    return n;
+}
+
+static void *benchProducer( void *arg )
+{
+    E_PATH path = ( E_PATH ) ( uintptr_t ) arg;
+    S_BENCH_ITEM items[ BENCH_BATCH ];
+    U32 sent = 0u;
+    U32 count;
+    U32 n;
+    U32 i;
+
+    while ( sent < BENCH_ITEMS )
+    {
+        /* The last batch is short, so exactly BENCH_ITEMS go through */
+        count = ( ( BENCH_ITEMS - sent ) < BENCH_BATCH ) ? ( BENCH_ITEMS - sent ) : BENCH_BATCH;
+        for ( i = 0u; i < count; i++ )
+        {
+            items[ i ].word[ 0 ] = sent + i;
+        }
+        n = benchSend( path, items, count );
+        if ( n == 0u )
+        {
+            sched_yield();                  /* Full: let the consumer run on a single core */
+        }
+        sent += n;
+    }
+
+    return NULL;
+}
+
+static void *benchConsumer( void *arg )
+{
+    E_PATH path = ( E_PATH ) ( uintptr_t ) arg;
+    S_BENCH_ITEM items[ BENCH_BATCH ];
+    U32 received = 0u;
+    U32 n;
+
+    while ( received < BENCH_ITEMS )
+    {
+        n = benchReceive( path, items, BENCH_BATCH );
+        if ( n > 0u )
+        {
+            bench_sink = items[ n - 1u ].word[ 0 ];
+            received += n;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void benchReset( void )
+{
+    bench_queue.head = 0u;
+    bench_queue.count = 0u;
+    ( void ) ringInit( &bench_ring, bench_storage, sizeof( S_BENCH_ITEM ), BENCH_LENGTH );
+}
+
+/* One thread: fill a batch, drain it; ns per item through the path */
+static double benchSingle( E_PATH path )
+{
+    S_BENCH_ITEM items[ BENCH_BATCH ];
+    uint64_t start;
+    U32 moved = 0u;
+
+    benchReset();
+    memset( items, 0, sizeof( items ) );
+
+    start = hostNowNs();
+    while ( moved < BENCH_ITEMS )
+    {
+        items[ 0 ].word[ 0 ] = moved;
+        ( void ) benchSend( path, items, BENCH_BATCH );
+        moved += benchReceive( path, items, BENCH_BATCH );
+    }
+
+    HOST_CHECK( items[ 0 ].word[ 0 ] == ( moved - BENCH_BATCH ) );
+
+    return ( double ) ( hostNowNs() - start ) / ( double ) moved;
+}
+
+/* Two threads; on a single core host this includes the switches between them */
+static double benchThreads( E_PATH path )
+{
+    pthread_t producer;
+    pthread_t consumer;
+    uint64_t start;
+
+    benchReset();
+
+    start = hostNowNs();
+    pthread_create( &consumer, NULL, benchConsumer, ( void * ) ( uintptr_t ) path );
+    pthread_create( &producer, NULL, benchProducer, ( void * ) ( uintptr_t ) path );
+    pthread_join( producer, NULL );
+    pthread_join( consumer, NULL );
+
+    HOST_CHECK( bench_sink == ( BENCH_ITEMS - 1u ) );
+
+    return ( double ) ( hostNowNs() - start ) / ( double ) BENCH_ITEMS;
+}
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+int main( void )
+{
+    U32 path;
+
+    printf( "ring: %u items of %zu bytes, %u deep\n", BENCH_ITEMS, sizeof( S_BENCH_ITEM ), BENCH_LENGTH );
+    printf( "%-28s %14s %14s\n", "", "1 thread ns", "2 threads ns" );
+
+    for ( path = 0u; path < ePATH_MAX; path++ )
+    {
+        double single = benchSingle( ( E_PATH ) path );
+        double threads = benchThreads( ( E_PATH ) path );
+
+        printf( "%-28s %14.1f %14.1f\n", bench_names[ path ], single, threads );
+    }
+
+    return HOST_RESULT();
+}
+
+/*----------------------------------------------------------------------------\
+|   End of bench_ring.c module                                                |
+\----------------------------------------------------------------------------*/
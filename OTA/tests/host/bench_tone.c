@@ -0,0 +1,265 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : bench_tone.c Module File.                                  |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   ADC tone and level detectors on synthetic signals.                        |
+|                                                                             |
+|   fw_adc_tone.c is included here and its block handler is fed DMA blocks    |
+|   of 64 results built from known signals: each tone of the detector         |
+|   alone, both together on a DC offset, white noise, and a tone              |
+|   off the bins. Every evaluation publishes through dmSet(), captured        |
+|   here. Reported per signal: the levels against the ones put in. Then       |
+|   the cost of the handler per result, in nanoseconds and host cycles.       |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+    #include <x86intrin.h>
+    #define BENCH_CYCLES()          ( ( uint64_t ) __rdtsc() )
+#else
+    #define BENCH_CYCLES()          ( ( uint64_t ) 0u )
+#endif
+
+#include <math.h>
+
+#include "host_test.h"
+
+#include "fw_adc_tone.c"
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define BENCH_BLOCK                 64u                 /* adc_dma_config_defs block_results */
+#define BENCH_EVALUATIONS           20u                 /* Per signal */
+#define BENCH_COST_BLOCKS           20000u
+#define BENCH_HW_CHANNEL            9u
+#define BENCH_LEVEL_TOLERANCE       0.03                /* Of the level put in, with 3 counts of floor */
+#define BENCH_LEVEL_FLOOR           3.0
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    const char *                name;
+    double                      offset;             /* Counts from mid scale */
+    double                      amplitude_100;      /* Peak counts */
+    double                      amplitude_120;
+    double                      amplitude_other;
+    double                      other_hz;
+    double                      noise;              /* Standard deviation, counts */
+} S_BENCH_SIGNAL;
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static const S_BENCH_SIGNAL bench_signals[] =
+{
+    { "100 Hz",                 0.0,    800.0,  0.0,    0.0,    0.0,    0.0 },
+    { "120 Hz",                 0.0,    0.0,    600.0,  0.0,    0.0,    0.0 },
+    { "both, offset, noise",    300.0,  500.0,  250.0,  0.0,    0.0,    20.0 },
+    { "noise",                  0.0,    0.0,    0.0,    0.0,    0.0,    100.0 },
+    { "50 Hz mains only",       0.0,    0.0,    0.0,    900.0,  50.0,   0.0 },
+};
+
+static S_ADC_CHANNEL_CONFIG bench_channels[ eADC_CHANNEL_MAX ];
+static ADC_BLOCK_HANDLER bench_handler;
+static S32 bench_published[ DM_SIGNAL_MAX ];
+static U32 bench_publishes;
+static uint32_t bench_seed = 0x51A7E5u;
+
+/*----------------------------------------------------------------------------\
+|   Target Stand-ins                                                          |
+\----------------------------------------------------------------------------*/
+
+const S_ADC_CHANNEL_CONFIG * const adcGetChannelConfig( void )
+{
+    return bench_channels;
+}
+
+void adcSetBlockHandler( ADC_BLOCK_HANDLER handler )
+{
+    bench_handler = handler;
+}
+
+BOOLEAN dmSet( U32 signal, S32 value )
+{
+    if ( signal < DM_SIGNAL_MAX )
+    {
+        bench_published[ signal ] = value;
+        bench_publishes++;
+    }
+
+    return TRUE;
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+static double benchGauss( void )
+{
+    double u1 = ( ( double ) ( hostRand( &bench_seed ) >> 8 ) + 1.0 ) / 16777217.0;
+    double u2 = ( double ) ( hostRand( &bench_seed ) >> 8 ) / 16777216.0;
+
+    return sqrt( -2.0 * log( u1 ) ) * cos( 2.0 * M_PI * u2 );
+}
+
+/* One DMA block of the signal from sample n on, as the 12 bit results with the channel id */
+static void benchBlock( const S_BENCH_SIGNAL *p_sig, U32 n, U32 *results )
+{
+    const double fs = ( double ) adc_tone_config_defs[ 0 ].sample_hz;
+    double t;
+    double v;
+    long code;
+    U32 i;
+
+    for ( i = 0u; i < BENCH_BLOCK; i++ )
+    {
+        t = ( double ) ( n + i ) / fs;
+        v = ADC_TONE_MID + p_sig->offset +
+            ( p_sig->amplitude_100 * sin( 2.0 * M_PI * 100.0 * t ) ) +
+            ( p_sig->amplitude_120 * sin( 2.0 * M_PI * 120.0 * t + 1.0 ) ) +
+            ( p_sig->amplitude_other * sin( 2.0 * M_PI * p_sig->other_hz * t ) ) +
+            ( p_sig->noise * benchGauss() );
+
+        code = lrint( v );
+        if ( code < 0 )
+        {
+            code = 0;
+        }
+        else if ( code > 4095 )
+        {
+            code = 4095;
+        }
+        results[ i ] = ( ( U32 ) BENCH_HW_CHANNEL << 16U ) | ( U32 ) code;
+    }
+}
+
+static BOOLEAN benchClose( double measured, double expected )
+{
+    BOOLEAN close = FALSE;
+
+    if ( fabs( measured - expected ) <= ( BENCH_LEVEL_FLOOR + ( BENCH_LEVEL_TOLERANCE * expected ) ) )
+    {
+        close = TRUE;
+    }
+
+    return close;
+}
+
+static void benchLevels( const S_BENCH_SIGNAL *p_sig )
+{
+    const S_ADC_TONE_CONFIG *p_cfg = &adc_tone_config_defs[ 0 ];
+    U32 results[ BENCH_BLOCK ];
+    U32 samples = BENCH_EVALUATIONS * p_cfg->length;
+    double rms;
+    U32 n;
+
+    adcToneInit();
+
+    for ( n = 0u; n < samples; n += BENCH_BLOCK )
+    {
+        benchBlock( p_sig, n, results );
+        bench_handler( eADC_UNIT_1, eADC_GROUP_1, results, BENCH_BLOCK );
+    }
+
+    rms = sqrt( ( ( p_sig->amplitude_100 * p_sig->amplitude_100 ) + ( p_sig->amplitude_120 * p_sig->amplitude_120 ) +
+                  ( p_sig->amplitude_other * p_sig->amplitude_other ) ) / 2.0 + ( p_sig->noise * p_sig->noise ) );
+
+    printf( "%-22s 100 Hz %5d ( %5.0f )  120 Hz %5d ( %5.0f )  rms %5d ( %5.0f )\n",
+            p_sig->name,
+            bench_published[ p_cfg->tone_signal[ 0 ] ], p_sig->amplitude_100,
+            bench_published[ p_cfg->tone_signal[ 1 ] ], p_sig->amplitude_120,
+            bench_published[ p_cfg->rms_signal ], rms );
+
+    /* Noise spreads over every bin: the tones are only checked on clean signals */
+    if ( p_sig->noise <= 20.0 )
+    {
+        HOST_CHECK( benchClose( bench_published[ p_cfg->tone_signal[ 0 ] ], p_sig->amplitude_100 ) == TRUE );
+        HOST_CHECK( benchClose( bench_published[ p_cfg->tone_signal[ 1 ] ], p_sig->amplitude_120 ) == TRUE );
+    }
+    HOST_CHECK( benchClose( bench_published[ p_cfg->rms_signal ], rms ) == TRUE );
+}
+
+static void benchCost( void )
+{
+    static U32 blocks[ 16 ][ BENCH_BLOCK ];
+    uint64_t start_ns;
+    uint64_t start_cycles;
+    double ns;
+    double cycles;
+    U32 b;
+
+    for ( b = 0u; b < 16u; b++ )
+    {
+        benchBlock( &bench_signals[ 2 ], b * BENCH_BLOCK, blocks[ b ] );
+    }
+
+    adcToneInit();
+    bench_publishes = 0u;
+
+    start_ns = hostNowNs();
+    start_cycles = BENCH_CYCLES();
+    for ( b = 0u; b < BENCH_COST_BLOCKS; b++ )
+    {
+        bench_handler( eADC_UNIT_1, eADC_GROUP_1, blocks[ b & 15u ], BENCH_BLOCK );
+    }
+    cycles = ( double ) ( BENCH_CYCLES() - start_cycles ) / ( double ) ( BENCH_COST_BLOCKS * BENCH_BLOCK );
+    ns = ( double ) ( hostNowNs() - start_ns ) / ( double ) ( BENCH_COST_BLOCKS * BENCH_BLOCK );
+
+    printf( "handler: %.2f ns, %.1f cycles per result, %u tones, %u evaluations\n",
+            ns, cycles, adc_tone_config_defs[ 0 ].tones, bench_publishes / ( adc_tone_config_defs[ 0 ].tones + 1u ) );
+
+    HOST_CHECK( bench_publishes == ( ( BENCH_COST_BLOCKS * BENCH_BLOCK ) / adc_tone_config_defs[ 0 ].length ) * ( adc_tone_config_defs[ 0 ].tones + 1u ) );
+}
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+int main( void )
+{
+    const S_ADC_TONE_CONFIG *p_cfg = &adc_tone_config_defs[ 0 ];
+    U32 i;
+
+    bench_channels[ p_cfg->id ].id = p_cfg->id;
+    bench_channels[ p_cfg->id ].unit = eADC_UNIT_1;
+    bench_channels[ p_cfg->id ].group = eADC_GROUP_1;
+    bench_channels[ p_cfg->id ].ch = BENCH_HW_CHANNEL;
+
+    printf( "tone: %u Hz sampling, %u results per evaluation, levels in counts ( put in )\n", p_cfg->sample_hz, p_cfg->length );
+
+    for ( i = 0u; i < ( sizeof( bench_signals ) / sizeof( bench_signals[ 0 ] ) ); i++ )
+    {
+        benchLevels( &bench_signals[ i ] );
+    }
+
+    benchCost();
+
+    return HOST_RESULT();
+}
+
+/*----------------------------------------------------------------------------\
+|   End of bench_tone.c module                                                |
+\----------------------------------------------------------------------------*/
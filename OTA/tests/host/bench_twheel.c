@@ -0,0 +1,321 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : bench_twheel.c Module File.                                |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Timer wheel cost with 10k active timers.                                  |
+|                                                                             |
+|   fw_twheel.c is included here with its critical sections stubbed, the      |
+|   timebase and the gatekeeper replaced by calls from this file: a tick is   |
+|   twTick() as the timebase interrupt calls it, then twServe() until the     |
+|   wheel has caught up. Delays mix the levels as the protocol timeouts and   |
+|   the slow housekeeping timers do; a third are periodic and a one-shot      |
+|   starts itself again from its callback, so 10k stay active.                |
+|                                                                             |
+|   Reported: twStart() and twRestart() latency, the cost of a tick with      |
+|   its cascades and callbacks, the time spent in each critical section,      |
+|   and twListSplice() of slots of 1 to 10k timers. Checked: every            |
+|   callback runs on its expiry tick and none is lost.                        |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "host_test.h"
+
+#include "FreeRTOS.h"
+#include "os_task.h"
+
+/*----------------------------------------------------------------------------\
+|   Target Stand-ins                                                          |
+\----------------------------------------------------------------------------*/
+
+static void benchEnter( void );
+static void benchExit( void );
+
+#undef taskENTER_CRITICAL
+#undef taskEXIT_CRITICAL
+#define taskENTER_CRITICAL()        benchEnter()
+#define taskEXIT_CRITICAL()         benchExit()
+
+#include "fw_twheel.c"
+
+void tbTimerStart( S_TB_TIMER *timer, U32 us, TB_CALLBACK callback, void *arg )
+{
+    timer->expiry = TB_US_TO_TICKS( us );
+    timer->callback = callback;
+    timer->arg = arg;
+}
+
+void tbTimerStartAt( S_TB_TIMER *timer, U64 expiry, TB_CALLBACK callback, void *arg )
+{
+    timer->expiry = expiry;
+    timer->callback = callback;
+    timer->arg = arg;
+}
+
+static U32 bench_signals;
+
+void gkSignal( E_GK_SOURCE source )
+{
+    ( void ) source;
+    bench_signals++;
+}
+
+void gkSignalFromISR( E_GK_SOURCE source, portBaseType *woken )
+{
+    ( void ) source;
+    ( void ) woken;
+    bench_signals++;
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define BENCH_TIMERS                10000u
+#define BENCH_RESTARTS              200000u
+#define BENCH_TICKS                 20000u              /* 20 s of wheel time */
+#define BENCH_SECTION_SAMPLES       4000000u
+#define BENCH_SPLICES               1000000u
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static S_TW_TIMER bench_timers[ BENCH_TIMERS ];
+static U32 bench_due[ BENCH_TIMERS ];                   /* Expected expiry tick */
+static uint32_t bench_seed = 0x7123AB5u;
+
+static U64 bench_fired;
+static U64 bench_wrong_tick;
+
+static BOOLEAN bench_time_sections = FALSE;
+static uint64_t bench_section_start;
+static uint64_t *bench_sections;
+static size_t bench_section_count;
+static U64 bench_section_calls;
+
+static uint64_t bench_samples[ BENCH_RESTARTS ];
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+static void benchEnter( void )
+{
+    bench_section_calls++;
+    if ( bench_time_sections == TRUE )
+    {
+        bench_section_start = hostNowNs();
+    }
+}
+
+static void benchExit( void )
+{
+    if ( ( bench_time_sections == TRUE ) && ( bench_section_count < BENCH_SECTION_SAMPLES ) )
+    {
+        bench_sections[ bench_section_count ] = hostNowNs() - bench_section_start;
+        bench_section_count++;
+    }
+}
+
+/* A delay in ms over the levels: mostly protocol timeouts on level 0 */
+static U32 benchDelay( void )
+{
+    U32 r = hostRand( &bench_seed ) % 100u;
+    U32 delay;
+
+    if ( r < 70u )
+    {
+        delay = 1u + ( hostRand( &bench_seed ) % 63u );                 /* Level 0 */
+    }
+    else if ( r < 90u )
+    {
+        delay = 64u + ( hostRand( &bench_seed ) % 4032u );              /* Level 1 */
+    }
+    else if ( r < 99u )
+    {
+        delay = 4096u + ( hostRand( &bench_seed ) % 258048u );          /* Level 2 */
+    }
+    else
+    {
+        delay = 262144u + ( hostRand( &bench_seed ) % 16000000u );      /* Level 3 */
+    }
+
+    return delay;
+}
+
+static void benchFire( void *arg )
+{
+    S_TW_TIMER *timer = ( S_TW_TIMER * ) arg;
+    U32 i = ( U32 ) ( timer - bench_timers );
+
+    bench_fired++;
+    if ( tw_now != bench_due[ i ] )
+    {
+        bench_wrong_tick++;
+    }
+
+    if ( timer->period != 0u )
+    {
+        bench_due[ i ] += timer->period;
+    }
+    else
+    {
+        bench_due[ i ] = tw_ticks + timer->delay + 1u;
+        twRestart( timer );
+    }
+}
+
+static void benchStart( U32 i )
+{
+    U32 delay = benchDelay();
+    U32 period = ( ( hostRand( &bench_seed ) % 3u ) == 0u ) ? delay : 0u;
+
+    bench_due[ i ] = tw_ticks + delay + 1u;
+    twStart( &bench_timers[ i ], delay, period, &benchFire, &bench_timers[ i ] );
+}
+
+/* One wheel tick: the timebase interrupt, then the gatekeeper until idle */
+static void benchTick( void )
+{
+    BaseType_t woken = pdFALSE;
+
+    bench_signals = 0u;
+    twTick( NULL, &woken );
+    while ( bench_signals != 0u )
+    {
+        bench_signals = 0u;
+        twServe( NULL );
+    }
+}
+
+static void benchTicks( const char *name, U32 ticks )
+{
+    uint64_t start;
+    U32 t;
+
+    for ( t = 0u; t < ticks; t++ )
+    {
+        start = hostNowNs();
+        benchTick();
+        bench_samples[ t ] = hostNowNs() - start;
+    }
+    hostReport( name, bench_samples, ticks, "ns" );
+}
+
+static void benchSplice( U32 length )
+{
+    static S_TW_LINK links[ BENCH_TIMERS ];
+    S_TW_LINK a;
+    S_TW_LINK b;
+    uint64_t start;
+    U32 i;
+
+    twListInit( &a );
+    twListInit( &b );
+    for ( i = 0u; i < length; i++ )
+    {
+        twListAppend( &a, &links[ i ] );
+    }
+
+    start = hostNowNs();
+    for ( i = 0u; i < BENCH_SPLICES; i++ )
+    {
+        twListSplice( &a, &b );
+        twListSplice( &b, &a );
+    }
+
+    printf( "%-28s %5u timers %8.2f ns\n", "twListSplice", length,
+            ( double ) ( hostNowNs() - start ) / ( double ) ( 2u * BENCH_SPLICES ) );
+
+    /* Order kept through every splice */
+    HOST_CHECK( a.next == &links[ 0 ] );
+    HOST_CHECK( a.prev == &links[ length - 1u ] );
+    HOST_CHECK( TW_LIST_EMPTY( &b ) == TRUE );
+}
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+int main( void )
+{
+    U64 sections;
+    uint64_t start;
+    U32 i;
+
+    bench_sections = malloc( BENCH_SECTION_SAMPLES * sizeof( bench_sections[ 0 ] ) );
+    if ( bench_sections == NULL )
+    {
+        return 1;
+    }
+
+    twInit();
+
+    printf( "twheel: %u timers, %u levels of %lu slots, tick %u us\n", BENCH_TIMERS, TW_LEVELS, TW_SLOTS, TW_TICK_US );
+
+    for ( i = 0u; i < BENCH_TIMERS; i++ )
+    {
+        start = hostNowNs();
+        benchStart( i );
+        bench_samples[ i ] = hostNowNs() - start;
+    }
+    hostReport( "twStart", bench_samples, BENCH_TIMERS, "ns" );
+    HOST_CHECK( tw_stats.active == BENCH_TIMERS );
+
+    for ( i = 0u; i < BENCH_RESTARTS; i++ )
+    {
+        U32 k = hostRand( &bench_seed ) % BENCH_TIMERS;
+
+        start = hostNowNs();
+        bench_due[ k ] = tw_ticks + bench_timers[ k ].delay + 1u;
+        twRestart( &bench_timers[ k ] );
+        bench_samples[ i ] = hostNowNs() - start;
+    }
+    hostReport( "twRestart", bench_samples, BENCH_RESTARTS, "ns" );
+
+    sections = bench_section_calls;
+    benchTicks( "tick", BENCH_TICKS );
+    printf( "%-28s fired %llu, cascaded %u, %.1f critical sections a tick\n", "",
+            ( unsigned long long ) bench_fired, tw_stats.cascaded,
+            ( double ) ( bench_section_calls - sections ) / ( double ) BENCH_TICKS );
+
+    bench_time_sections = TRUE;
+    benchTicks( "tick, sections timed", BENCH_TICKS );
+    bench_time_sections = FALSE;
+    hostReport( "critical section", bench_sections, bench_section_count, "ns" );
+
+    benchSplice( 1u );
+    benchSplice( 64u );
+    benchSplice( BENCH_TIMERS );
+
+    HOST_CHECK( bench_fired > 0u );
+    HOST_CHECK( bench_wrong_tick == 0u );
+    HOST_CHECK( tw_stats.late_max == 0u );
+    HOST_CHECK( tw_stats.active == BENCH_TIMERS );
+    HOST_CHECK( tw_now == tw_ticks );
+
+    free( bench_sections );
+
+    return HOST_RESULT();
+}
+
+/*----------------------------------------------------------------------------\
+|   End of bench_twheel.c module                                              |
+\----------------------------------------------------------------------------*/
@@ -0,0 +1,115 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : host_test.h Header File.                                   |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Host test and benchmark helpers.                                          |
+|                                                                             |
+|   Checks count failures instead of stopping, a test returns                 |
+|   HOST_RESULT() from main(). Times are CLOCK_MONOTONIC nanoseconds.         |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+#ifndef host_test_H
+#define host_test_H
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*----------------------------------------------------------------------------\
+|   Public Constant Definitions                                               |
+\----------------------------------------------------------------------------*/
+
+static unsigned host_failures __attribute__( ( unused ) );
+
+#define HOST_CHECK( cond )                                                      \
+    do                                                                          \
+    {                                                                           \
+        if ( !( cond ) )                                                        \
+        {                                                                       \
+            printf( "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond );   \
+            host_failures++;                                                    \
+        }                                                                       \
+    } while ( 0 )
+
+#define HOST_RESULT()               ( ( host_failures == 0u ) ? ( printf( "PASS\n" ), 0 ) : ( printf( "FAIL ( %u )\n", host_failures ), 1 ) )
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+static inline uint64_t hostNowNs( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ( ( uint64_t ) ts.tv_sec * 1000000000u ) + ( uint64_t ) ts.tv_nsec;
+}
+
+/* Deterministic pseudo random numbers, xorshift32 */
+static inline uint32_t hostRand( uint32_t *p_state )
+{
+    uint32_t x = *p_state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *p_state = x;
+
+    return x;
+}
+
+static inline int hostCompareU64( const void *a, const void *b )
+{
+    uint64_t x = *( const uint64_t * ) a;
+    uint64_t y = *( const uint64_t * ) b;
+
+    return ( x > y ) - ( x < y );
+}
+
+/* Prints min, percentiles and max of n samples; sorts them in place */
+static inline void hostReport( const char *name, uint64_t *samples, size_t n, const char *unit )
+{
+    if ( n == 0u )
+    {
+        printf( "%-28s no samples\n", name );
+        return;
+    }
+
+    qsort( samples, n, sizeof( samples[ 0 ] ), hostCompareU64 );
+
+    printf( "%-28s n %-8zu min %-8llu p50 %-8llu p99 %-8llu p99.9 %-8llu max %-8llu %s\n",
+            name, n,
+            ( unsigned long long ) samples[ 0 ],
+            ( unsigned long long ) samples[ n / 2u ],
+            ( unsigned long long ) samples[ ( n * 99u ) / 100u ],
+            ( unsigned long long ) samples[ ( n * 999u ) / 1000u ],
+            ( unsigned long long ) samples[ n - 1u ],
+            unit );
+}
+
+/*----------------------------------------------------------------------------\
+|   End of host_test.h header file                                            |
+\----------------------------------------------------------------------------*/
+
+#endif  /* host_test_H */
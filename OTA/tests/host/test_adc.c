@@ -0,0 +1,360 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : test_adc.c Module File.                                    |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   fw_adc acquisition tests against a RAM model of the ADC and DMA.          |
+|                                                                             |
+|   fw_adc.c is included here with adcREG1, adcREG2, dmaREG and rtiREG1       |
+|   pointing at RAM, so its private state and handlers are reachable.         |
+|   adc_init() runs against the model as it does at start-up.                 |
+|                                                                             |
+|   The FIFO path is driven through adcNotification(): the result count       |
+|   comes from GxINTCR and the result from GxBUF, a location that reads       |
+|   the same on every access here. The DMA path is driven through             |
+|   adcDmaBlock() with the blocks filled as the DMA would fill them and the   |
+|   HBC / BTC flags set for a half that completed before it was handled.      |
+|   Checked: the counters of every loss, the decimated values, what the       |
+|   block handler gets and adcPingPongTake() on its own.                      |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "host_test.h"
+
+#include "HL_adc.h"
+#include "HL_sys_dma.h"
+#include "fw_utils.h"
+
+/*----------------------------------------------------------------------------\
+|   Register Model                                                            |
+\----------------------------------------------------------------------------*/
+
+static adcBASE_t test_adc[ 2 ];
+static dmaBASE_t test_dma;
+static rtiBASE_t test_rti;
+
+#undef adcREG1
+#undef adcREG2
+#undef dmaREG
+#undef rtiREG1
+#define adcREG1                     ( &test_adc[ 0 ] )
+#define adcREG2                     ( &test_adc[ 1 ] )
+#define dmaREG                      ( &test_dma )
+#define rtiREG1                     ( &test_rti )
+
+#include "fw_adc.c"
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define TEST_UNIT                   eADC_UNIT_1
+#define TEST_GROUP                  eADC_GROUP_1
+#define TEST_HW_CHANNEL             9u                  /* eADC1_9 */
+#define TEST_HW_UNUSED              3u
+#define TEST_DMA_CHANNEL            0u
+#define TEST_FIFO_SIZE              16u
+#define TEST_RESULT( ch, value )    ( ( ( U32 ) ( ch ) << 16U ) | ( U32 ) ( value ) )
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static U32 test_publishes;
+static S_ANALOGUE_INPUTS test_published;
+
+static U32 test_handler_calls;
+static const U32 *test_handler_results;
+static U32 test_handler_count;
+
+/*----------------------------------------------------------------------------\
+|   Target Stand-ins                                                          |
+\----------------------------------------------------------------------------*/
+
+BOOLEAN adcCalInit( void )
+{
+    return TRUE;
+}
+
+S32 adcCalApply( U32 id, S32 value )
+{
+    ( void ) id;
+
+    return value;
+}
+
+void dmAnalogueInputsPublish( const S_ANALOGUE_INPUTS *src )
+{
+    test_publishes++;
+    test_published = *src;
+}
+
+BOOLEAN dmSet( U32 signal, S32 value )
+{
+    ( void ) signal;
+    ( void ) value;
+
+    return TRUE;
+}
+
+void dmaEnable( void )
+{
+}
+
+void dmaSetCtrlPacket( dmaChannel_t channel, g_dmaCTRL g_dmaCTRLPKT )
+{
+    ( void ) channel;
+    ( void ) g_dmaCTRLPKT;
+}
+
+void dmaSetChEnable( dmaChannel_t channel, dmaTriggerType_t type )
+{
+    ( void ) channel;
+    ( void ) type;
+}
+
+void dmaReqAssign( dmaChannel_t channel, dmaRequest_t reqline )
+{
+    ( void ) channel;
+    ( void ) reqline;
+}
+
+void dmaEnableInterrupt( dmaChannel_t channel, dmaInterrupt_t inttype, dmaIntGroup_t group )
+{
+    ( void ) channel;
+    ( void ) inttype;
+    ( void ) group;
+}
+
+void vimChannelMap( uint32 request, uint32 channel, t_isrFuncPTR handler )
+{
+    ( void ) request;
+    ( void ) channel;
+    ( void ) handler;
+}
+
+void vimEnableInterrupt( uint32 channel, systemInterrupt_t inttype )
+{
+    ( void ) channel;
+    ( void ) inttype;
+}
+
+void logWrite( E_LOG_MSG_ID id, U32 nargs, U32 arg0, U32 arg1, U32 arg2 )
+{
+    ( void ) id;
+    ( void ) nargs;
+    ( void ) arg0;
+    ( void ) arg1;
+    ( void ) arg2;
+}
+
+void trcRecord( U16 event, U16 arg, U32 object )
+{
+    ( void ) event;
+    ( void ) arg;
+    ( void ) object;
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+static void testBlockHandler( E_ADC_UNIT unit, E_ADC_GROUP group, const U32 *results, U32 count )
+{
+    HOST_CHECK( unit == TEST_UNIT );
+    HOST_CHECK( group == TEST_GROUP );
+
+    test_handler_calls++;
+    test_handler_results = results;
+    test_handler_count = count;
+}
+
+/* One end of conversion interrupt with results results in the FIFO */
+static void testConversion( U32 results, U32 buf, BOOLEAN overrun )
+{
+    adcREG1->GxINTCR[ TEST_GROUP ] = TEST_FIFO_SIZE - results;
+    adcREG1->GxBUF[ TEST_GROUP ].BUF0 = buf;
+    adcREG1->GxINTFLG[ TEST_GROUP ] = ( overrun == TRUE ) ? ADC_INTFLG_OVERRUN : 0U;
+    adcREG1->GxFIFORESETCR[ TEST_GROUP ] = 0U;
+
+    adcNotification( adcREG1, TEST_GROUP );
+}
+
+static void testFifo( void )
+{
+    const S_ADC_GROUP_STATS *p_stats = adcGetStats( TEST_UNIT, TEST_GROUP );
+    S_ADC_GROUP_STATS before;
+    U32 i;
+
+    adc_init();
+    test_publishes = 0u;
+
+    /* Boxcar over 4 results, 1 extra bit: published once per 4, as sum / 2 */
+    for ( i = 0u; i < 4u; i++ )
+    {
+        HOST_CHECK( test_publishes == 0u );
+        testConversion( 1u, TEST_RESULT( TEST_HW_CHANNEL, 1000u + i ), FALSE );
+    }
+    HOST_CHECK( test_publishes == 1u );
+    HOST_CHECK( test_published.adc_raw[ eADC1_9 ] == ( int ) ( ( 4000u + 6u ) >> 1 ) );
+    HOST_CHECK( p_stats->conversions == 4u );
+    HOST_CHECK( p_stats->samples == 4u );
+    HOST_CHECK( p_stats->missing == 0u );
+
+    /* An empty FIFO: the expected result is missing */
+    before = *p_stats;
+    testConversion( 0u, 0u, FALSE );
+    HOST_CHECK( p_stats->missing == ( before.missing + 1u ) );
+    HOST_CHECK( p_stats->samples == before.samples );
+
+    /* An overrun: the FIFO is reset and dropped, counted as an overrun only */
+    before = *p_stats;
+    testConversion( 1u, TEST_RESULT( TEST_HW_CHANNEL, 1000u ), TRUE );
+    HOST_CHECK( p_stats->overruns == ( before.overruns + 1u ) );
+    HOST_CHECK( adcREG1->GxFIFORESETCR[ TEST_GROUP ] == 1U );
+    HOST_CHECK( p_stats->missing == before.missing );
+    HOST_CHECK( p_stats->samples == before.samples );
+
+    /* A result of an unconfigured channel */
+    before = *p_stats;
+    testConversion( 1u, TEST_RESULT( TEST_HW_UNUSED, 1000u ), FALSE );
+    HOST_CHECK( p_stats->unknown == ( before.unknown + 1u ) );
+    HOST_CHECK( p_stats->samples == ( before.samples + 1u ) );
+
+    /* End of conversion and threshold flags cleared, the overrun flag left alone */
+    HOST_CHECK( adcREG1->GxINTFLG[ TEST_GROUP ] == ( ADC_INTFLG_END | ADC_INTFLG_THRESHOLD ) );
+}
+
+static void testPingPong( void )
+{
+    S_ADC_DMA_STATE state = { 0u };
+
+    /* In turn, in time */
+    HOST_CHECK( adcPingPongTake( &state, 0u, FALSE ) == 0u );
+    HOST_CHECK( adcPingPongTake( &state, 1u, FALSE ) == 0u );
+    HOST_CHECK( adcPingPongTake( &state, 0u, FALSE ) == 0u );
+
+    /* Half 1 never signalled: this half 0 comes second in a row */
+    HOST_CHECK( adcPingPongTake( &state, 0u, FALSE ) == 1u );
+    HOST_CHECK( state.next_half == 1u );
+
+    /* The other half completed as well: this one is being refilled */
+    HOST_CHECK( adcPingPongTake( &state, 1u, TRUE ) == 1u );
+
+    /* Both */
+    HOST_CHECK( adcPingPongTake( &state, 1u, TRUE ) == 2u );
+    HOST_CHECK( adcPingPongTake( &state, 0u, FALSE ) == 0u );
+}
+
+/* The DMA filled half of the stream's buffer, value i for result i */
+static void testDmaFill( U32 half, U32 base )
+{
+    U32 i;
+
+    for ( i = 0u; i < adc_dma_config_defs[ 0 ].block_results; i++ )
+    {
+        adc_dma_buffer[ 0 ][ ( half * adc_dma_config_defs[ 0 ].block_results ) + i ] = TEST_RESULT( TEST_HW_CHANNEL, base + i );
+    }
+}
+
+static void testDma( void )
+{
+    const S_ADC_GROUP_STATS *p_stats = adcGetStats( TEST_UNIT, TEST_GROUP );
+    const U32 block = adc_dma_config_defs[ 0 ].block_results;
+    S_ADC_GROUP_STATS before;
+
+    adc_init();
+
+    /* The stream is off in adc_dma_config_defs, map it by hand */
+    adc_dma_stream_of_channel[ TEST_DMA_CHANNEL ] = 0u;
+    adc_dma_state[ 0 ].next_half = 0u;
+    adcSetBlockHandler( testBlockHandler );
+    test_publishes = 0u;
+    test_handler_calls = 0u;
+
+    /* HBC, then BTC */
+    testDmaFill( 0u, 0u );
+    adcDmaBlock( TEST_DMA_CHANNEL, 0u );
+    HOST_CHECK( p_stats->blocks == 1u );
+    HOST_CHECK( p_stats->samples == block );
+    HOST_CHECK( test_handler_calls == 1u );
+    HOST_CHECK( test_handler_results == &adc_dma_buffer[ 0 ][ 0 ] );
+    HOST_CHECK( test_handler_count == block );
+    HOST_CHECK( test_publishes == 1u );
+
+    /* Last boxcar of the block: results block - 4 .. block - 1 */
+    HOST_CHECK( test_published.adc_raw[ eADC1_9 ] == ( int ) ( ( ( 4u * block ) - 10u ) >> 1 ) );
+
+    testDmaFill( 1u, 2000u );
+    adcDmaBlock( TEST_DMA_CHANNEL, 1u );
+    HOST_CHECK( p_stats->blocks == 2u );
+    HOST_CHECK( test_handler_results == &adc_dma_buffer[ 0 ][ block ] );
+    HOST_CHECK( p_stats->block_overruns == 0u );
+
+    /* The same half again: the other one was lost, so is this */
+    before = *p_stats;
+    adcDmaBlock( TEST_DMA_CHANNEL, 1u );
+    HOST_CHECK( p_stats->block_overruns == ( before.block_overruns + 1u ) );
+    HOST_CHECK( p_stats->blocks == before.blocks );
+    HOST_CHECK( test_handler_calls == 2u );
+
+    /* Half 0 handled with half 1 already complete: the DMA is refilling half 0 */
+    before = *p_stats;
+    dmaREG->BTCFLAG = ( U32 ) 1U << TEST_DMA_CHANNEL;
+    adcDmaBlock( TEST_DMA_CHANNEL, 0u );
+    dmaREG->BTCFLAG = 0U;
+    HOST_CHECK( p_stats->block_overruns == ( before.block_overruns + 1u ) );
+    HOST_CHECK( p_stats->blocks == before.blocks );
+
+    /* Back in step */
+    adcDmaBlock( TEST_DMA_CHANNEL, 1u );
+    HOST_CHECK( p_stats->blocks == ( before.blocks + 1u ) );
+
+    /* The DMA fell behind the conversions: the FIFO is reset */
+    before = *p_stats;
+    adcREG1->GxINTFLG[ TEST_GROUP ] = ADC_INTFLG_OVERRUN;
+    adcREG1->GxFIFORESETCR[ TEST_GROUP ] = 0U;
+    adcDmaBlock( TEST_DMA_CHANNEL, 0u );
+    adcREG1->GxINTFLG[ TEST_GROUP ] = 0U;
+    HOST_CHECK( p_stats->overruns == ( before.overruns + 1u ) );
+    HOST_CHECK( adcREG1->GxFIFORESETCR[ TEST_GROUP ] == 1U );
+
+    /* Channels without a stream are ignored */
+    before = *p_stats;
+    adcDmaBlock( TEST_DMA_CHANNEL + 1u, 0u );
+    adcDmaBlock( 32u, 0u );
+    HOST_CHECK( memcmp( &before, p_stats, sizeof( before ) ) == 0 );
+}
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+int main( void )
+{
+    testFifo();
+    testPingPong();
+    testDma();
+
+    return HOST_RESULT();
+}
+
+/*----------------------------------------------------------------------------\
+|   End of test_adc.c module                                                  |
+\----------------------------------------------------------------------------*/
@@ -0,0 +1,442 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : test_dio.c Module File.                                    |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   fw_dio pin resolution and port stores against a RAM register model.       |
+|                                                                             |
+|   fw_dio.c is included here with every gioPORT_t port, the GIO, DMM and     |
+|   MIBSPI3 module registers and rtiREG1 pointing at RAM. A store to DSET     |
+|   or DCLR is not folded into DOUT as the hardware does: the register        |
+|   keeps the last value stored. Registers that must not be written are       |
+|   preset to a marker, so a stray store, even of 0, shows. A store of        |
+|   the whole port mask shows that the pins of the port were composed into    |
+|   one store; per pin stores would leave the last pin only. DMM stores       |
+|   from user mode go through writePrivRegister32(), counted here.            |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "host_test.h"
+
+#include "HL_reg_gio.h"
+#include "HL_reg_het.h"
+#include "HL_reg_dmm.h"
+#include "HL_reg_mibspi.h"
+#include "fw_utils.h"
+
+/*----------------------------------------------------------------------------\
+|   Register Model                                                            |
+\----------------------------------------------------------------------------*/
+
+static gioPORT_t test_ports[ 6 ];
+static gioBASE_t test_gio;
+static dmmBASE_t test_dmm;
+static mibspiBASE_t test_mibspi;
+static rtiBASE_t test_rti;
+
+#undef gioREG
+#undef gioPORTA
+#undef gioPORTB
+#undef hetPORT1
+#undef hetPORT2
+#undef dmmREG
+#undef dmmPORT
+#undef mibspiREG3
+#undef mibspiPORT3
+#undef rtiREG1
+#define gioREG                      ( &test_gio )
+#define gioPORTA                    ( &test_ports[ 0 ] )
+#define gioPORTB                    ( &test_ports[ 1 ] )
+#define hetPORT1                    ( &test_ports[ 2 ] )
+#define hetPORT2                    ( &test_ports[ 3 ] )
+#define dmmREG                      ( &test_dmm )
+#define dmmPORT                     ( &test_ports[ 4 ] )
+#define mibspiREG3                  ( &test_mibspi )
+#define mibspiPORT3                 ( &test_ports[ 5 ] )
+#define rtiREG1                     ( &test_rti )
+
+#include "fw_dio.c"
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define TEST_UNTOUCHED              0xA5A5A5A5u         /* Marker of a register not stored to */
+#define TEST_CPSR_USER              0x10u
+#define TEST_CPSR_SYSTEM            0x1Fu
+#define TEST_BIT( pin )             ( ( U32 ) 1u << ( pin ) )
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static U32 test_cpsr = TEST_CPSR_SYSTEM;
+static U32 test_priv_writes;
+
+/*----------------------------------------------------------------------------\
+|   Target Stand-ins                                                          |
+\----------------------------------------------------------------------------*/
+
+uint32 _getCPSRValue_( void )
+{
+    return test_cpsr;
+}
+
+uint32_t writePrivRegister32( uint32_t *pu32Address, uint32_t u32Value )
+{
+    test_priv_writes++;
+    *( volatile uint32_t * ) pu32Address = u32Value;
+
+    return u32Value;
+}
+
+void dmDigitalsPublish( const S_DIGITAL_IO *src )
+{
+    ( void ) src;
+}
+
+void gkSignalFromISR( E_GK_SOURCE source, portBaseType *woken )
+{
+    ( void ) source;
+    ( void ) woken;
+}
+
+void trcRecord( U16 event, U16 arg, U32 object )
+{
+    ( void ) event;
+    ( void ) arg;
+    ( void ) object;
+}
+
+void vimChannelMap( uint32 request, uint32 channel, t_isrFuncPTR handler )
+{
+    ( void ) request;
+    ( void ) channel;
+    ( void ) handler;
+}
+
+void vimEnableInterrupt( uint32 channel, systemInterrupt_t inttype )
+{
+    ( void ) channel;
+    ( void ) inttype;
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+/* Marks DSET and DCLR of every port as not stored to */
+static void testMarkStores( void )
+{
+    U32 i;
+
+    for ( i = 0u; i < eDIO_MAX_PORTS; i++ )
+    {
+        test_ports[ i ].DSET = TEST_UNTOUCHED;
+        test_ports[ i ].DCLR = TEST_UNTOUCHED;
+    }
+    test_priv_writes = 0u;
+}
+
+/* The value a port register must hold: a mask stored, or the marker for none */
+static U32 testStored( U32 mask )
+{
+    U32 stored = TEST_UNTOUCHED;
+
+    if ( mask != 0u )
+    {
+        stored = mask;
+    }
+
+    return stored;
+}
+
+static void testResolve( void )
+{
+    S_DIO_PIN pin;
+
+    HOST_CHECK( dioResolve( &pin, TRUE, eDIO_PORT_HET1, 17u ) == TEST_BIT( 17u ) );
+    HOST_CHECK( ( pin.port == eDIO_PORT_HET1 ) && ( pin.mask == TEST_BIT( 17u ) ) );
+
+    HOST_CHECK( dioResolve( &pin, TRUE, eDIO_PORT_MIBSPI3, 31u ) == TEST_BIT( 31u ) );
+    HOST_CHECK( pin.port == eDIO_PORT_MIBSPI3 );
+
+    /* Disabled, invalid port, invalid pin: an empty mask on port 0 */
+    HOST_CHECK( dioResolve( &pin, FALSE, eDIO_PORT_DMM, 12u ) == 0u );
+    HOST_CHECK( ( pin.port == 0u ) && ( pin.mask == 0u ) );
+
+    HOST_CHECK( dioResolve( &pin, TRUE, eDIO_MAX_PORTS, 1u ) == 0u );
+    HOST_CHECK( ( pin.port == 0u ) && ( pin.mask == 0u ) );
+
+    HOST_CHECK( dioResolve( &pin, TRUE, eDIO_PORTA, ( U8 ) DIO_PORT_WIDTH ) == 0u );
+    HOST_CHECK( ( pin.port == 0u ) && ( pin.mask == 0u ) );
+}
+
+/* Both init passes against the pin tables, from reset values */
+static void testInit( void )
+{
+    const S_DIO_INPUT_PIN_DEF * const p_in = dioConfigGetDIConfig();
+    const S_DIO_OUTPUT_PIN_DEF * const p_out = dioConfigGetDOConfig();
+    U32 in[ eDIO_MAX_PORTS ] = { 0u };
+    U32 pull_off[ eDIO_MAX_PORTS ] = { 0u };
+    U32 out[ eDIO_MAX_PORTS ] = { 0u };
+    U32 open_drain[ eDIO_MAX_PORTS ] = { 0u };
+    U32 i;
+
+    memset( ( void * ) test_ports, 0, sizeof( test_ports ) );
+    memset( ( void * ) &test_gio, 0, sizeof( test_gio ) );
+    test_dmm.PC0 = 0xFFFFFFFFu;                         /* Every pin functional */
+    test_mibspi.PC0 = 0xFFFFFFFFu;
+    testMarkStores();
+
+    for ( i = 0u; i < eDIO_NUM_INPUT_PINS; i++ )
+    {
+        if ( p_in[ i ].enabled == TRUE )
+        {
+            in[ p_in[ i ].port ] |= TEST_BIT( p_in[ i ].pin );
+            if ( ( p_in[ i ].pull_enable == FALSE ) || ( p_in[ i ].pull == ePULL_NONE ) )
+            {
+                pull_off[ p_in[ i ].port ] |= TEST_BIT( p_in[ i ].pin );
+            }
+        }
+    }
+    for ( i = 0u; i < eDIO_NUM_OUTPUT_PINS; i++ )
+    {
+        if ( p_out[ i ].enabled == TRUE )
+        {
+            out[ p_out[ i ].port ] |= TEST_BIT( p_out[ i ].pin );
+            if ( p_out[ i ].open_drain == TRUE )
+            {
+                open_drain[ p_out[ i ].port ] |= TEST_BIT( p_out[ i ].pin );
+            }
+            HOST_CHECK( p_out[ i ].value == 0 );        /* All start low: DSET is stored 0 */
+        }
+    }
+
+    dioHandlerInit();
+    HOST_CHECK( dioHandlerInitInputPins() == TRUE );
+    HOST_CHECK( dioHandlerInitOutputPins() == TRUE );
+
+    HOST_CHECK( test_gio.GCR0 == 1u );
+    HOST_CHECK( test_mibspi.GCR0 == 1u );
+
+    for ( i = 0u; i < eDIO_MAX_PORTS; i++ )
+    {
+        HOST_CHECK( test_ports[ i ].DIR == out[ i ] );
+        HOST_CHECK( test_ports[ i ].PDR == open_drain[ i ] );
+        HOST_CHECK( test_ports[ i ].PULDIS == pull_off[ i ] );
+        HOST_CHECK( test_ports[ i ].PSL == 0u );
+        if ( out[ i ] == 0u )
+        {
+            HOST_CHECK( test_ports[ i ].DSET == TEST_UNTOUCHED );
+            HOST_CHECK( test_ports[ i ].DCLR == TEST_UNTOUCHED );
+        }
+        else
+        {
+            HOST_CHECK( test_ports[ i ].DSET == 0u );
+            HOST_CHECK( test_ports[ i ].DCLR == out[ i ] );
+        }
+    }
+
+    /* The pins used leave their peripheral function, the others keep it */
+    HOST_CHECK( test_dmm.PC0 == ~( in[ eDIO_PORT_DMM ] | out[ eDIO_PORT_DMM ] ) );
+    HOST_CHECK( test_mibspi.PC0 == ~out[ eDIO_PORT_MIBSPI3 ] );
+
+    /* The disabled open drain LED shares J17 with an enabled push-pull output */
+    HOST_CHECK( dio_output_pins[ eDIO_OUTPUT_PIN_LED_LEFT_BOTTOM ].mask == 0u );
+    HOST_CHECK( ( test_ports[ eDIO_PORT_HET1 ].PDR & TEST_BIT( 31u ) ) == 0u );
+    HOST_CHECK( dio_output_pins[ eDIO_OUTPUT_PIN_J17_VPOS_5019 ].mask == TEST_BIT( 31u ) );
+}
+
+/* Single pin access: one store of the pin bit to DSET or DCLR of its port */
+static void testSingle( void )
+{
+    const S_DIO_OUTPUT_PIN_DEF * const p_out = dioConfigGetDOConfig();
+    U32 i;
+    U32 p;
+    U32 port;
+    U32 bit;
+
+    test_cpsr = TEST_CPSR_USER;
+
+    for ( i = 0u; i < eDIO_NUM_OUTPUT_PINS; i++ )
+    {
+        port = p_out[ i ].port;
+        bit = 0u;
+        if ( p_out[ i ].enabled == TRUE )
+        {
+            bit = TEST_BIT( p_out[ i ].pin );
+        }
+
+        testMarkStores();
+        set_digital_output( ( E_DIO_OUTPUT_PIN_ID ) i, TRUE );
+        for ( p = 0u; p < eDIO_MAX_PORTS; p++ )
+        {
+            HOST_CHECK( test_ports[ p ].DSET == testStored( ( p == port ) ? bit : 0u ) );
+            HOST_CHECK( test_ports[ p ].DCLR == TEST_UNTOUCHED );
+        }
+
+        testMarkStores();
+        set_digital_output( ( E_DIO_OUTPUT_PIN_ID ) i, FALSE );
+        for ( p = 0u; p < eDIO_MAX_PORTS; p++ )
+        {
+            HOST_CHECK( test_ports[ p ].DSET == TEST_UNTOUCHED );
+            HOST_CHECK( test_ports[ p ].DCLR == testStored( ( p == port ) ? bit : 0u ) );
+        }
+
+        /* Only the privileged port goes through the SVC from user mode */
+        HOST_CHECK( test_priv_writes == ( ( ( bit != 0u ) && ( port == eDIO_PORT_DMM ) ) ? 1u : 0u ) );
+
+        /* Toggle follows DOUT */
+        testMarkStores();
+        test_ports[ port ].DOUT = bit;
+        toggle_output_pin( ( E_DIO_OUTPUT_PIN_ID ) i );
+        HOST_CHECK( test_ports[ port ].DCLR == testStored( bit ) );
+        HOST_CHECK( test_ports[ port ].DSET == TEST_UNTOUCHED );
+        test_ports[ port ].DOUT = 0u;
+    }
+
+    /* No store for a pin out of range */
+    testMarkStores();
+    set_digital_output( eDIO_NUM_OUTPUT_PINS, TRUE );
+    for ( p = 0u; p < eDIO_MAX_PORTS; p++ )
+    {
+        HOST_CHECK( test_ports[ p ].DSET == TEST_UNTOUCHED );
+    }
+
+    /* From a privileged mode the DMM port is stored to directly */
+    test_cpsr = TEST_CPSR_SYSTEM;
+    testMarkStores();
+    set_digital_output( eDIO_OUTPUT_PIN_H17_RS485_DE, TRUE );
+    HOST_CHECK( test_ports[ eDIO_PORT_DMM ].DSET == TEST_BIT( 12u ) );
+    HOST_CHECK( test_priv_writes == 0u );
+
+    /* Inputs read their DIN bit */
+    test_ports[ eDIO_PORT_DMM ].DIN = TEST_BIT( 16u );
+    HOST_CHECK( read_digital_input( eDIO_INPUT_PIN_H16_AISG_DIR ) == TRUE );
+    test_ports[ eDIO_PORT_DMM ].DIN = ~TEST_BIT( 16u );
+    HOST_CHECK( read_digital_input( eDIO_INPUT_PIN_H16_AISG_DIR ) == FALSE );
+    HOST_CHECK( read_digital_input( eDIO_NUM_INPUT_PINS ) == FALSE );
+    test_ports[ eDIO_PORT_DMM ].DIN = 0u;
+}
+
+/* A batch over four ports: one DSET and one DCLR store per port touched */
+static void testBatch( void )
+{
+    static const U32 set[ eDIO_MAX_PORTS ] =
+    {
+        [ eDIO_PORTB ] = TEST_BIT( 6u ),
+        [ eDIO_PORT_HET1 ] = TEST_BIT( 15u ) | TEST_BIT( 31u ),
+        [ eDIO_PORT_DMM ] = TEST_BIT( 12u ),
+        [ eDIO_PORT_MIBSPI3 ] = TEST_BIT( 8u ) | TEST_BIT( 10u ),
+    };
+    static const U32 clr[ eDIO_MAX_PORTS ] =
+    {
+        [ eDIO_PORTB ] = TEST_BIT( 7u ),
+        [ eDIO_PORT_HET1 ] = TEST_BIT( 5u ) | TEST_BIT( 17u ),
+        [ eDIO_PORT_MIBSPI3 ] = TEST_BIT( 11u ),
+    };
+    const U32 dout = 0x0F0F0F0Fu;
+    S_DIO_BATCH batch;
+    U32 p;
+
+    dioBatchClear( &batch );
+    dioBatchOutput( &batch, eDIO_OUTPUT_PIN_LED_6, TRUE );
+    dioBatchOutput( &batch, eDIO_OUTPUT_PIN_LED_7, FALSE );
+    dioBatchOutput( &batch, eDIO_OUTPUT_PIN_A13_RS485_REB, TRUE );
+    dioBatchOutput( &batch, eDIO_OUTPUT_PIN_J17_VPOS_5019, TRUE );
+    dioBatchOutput( &batch, eDIO_OUTPUT_PIN_N1_POW_SWDT, TRUE );
+    dioBatchOutput( &batch, eDIO_OUTPUT_PIN_V6_FLT_BYPASS_SW, FALSE );
+    dioBatchOutput( &batch, eDIO_OUTPUT_PIN_A13_RS485_REB, FALSE );     /* The last level wins */
+    dioBatchOutput( &batch, eDIO_OUTPUT_PIN_LED_LEFT_BOTTOM, FALSE );   /* Disabled, no bit */
+    dioBatchOutput( &batch, eDIO_OUTPUT_PIN_H17_RS485_DE, TRUE );
+    dioBatchOutput( &batch, eDIO_OUTPUT_PIN_W8_DEMOD_ENA, TRUE );
+    dioBatchOutput( &batch, eDIO_OUTPUT_PIN_V8_GAIN_ACTIVE_2, FALSE );
+    dioBatchOutput( &batch, eDIO_OUTPUT_PIN_W9_GAIN_ACTIVE_1, TRUE );
+    dioBatchOutput( &batch, eDIO_NUM_OUTPUT_PINS, TRUE );               /* Out of range, ignored */
+
+    for ( p = 0u; p < eDIO_MAX_PORTS; p++ )
+    {
+        HOST_CHECK( batch.set[ p ] == set[ p ] );
+        HOST_CHECK( batch.clr[ p ] == clr[ p ] );
+    }
+
+    /* From user mode the DMM store goes through the SVC, only its set mask is not empty */
+    test_cpsr = TEST_CPSR_USER;
+    testMarkStores();
+    dioBatchCommit( &batch );
+    for ( p = 0u; p < eDIO_MAX_PORTS; p++ )
+    {
+        HOST_CHECK( test_ports[ p ].DSET == testStored( set[ p ] ) );
+        HOST_CHECK( test_ports[ p ].DCLR == testStored( clr[ p ] ) );
+    }
+    HOST_CHECK( test_priv_writes == 1u );
+
+    /* One DOUT store per port touched, untouched ports and DSET / DCLR left alone */
+    test_cpsr = TEST_CPSR_SYSTEM;
+    testMarkStores();
+    for ( p = 0u; p < eDIO_MAX_PORTS; p++ )
+    {
+        test_ports[ p ].DOUT = dout;
+    }
+    dioBatchCommitAtomic( &batch );
+    for ( p = 0u; p < eDIO_MAX_PORTS; p++ )
+    {
+        HOST_CHECK( test_ports[ p ].DOUT == ( ( dout | set[ p ] ) & ~clr[ p ] ) );
+        HOST_CHECK( test_ports[ p ].DSET == TEST_UNTOUCHED );
+        HOST_CHECK( test_ports[ p ].DCLR == TEST_UNTOUCHED );
+    }
+    HOST_CHECK( dioReadOutputPort( eDIO_PORT_HET1 ) == ( ( dout | set[ eDIO_PORT_HET1 ] ) & ~clr[ eDIO_PORT_HET1 ] ) );
+
+    /* An empty batch stores nothing */
+    dioBatchClear( &batch );
+    testMarkStores();
+    dioBatchCommit( &batch );
+    for ( p = 0u; p < eDIO_MAX_PORTS; p++ )
+    {
+        HOST_CHECK( test_ports[ p ].DSET == TEST_UNTOUCHED );
+        HOST_CHECK( test_ports[ p ].DCLR == TEST_UNTOUCHED );
+    }
+
+    /* dioWritePort composes the same way */
+    testMarkStores();
+    dioWritePort( eDIO_PORT_HET1, 0x000000FFu, 0x0000000Fu );
+    HOST_CHECK( test_ports[ eDIO_PORT_HET1 ].DSET == 0x0000000Fu );
+    HOST_CHECK( test_ports[ eDIO_PORT_HET1 ].DCLR == 0x000000F0u );
+}
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+int main( void )
+{
+    testResolve();
+    testInit();
+    testSingle();
+    testBatch();
+
+    printf( "dio: %u ports, %u inputs, %u outputs\n", eDIO_MAX_PORTS, eDIO_NUM_INPUT_PINS, eDIO_NUM_OUTPUT_PINS );
+
+    return HOST_RESULT();
+}
+
+/*----------------------------------------------------------------------------\
+|   End of test_dio.c module                                                  |
+\----------------------------------------------------------------------------*/
@@ -0,0 +1,276 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : test_dm_latch.c Module File.                               |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Data Manager latch torn read stress test.                                 |
+|                                                                             |
+|   One writer thread publishes the Analogue Inputs dataset with every        |
+|   word of publish n set to n, reader threads read it back through           |
+|   dmAnalogueInputsRead() as fast as they can. A snapshot must hold a        |
+|   single n throughout, n must equal the returned version and must never     |
+|   go backwards for one reader.                                              |
+|                                                                             |
+|   On the target an interrupt splits a read or a publish part way through    |
+|   a copy. Here data_manager.c is built with its memcpy() replaced by        |
+|   testCopy(), which yields the processor at random points of a copy, so     |
+|   reads and publishes interleave at word granularity on one core as well.   |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "host_test.h"
+
+#include "data_manager.h"
+#include "dm_history.h"
+#include "HL_sys_core.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define TEST_READERS                2u
+#define TEST_RUN_NS                 2000000000u
+#define TEST_CPSR_SYSTEM            0x1Fu
+#define TEST_YIELD_ODDS             8u                  /* One word in 8 yields */
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    U32                         reads;
+    U32                         torn;               /* Words from different publishes */
+    U32                         mismatched;         /* Contents not of the returned version */
+    U32                         backwards;          /* Older than the previous read */
+} S_TEST_READER;
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static volatile int test_stop;
+static U32 test_publishes;
+static __thread uint32_t test_seed;
+
+/*----------------------------------------------------------------------------\
+|   Target Stand-ins                                                          |
+\----------------------------------------------------------------------------*/
+
+/* memcpy() of data_manager.c, see the Makefile; the datasets are word sized */
+void *testCopy( void *dst, const void *src, size_t size )
+{
+    volatile U32 *p_dst = ( volatile U32 * ) dst;
+    const volatile U32 *p_src = ( const volatile U32 * ) src;
+    size_t i;
+
+    if ( test_seed == 0u )
+    {
+        test_seed = ( uint32_t ) ( uintptr_t ) &test_seed | 1u;
+    }
+
+    for ( i = 0u; i < ( size / sizeof( U32 ) ); i++ )
+    {
+        p_dst[ i ] = p_src[ i ];
+        if ( ( hostRand( &test_seed ) % TEST_YIELD_ODDS ) == 0u )
+        {
+            sched_yield();
+        }
+    }
+
+    return dst;
+}
+
+/* No subscribers are registered, so dmNotify() never reaches the kernel */
+uint32 _getCPSRValue_( void )
+{
+    return TEST_CPSR_SYSTEM;
+}
+
+BaseType_t MPU_xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+{
+    ( void ) xTaskToNotify;
+    ( void ) ulValue;
+    ( void ) eAction;
+    ( void ) pulPreviousNotificationValue;
+
+    return pdPASS;
+}
+
+BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+{
+    ( void ) xTaskToNotify;
+    ( void ) ulValue;
+    ( void ) eAction;
+    ( void ) pulPreviousNotificationValue;
+    ( void ) pxHigherPriorityTaskWoken;
+
+    return pdPASS;
+}
+
+void dmHistoryInit( void )
+{
+}
+
+void dmHistoryStore( U32 signal, S32 value )
+{
+    ( void ) signal;
+    ( void ) value;
+}
+
+const S_DIO_INPUT_PIN_DEF * const dioConfigGetDIConfig( void )
+{
+    return NULL;
+}
+
+const S_DIO_OUTPUT_PIN_DEF * const dioConfigGetDOConfig( void )
+{
+    return NULL;
+}
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+static void testFill( S_ANALOGUE_INPUTS *p_ai, U32 n )
+{
+    U32 i;
+
+    for ( i = 0u; i < ( U32 ) eADC_CHANNEL_MAX; i++ )
+    {
+        p_ai->adc_raw[ i ] = ( int ) n;
+        p_ai->adc_eng[ i ] = ( S32 ) n;
+        p_ai->adc_time[ i ] = n;
+    }
+}
+
+static void *testWriter( void *arg )
+{
+    S_ANALOGUE_INPUTS ai;
+    U32 n = 0u;
+
+    ( void ) arg;
+
+    while ( test_stop == 0 )
+    {
+        n++;
+        testFill( &ai, n );
+        dmAnalogueInputsPublish( &ai );
+    }
+
+    test_publishes = n;
+
+    return NULL;
+}
+
+static void *testReader( void *arg )
+{
+    S_TEST_READER *p_r = ( S_TEST_READER * ) arg;
+    S_ANALOGUE_INPUTS ai;
+    U32 version;
+    U32 last = 0u;
+    U32 i;
+
+    while ( test_stop == 0 )
+    {
+        version = dmAnalogueInputsRead( &ai );
+        p_r->reads++;
+
+        for ( i = 0u; i < ( U32 ) eADC_CHANNEL_MAX; i++ )
+        {
+            if ( ( ( U32 ) ai.adc_raw[ i ] != ai.adc_time[ 0 ] ) ||
+                 ( ( U32 ) ai.adc_eng[ i ] != ai.adc_time[ 0 ] ) ||
+                 ( ai.adc_time[ i ] != ai.adc_time[ 0 ] ) )
+            {
+                p_r->torn++;
+                break;
+            }
+        }
+
+        if ( ai.adc_time[ 0 ] != version )
+        {
+            p_r->mismatched++;
+        }
+
+        if ( version < last )
+        {
+            p_r->backwards++;
+        }
+        last = version;
+    }
+
+    return NULL;
+}
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+int main( void )
+{
+    static S_TEST_READER readers[ TEST_READERS ];
+    pthread_t writer;
+    pthread_t reader_threads[ TEST_READERS ];
+    struct timespec run = { TEST_RUN_NS / 1000000000u, TEST_RUN_NS % 1000000000u };
+    S_ANALOGUE_INPUTS ai;
+    U32 i;
+
+    dmDataManagerInit();
+
+    /* Nothing published yet: version 0, zeroed contents */
+    HOST_CHECK( dmAnalogueInputsRead( &ai ) == 0u );
+    HOST_CHECK( ai.adc_time[ 0 ] == 0u );
+
+    for ( i = 0u; i < TEST_READERS; i++ )
+    {
+        pthread_create( &reader_threads[ i ], NULL, testReader, &readers[ i ] );
+    }
+    pthread_create( &writer, NULL, testWriter, NULL );
+
+    nanosleep( &run, NULL );
+    test_stop = 1;
+
+    pthread_join( writer, NULL );
+    for ( i = 0u; i < TEST_READERS; i++ )
+    {
+        pthread_join( reader_threads[ i ], NULL );
+
+        printf( "reader %u: %u reads, %u torn, %u not of their version, %u backwards\n",
+                i, readers[ i ].reads, readers[ i ].torn, readers[ i ].mismatched, readers[ i ].backwards );
+
+        HOST_CHECK( readers[ i ].reads > 0u );
+        HOST_CHECK( readers[ i ].torn == 0u );
+        HOST_CHECK( readers[ i ].mismatched == 0u );
+        HOST_CHECK( readers[ i ].backwards == 0u );
+    }
+    printf( "writer: %u publishes\n", test_publishes );
+
+    /* Quiet again: the last publish, in full */
+    HOST_CHECK( dmAnalogueInputsRead( &ai ) == test_publishes );
+    HOST_CHECK( ai.adc_raw[ eADC_CHANNEL_MAX - 1 ] == ( int ) test_publishes );
+
+    return HOST_RESULT();
+}
+
+/*----------------------------------------------------------------------------\
+|   End of test_dm_latch.c module                                             |
+\----------------------------------------------------------------------------*/
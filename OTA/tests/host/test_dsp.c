@@ -0,0 +1,350 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : test_dsp.c Module File.                                    |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   fw_dsp bit exactness tests.                                               |
+|                                                                             |
+|   The host SMUAD / SMLAD model is checked against the instructions as the   |
+|   ARM ARM defines them, worked out in 64 bits and truncated to the 32 bit   |
+|   destination, on the corner cases and on random operands. Every filter     |
+|   is then run over random and full scale inputs next to a per channel       |
+|   reference in plain 64 bit C, and must match it bit for bit. The           |
+|   Goertzel amplitude is checked against the tone put in.                    |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <math.h>
+
+#include "host_test.h"
+
+#include "fw_dsp.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define TEST_CHANNELS               7u                  /* Odd, no multiple of anything */
+#define TEST_STEPS                  20000u
+#define TEST_MAC_RANDOM             1000000u
+#define TEST_MOVAVG_LOG2            4u
+#define TEST_MEDIAN_LENGTH          5u
+#define TEST_RATE_SHIFT             3u
+#define TEST_TONE_HZ                50u
+#define TEST_SAMPLE_HZ              1000u
+#define TEST_TONE_BLOCK             1000u
+#define TEST_TONE_AMPLITUDE         1500
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static uint32_t test_seed = 0xC0FFEE11u;
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+/* SMLAD: Rd = Ra + Rn[15:0] * Rm[15:0] + Rn[31:16] * Rm[31:16], low 32 bits */
+static int32_t testArmSmlad( uint32_t n, uint32_t m, int32_t a )
+{
+    int64_t sum = ( int64_t ) a +
+                  ( ( int64_t ) ( int16_t ) ( n & 0xFFFFu ) * ( int16_t ) ( m & 0xFFFFu ) ) +
+                  ( ( int64_t ) ( int16_t ) ( n >> 16 ) * ( int16_t ) ( m >> 16 ) );
+
+    return ( int32_t ) ( uint32_t ) ( uint64_t ) sum;
+}
+
+/* Random Q15, one in 8 at full scale */
+static Q15 testInput( void )
+{
+    uint32_t r = hostRand( &test_seed );
+
+    switch ( r & 7u )
+    {
+        case 0u:
+            return DSP_Q15_MAX;
+        case 1u:
+            return DSP_Q15_MIN;
+        default:
+            return ( Q15 ) ( r >> 16 );
+    }
+}
+
+static void testMac( void )
+{
+    static const uint16_t corners[] = { 0x0000u, 0x0001u, 0x7FFFu, 0x8000u, 0x8001u, 0xFFFFu };
+    static const int32_t accs[] = { 0, 1, -1, INT32_MAX, INT32_MIN, 0x40000000 };
+    const size_t n_corners = sizeof( corners ) / sizeof( corners[ 0 ] );
+    const size_t n_accs = sizeof( accs ) / sizeof( accs[ 0 ] );
+    unsigned errors = 0u;
+    size_t combo;
+    size_t k;
+    uint32_t x;
+    uint32_t y;
+    int32_t acc;
+
+    /* Every corner in every half of both operands, with every accumulator */
+    for ( combo = 0u; combo < ( n_corners * n_corners * n_corners * n_corners ); combo++ )
+    {
+        x = DSP_PACK( corners[ combo % n_corners ], corners[ ( combo / n_corners ) % n_corners ] );
+        y = DSP_PACK( corners[ ( combo / ( n_corners * n_corners ) ) % n_corners ], corners[ combo / ( n_corners * n_corners * n_corners ) ] );
+
+        for ( k = 0u; k < n_accs; k++ )
+        {
+            errors += ( DSP_SMLAD( x, y, accs[ k ] ) != testArmSmlad( x, y, accs[ k ] ) );
+        }
+        errors += ( DSP_SMUAD( x, y ) != testArmSmlad( x, y, 0 ) );
+    }
+
+    /* 0x8000 * 0x8000 twice: 2^31, the one SMUAD result that wraps */
+    HOST_CHECK( DSP_SMUAD( 0x80008000u, 0x80008000u ) == INT32_MIN );
+
+    for ( k = 0u; k < TEST_MAC_RANDOM; k++ )
+    {
+        x = hostRand( &test_seed );
+        y = hostRand( &test_seed );
+        acc = ( int32_t ) hostRand( &test_seed );
+
+        errors += ( DSP_SMLAD( x, y, acc ) != testArmSmlad( x, y, acc ) );
+    }
+
+    printf( "mac: %u mismatches\n", errors );
+    HOST_CHECK( errors == 0u );
+}
+
+static void testLowpass( void )
+{
+    static const Q15 a[ TEST_CHANNELS ] = { 1, 2, 327, 8192, 16384, 32000, DSP_Q15_MAX };
+    S_DSP_LOWPASS f;
+    U32 coef[ TEST_CHANNELS ];
+    Q15 y[ TEST_CHANNELS ];
+    Q15 x[ TEST_CHANNELS ];
+    int32_t ref[ TEST_CHANNELS ] = { 0 };
+    unsigned errors = 0u;
+    U32 step;
+    U32 i;
+
+    HOST_CHECK( dspLowpassInit( &f, TEST_CHANNELS, coef, y, a ) == TRUE );
+
+    for ( step = 0u; step < TEST_STEPS; step++ )
+    {
+        for ( i = 0u; i < TEST_CHANNELS; i++ )
+        {
+            x[ i ] = testInput();
+        }
+        dspLowpass( &f, x );
+
+        for ( i = 0u; i < TEST_CHANNELS; i++ )
+        {
+            ref[ i ] = ( int32_t ) ( ( ( ( int64_t ) ( 32768 - a[ i ] ) * ref[ i ] ) + ( ( int64_t ) a[ i ] * x[ i ] ) + 0x4000 ) >> 15 );
+            errors += ( y[ i ] != ref[ i ] );
+        }
+    }
+
+    printf( "lowpass: %u mismatches\n", errors );
+    HOST_CHECK( errors == 0u );
+}
+
+static void testMovingAverage( void )
+{
+    const U32 length = 1u << TEST_MOVAVG_LOG2;
+    S_DSP_MOVAVG f;
+    Q15 history[ DSP_MOVAVG_WORDS( TEST_CHANNELS, TEST_MOVAVG_LOG2 ) ];
+    Q31 sum[ TEST_CHANNELS ];
+    Q15 y[ TEST_CHANNELS ];
+    Q15 x[ TEST_CHANNELS ];
+    Q15 window[ TEST_CHANNELS ][ 1u << TEST_MOVAVG_LOG2 ];
+    unsigned errors = 0u;
+    int64_t total;
+    U32 step;
+    U32 i;
+    U32 k;
+
+    memset( window, 0, sizeof( window ) );
+    HOST_CHECK( dspMovingAverageInit( &f, TEST_CHANNELS, DSP_MOVAVG_LOG2_MAX + 1u, history, sum, y ) == FALSE );
+    HOST_CHECK( dspMovingAverageInit( &f, TEST_CHANNELS, TEST_MOVAVG_LOG2, history, sum, y ) == TRUE );
+
+    for ( step = 0u; step < TEST_STEPS; step++ )
+    {
+        for ( i = 0u; i < TEST_CHANNELS; i++ )
+        {
+            x[ i ] = testInput();
+            window[ i ][ step % length ] = x[ i ];
+        }
+        dspMovingAverage( &f, x );
+
+        for ( i = 0u; i < TEST_CHANNELS; i++ )
+        {
+            total = 0;
+            for ( k = 0u; k < length; k++ )
+            {
+                total += window[ i ][ k ];
+            }
+            errors += ( y[ i ] != ( Q15 ) ( total >> TEST_MOVAVG_LOG2 ) );
+        }
+    }
+
+    printf( "moving average: %u mismatches\n", errors );
+    HOST_CHECK( errors == 0u );
+}
+
+static int testCompareQ15( const void *a, const void *b )
+{
+    return *( const Q15 * ) a - *( const Q15 * ) b;
+}
+
+static void testMedian( void )
+{
+    S_DSP_MEDIAN f;
+    Q15 history[ DSP_MEDIAN_WORDS( TEST_CHANNELS, TEST_MEDIAN_LENGTH ) ];
+    Q15 y[ TEST_CHANNELS ];
+    Q15 x[ TEST_CHANNELS ];
+    Q15 window[ TEST_CHANNELS ][ TEST_MEDIAN_LENGTH ];
+    Q15 sorted[ TEST_MEDIAN_LENGTH ];
+    unsigned errors = 0u;
+    U32 step;
+    U32 i;
+
+    memset( window, 0, sizeof( window ) );
+    HOST_CHECK( dspMedianInit( &f, TEST_CHANNELS, 4u, history, y ) == FALSE );
+    HOST_CHECK( dspMedianInit( &f, TEST_CHANNELS, TEST_MEDIAN_LENGTH, history, y ) == TRUE );
+
+    for ( step = 0u; step < TEST_STEPS; step++ )
+    {
+        for ( i = 0u; i < TEST_CHANNELS; i++ )
+        {
+            x[ i ] = testInput();
+            window[ i ][ step % TEST_MEDIAN_LENGTH ] = x[ i ];
+        }
+        dspMedian( &f, x );
+
+        for ( i = 0u; i < TEST_CHANNELS; i++ )
+        {
+            memcpy( sorted, window[ i ], sizeof( sorted ) );
+            qsort( sorted, TEST_MEDIAN_LENGTH, sizeof( Q15 ), testCompareQ15 );
+            errors += ( y[ i ] != sorted[ TEST_MEDIAN_LENGTH / 2u ] );
+        }
+    }
+
+    printf( "median: %u mismatches\n", errors );
+    HOST_CHECK( errors == 0u );
+}
+
+static void testRate( void )
+{
+    static const Q15 g[ TEST_CHANNELS ] = { 1, -1, 100, -4096, 16384, DSP_Q15_MAX, -DSP_Q15_MAX };
+    S_DSP_RATE f;
+    U32 coef[ TEST_CHANNELS ];
+    Q15 previous[ TEST_CHANNELS ];
+    Q15 y[ TEST_CHANNELS ];
+    Q15 x[ TEST_CHANNELS ];
+    Q15 ref_previous[ TEST_CHANNELS ] = { 0 };
+    unsigned errors = 0u;
+    int64_t ref;
+    U32 step;
+    U32 i;
+
+    HOST_CHECK( dspRateInit( &f, TEST_CHANNELS, 16u, coef, previous, y, g ) == FALSE );
+    HOST_CHECK( dspRateInit( &f, TEST_CHANNELS, TEST_RATE_SHIFT, coef, previous, y, g ) == TRUE );
+
+    for ( step = 0u; step < TEST_STEPS; step++ )
+    {
+        for ( i = 0u; i < TEST_CHANNELS; i++ )
+        {
+            x[ i ] = testInput();
+        }
+        dspRate( &f, x );
+
+        for ( i = 0u; i < TEST_CHANNELS; i++ )
+        {
+            ref = ( ( int64_t ) g[ i ] * ( x[ i ] - ref_previous[ i ] ) ) >> ( 15u - TEST_RATE_SHIFT );
+            ref = ( ref > DSP_Q15_MAX ) ? DSP_Q15_MAX : ( ( ref < DSP_Q15_MIN ) ? DSP_Q15_MIN : ref );
+            ref_previous[ i ] = x[ i ];
+            errors += ( y[ i ] != ref );
+        }
+    }
+
+    printf( "rate: %u mismatches\n", errors );
+    HOST_CHECK( errors == 0u );
+}
+
+static void testGoertzel( void )
+{
+    S_DSP_GOERTZEL g;
+    S_DSP_GOERTZEL off;
+    int64_t s1 = 0;
+    int64_t s2 = 0;
+    int64_t s0;
+    unsigned errors = 0u;
+    U32 amplitude;
+    S32 x;
+    U32 n;
+
+    dspGoertzelInit( &g, dspGoertzelCoef( TEST_TONE_HZ, TEST_SAMPLE_HZ ) );
+    dspGoertzelInit( &off, dspGoertzelCoef( 3u * TEST_TONE_HZ, TEST_SAMPLE_HZ ) );
+    HOST_CHECK( dspGoertzelCoef( 0u, TEST_SAMPLE_HZ ) == ( 1L << 30 ) );    /* 2.0 in Q29 */
+
+    for ( n = 0u; n < TEST_TONE_BLOCK; n++ )
+    {
+        x = ( S32 ) lrint( TEST_TONE_AMPLITUDE * sin( ( 2.0 * M_PI * TEST_TONE_HZ * n ) / TEST_SAMPLE_HZ ) );
+
+        dspGoertzelStep( &g, x );
+        dspGoertzelStep( &off, x );
+
+        s0 = x + ( ( ( int64_t ) g.coef * s1 ) >> DSP_GOERTZEL_Q ) - s2;
+        s2 = s1;
+        s1 = s0;
+        errors += ( ( g.s1 != s1 ) || ( g.s2 != s2 ) );
+    }
+
+    printf( "goertzel: %u mismatches\n", errors );
+    HOST_CHECK( errors == 0u );
+
+    /* The tone comes back within 1 %, the third harmonic bin stays empty */
+    amplitude = dspGoertzelAmplitude( &g, TEST_TONE_BLOCK );
+    HOST_CHECK( abs( ( int ) amplitude - TEST_TONE_AMPLITUDE ) <= ( TEST_TONE_AMPLITUDE / 100 ) );
+    HOST_CHECK( dspGoertzelAmplitude( &off, TEST_TONE_BLOCK ) <= 2u );
+    HOST_CHECK( ( g.s1 == 0 ) && ( g.s2 == 0 ) );
+
+    HOST_CHECK( dspSqrt64( 0u ) == 0u );
+    HOST_CHECK( dspSqrt64( 15u ) == 3u );
+    HOST_CHECK( dspSqrt64( 16u ) == 4u );
+    HOST_CHECK( dspSqrt64( UINT64_MAX ) == 0xFFFFFFFFu );
+}
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+int main( void )
+{
+    testMac();
+    testLowpass();
+    testMovingAverage();
+    testMedian();
+    testRate();
+    testGoertzel();
+
+    return HOST_RESULT();
+}
+
+/*----------------------------------------------------------------------------\
+|   End of test_dsp.c module                                                  |
+\----------------------------------------------------------------------------*/
@@ -0,0 +1,425 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : test_het.c Module File.                                    |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   fw_het PWM and pulse trains through a simulator of the HET program.       |
+|                                                                             |
+|   fw_het.c is included here with hetREG1 and hetRAM1 pointing at RAM and    |
+|   its channel table writable, so both channels can be enabled and the       |
+|   PWM runs at 1 kHz instead of the heartbeat of the table. The              |
+|   simulator runs the loaded program once per LR, from address 0 to the      |
+|   branch back, for the three instructions fw_het.c loads, as its header     |
+|   describes them:                                                           |
+|                                                                             |
+|     CNT   count >= max wraps to 0 and sets Z, else counts up; A = count     |
+|     ECMP  Z raises the pin at the LR start, A == LR data lowers it after    |
+|           the HR part of the data                                           |
+|     DJZ   data 0 branches to the conditional address, else counts down      |
+|                                                                             |
+|   Every pin edge is logged in HR clocks, checked against the periods,       |
+|   duties and trains asked for, also across hetPwmSet() part way through     |
+|   a period.                                                                 |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include "host_test.h"
+
+#include "HL_reg_het.h"
+
+/*----------------------------------------------------------------------------\
+|   Register Model                                                            |
+\----------------------------------------------------------------------------*/
+
+static hetBASE_t test_het;
+static hetRAMBASE_t test_het_ram;
+
+#undef hetREG1
+#undef hetRAM1
+#define hetREG1                     ( &test_het )
+#define hetRAM1                     ( &test_het_ram )
+
+#define HET_PWM_CONFIG_CONST
+
+#include "fw_het.c"
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define TEST_EDGES_MAX              4096u
+#define TEST_NEXT( program )        ( ( ( program ) >> 13 ) & 0x1FFu )
+#define TEST_OPCODE( program )      ( ( ( program ) >> 9 ) & 0xFu )
+#define TEST_COND( control )        ( ( ( control ) >> 13 ) & 0x1FFu )
+#define TEST_PIN( control )         ( ( ( control ) >> 8 ) & 0x1Fu )
+#define TEST_HR( data )             ( ( ( data ) & 0x7Fu ) >> ( 7u - HET_LR_LOG2 ) )
+#define TEST_LR_HR( lr )            ( ( U64 ) ( lr ) << HET_LR_LOG2 )
+
+#define TEST_PWM_PIN                0u                  /* eHET_PWM_HET1_0 */
+#define TEST_PULSE_PIN              2u                  /* eHET_PWM_HET1_2 */
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    U64                         time;               /* HR clocks since the HET started */
+    U8                          pin;
+    U8                          level;
+} S_TEST_EDGE;
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static U64 test_lr;                                 /* LR loops run */
+static U32 test_levels;                             /* Pin levels, bit per pin */
+static S_TEST_EDGE test_edges[ TEST_EDGES_MAX ];
+static U32 test_edge_count;
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+static void testPin( U32 pin, U32 level, U64 time )
+{
+    if ( ( ( test_levels >> pin ) & 1u ) == level )
+    {
+        return;
+    }
+
+    test_levels ^= 1u << pin;
+    if ( test_edge_count < TEST_EDGES_MAX )
+    {
+        test_edges[ test_edge_count ].time = time;
+        test_edges[ test_edge_count ].pin = ( U8 ) pin;
+        test_edges[ test_edge_count ].level = ( U8 ) level;
+        test_edge_count++;
+    }
+}
+
+/* One LR loop of the program in HET RAM */
+static void testLoop( void )
+{
+    hetINSTRUCTION_t *p_ins;
+    U32 addr = 0u;
+    U32 next;
+    U32 steps;
+    U32 count;
+    U32 a = 0u;
+    BOOLEAN z = FALSE;
+    BOOLEAN match;
+    U64 start = TEST_LR_HR( test_lr );
+
+    for ( steps = 0u; steps < HET_RAM_INSTRUCTIONS; steps++ )
+    {
+        p_ins = &test_het_ram.Instruction[ addr ];
+        next = TEST_NEXT( p_ins->Program );
+        count = HET_D_VALUE( p_ins->Data );
+
+        switch ( TEST_OPCODE( p_ins->Program ) )
+        {
+            case HET_OP_CNT:
+                z = FALSE;
+                if ( ( ( ( p_ins->Program & HET_P_CNT_COMP_GE ) != 0u ) && ( count >= p_ins->Control ) ) ||
+                     ( count == p_ins->Control ) )
+                {
+                    z = TRUE;
+                    count = 0u;
+                }
+                else
+                {
+                    count++;
+                }
+                p_ins->Data = HET_D_LR( count ) | ( p_ins->Data & 0x7Fu );
+                a = count;
+                break;
+
+            case HET_OP_ECMP:
+                match = ( a == count ) ? TRUE : FALSE;
+                if ( ( p_ins->Control & HET_C_EN_PIN_ACTION ) == 0u )
+                {
+                    break;
+                }
+                /* A compare at HR 0 of the wrap LR wins: no zero width pulse */
+                if ( ( z == TRUE ) && ( ( p_ins->Control & HET_C_OPPOSITE_ACTION ) != 0u ) &&
+                     ( ( match == FALSE ) || ( TEST_HR( p_ins->Data ) != 0u ) ) )
+                {
+                    testPin( TEST_PIN( p_ins->Control ), 1u, start );
+                }
+                if ( match == TRUE )
+                {
+                    testPin( TEST_PIN( p_ins->Control ), 0u,
+                             start + ( ( ( p_ins->Program & HET_P_ECMP_HR ) != 0u ) ? TEST_HR( p_ins->Data ) : 0u ) );
+                }
+                break;
+
+            case HET_OP_DJZ:
+                if ( count == 0u )
+                {
+                    next = TEST_COND( p_ins->Control );
+                }
+                else
+                {
+                    p_ins->Data = HET_D_LR( count - 1u );
+                }
+                break;
+
+            default:
+                HOST_CHECK( 0 );
+                break;
+        }
+
+        if ( next <= addr )
+        {
+            HOST_CHECK( next == 0u );                   /* Every program ends with the branch to 0 */
+            break;
+        }
+        addr = next;
+    }
+
+    test_lr++;
+}
+
+static void testRun( U32 loops )
+{
+    U32 i;
+
+    for ( i = 0u; i < loops; i++ )
+    {
+        testLoop();
+    }
+}
+
+/* Times of the edges of a pin to a level, from edge index first on */
+static U32 testEdges( U32 first, U32 pin, U32 level, U64 *times, U32 max )
+{
+    U32 i;
+    U32 n = 0u;
+
+    for ( i = first; ( i < test_edge_count ) && ( n < max ); i++ )
+    {
+        if ( ( test_edges[ i ].pin == pin ) && ( test_edges[ i ].level == level ) )
+        {
+            times[ n ] = test_edges[ i ].time;
+            n++;
+        }
+    }
+
+    return n;
+}
+
+static void testInit( void )
+{
+    memset( ( void * ) &test_het, 0, sizeof( test_het ) );
+    memset( ( void * ) &test_het_ram, 0, sizeof( test_het_ram ) );
+    test_lr = 0u;
+    test_levels = 0u;
+    test_edge_count = 0u;
+
+    /* 1 kHz rather than the heartbeat of the table, so a period is 2344 LR to simulate */
+    het_pwm_config_defs[ eHET_PWM_HET1_0 ].period_ns = 1000000u;
+    het_pwm_config_defs[ eHET_PWM_HET1_0 ].duty_ns = 500000u;
+    het_pwm_config_defs[ eHET_PWM_HET1_0 ].enabled = TRUE;
+    het_pwm_config_defs[ eHET_PWM_HET1_2 ].enabled = TRUE;
+    hetPwmInit();
+
+    HOST_CHECK( test_het.GCR == HET_GCR_ON );
+    HOST_CHECK( test_het.DIR == ( ( 1u << TEST_PWM_PIN ) | ( 1u << TEST_PULSE_PIN ) ) );
+    HOST_CHECK( het_pwm_state[ eHET_PWM_HET1_0 ].cnt == 0u );
+    HOST_CHECK( het_pwm_state[ eHET_PWM_HET1_2 ].djz == 2u );
+}
+
+/* Rises one period apart, falls one duty after each rise */
+static void testContinuous( void )
+{
+    const S_HET_PWM_CONFIG *p_cfg = &hetPwmGetConfig()[ eHET_PWM_HET1_0 ];
+    U32 period_lr = hetPeriodLr( p_cfg->period_ns );
+    U64 rise[ 8 ];
+    U64 fall[ 8 ];
+    U32 rises;
+    U32 falls;
+    U32 i;
+
+    testRun( ( 6u * period_lr ) + 1u );
+
+    rises = testEdges( 0u, TEST_PWM_PIN, 1u, rise, 8u );
+    falls = testEdges( 0u, TEST_PWM_PIN, 0u, fall, 8u );
+    HOST_CHECK( rises == 7u );
+    HOST_CHECK( falls == 6u );
+    HOST_CHECK( rise[ 0 ] == 0u );
+    for ( i = 0u; i < falls; i++ )
+    {
+        HOST_CHECK( rise[ i + 1u ] - rise[ i ] == TEST_LR_HR( period_lr ) );
+        HOST_CHECK( fall[ i ] - rise[ i ] == hetNsToHr( p_cfg->duty_ns ) );
+    }
+
+    printf( "pwm: period %u LR, %llu HR clocks, high %llu HR clocks\n",
+            period_lr, ( unsigned long long ) ( rise[ 1 ] - rise[ 0 ] ), ( unsigned long long ) ( fall[ 0 ] - rise[ 0 ] ) );
+
+    /* No pulses on the idle pulse channel */
+    HOST_CHECK( testEdges( 0u, TEST_PULSE_PIN, 1u, rise, 1u ) == 0u );
+}
+
+/* A new duty from the next compare, 0 % and 100 % without edges */
+static void testDuty( void )
+{
+    U32 period_lr = het_pwm_state[ eHET_PWM_HET1_0 ].period_lr;
+    U32 first;
+    U64 rise[ 4 ];
+    U64 fall[ 4 ];
+
+    /* Align to a rise */
+    testRun( period_lr - ( U32 ) ( test_lr % period_lr ) );
+
+    HOST_CHECK( hetPwmSetDuty( eHET_PWM_HET1_0, 250000u ) == TRUE );
+    first = test_edge_count;
+    testRun( 2u * period_lr );
+    HOST_CHECK( testEdges( first, TEST_PWM_PIN, 1u, rise, 4u ) == 2u );
+    HOST_CHECK( testEdges( first, TEST_PWM_PIN, 0u, fall, 4u ) == 2u );
+    HOST_CHECK( fall[ 0 ] - rise[ 0 ] == hetNsToHr( 250000u ) );
+    HOST_CHECK( fall[ 1 ] - rise[ 1 ] == hetNsToHr( 250000u ) );
+
+    HOST_CHECK( hetPwmSetDuty( eHET_PWM_HET1_0, 0u ) == TRUE );
+    testRun( period_lr );
+    first = test_edge_count;
+    testRun( 3u * period_lr );
+    HOST_CHECK( testEdges( first, TEST_PWM_PIN, 1u, rise, 4u ) == 0u );
+    HOST_CHECK( ( test_levels & ( 1u << TEST_PWM_PIN ) ) == 0u );
+
+    HOST_CHECK( hetPwmSetDuty( eHET_PWM_HET1_0, 2000000u ) == TRUE );    /* Past the period */
+    testRun( period_lr );
+    first = test_edge_count;
+    testRun( 3u * period_lr );
+    HOST_CHECK( testEdges( first, TEST_PWM_PIN, 0u, fall, 4u ) == 0u );
+    HOST_CHECK( ( test_levels & ( 1u << TEST_PWM_PIN ) ) != 0u );
+
+    HOST_CHECK( hetPwmSetDuty( eHET_PWM_HET1_2, 0u ) == FALSE );        /* Not continuous */
+}
+
+/* A new period part way through one: the count runs on to the new max */
+static void testPeriod( void )
+{
+    const U32 duty_ns = 100000u;
+    U32 old_lr = het_pwm_state[ eHET_PWM_HET1_0 ].period_lr;
+    U32 new_lr;
+    U32 count;
+    U32 first;
+    U64 last_rise;
+    U64 rise[ 4 ];
+
+    HOST_CHECK( hetPwmSetDuty( eHET_PWM_HET1_0, duty_ns ) == TRUE );
+
+    /* Longer: 100 LR into a period, the period in progress takes the new length */
+    testRun( old_lr - ( U32 ) ( test_lr % old_lr ) );
+    last_rise = TEST_LR_HR( test_lr );
+    testRun( 100u );
+    count = HET_D_VALUE( test_het_ram.Instruction[ het_pwm_state[ eHET_PWM_HET1_0 ].cnt ].Data );
+
+    HOST_CHECK( hetPwmSet( eHET_PWM_HET1_0, 2000000u, duty_ns ) == TRUE );
+    new_lr = het_pwm_state[ eHET_PWM_HET1_0 ].period_lr;
+    HOST_CHECK( HET_D_VALUE( test_het_ram.Instruction[ het_pwm_state[ eHET_PWM_HET1_0 ].cnt ].Data ) == count );
+
+    first = test_edge_count;
+    testRun( 3u * new_lr );
+    HOST_CHECK( testEdges( first, TEST_PWM_PIN, 1u, rise, 4u ) == 3u );
+    HOST_CHECK( rise[ 0 ] - last_rise == TEST_LR_HR( new_lr ) );
+    HOST_CHECK( rise[ 1 ] - rise[ 0 ] == TEST_LR_HR( new_lr ) );
+
+    printf( "pwm: period %u -> %u LR at count %u, next rise after %llu LR\n",
+            old_lr, new_lr, count, ( unsigned long long ) ( ( rise[ 0 ] - last_rise ) >> HET_LR_LOG2 ) );
+
+    /* Shorter, with the count already past the new max: wraps on the next LR */
+    testRun( new_lr - ( U32 ) ( ( test_lr - ( rise[ 0 ] >> HET_LR_LOG2 ) ) % new_lr ) );
+    testRun( new_lr - 10u );
+    HOST_CHECK( hetPwmSet( eHET_PWM_HET1_0, 1000000u, duty_ns ) == TRUE );
+    first = test_edge_count;
+    last_rise = TEST_LR_HR( test_lr );
+    testRun( 1u );
+    HOST_CHECK( testEdges( first, TEST_PWM_PIN, 1u, rise, 4u ) == 1u );
+    HOST_CHECK( rise[ 0 ] == last_rise );
+
+    HOST_CHECK( hetPwmSet( eHET_PWM_HET1_2, 1000000u, duty_ns ) == FALSE );
+    HOST_CHECK( hetPwmSet( eHET_PWM_MAX, 1000000u, duty_ns ) == FALSE );
+}
+
+/* Trains of count pulses, then the pin idles low */
+static void testPulses( U32 period_ns, U32 width_ns, U32 count )
+{
+    U32 period_lr = hetPeriodLr( period_ns );
+    U32 first = test_edge_count;
+    U64 rise[ 16 ];
+    U64 fall[ 16 ];
+    U32 rises;
+    U32 falls;
+    U32 i;
+
+    HOST_CHECK( hetPulseBusy( eHET_PWM_HET1_2 ) == FALSE );
+    HOST_CHECK( hetPulseStart( eHET_PWM_HET1_2, period_ns, width_ns, count ) == TRUE );
+    HOST_CHECK( hetPulseBusy( eHET_PWM_HET1_2 ) == TRUE );
+    HOST_CHECK( hetPulseStart( eHET_PWM_HET1_2, period_ns, width_ns, count ) == FALSE );
+
+    testRun( ( count * period_lr ) - 1u );
+    HOST_CHECK( hetPulseBusy( eHET_PWM_HET1_2 ) == TRUE );
+    testRun( 1u );
+    HOST_CHECK( hetPulseBusy( eHET_PWM_HET1_2 ) == FALSE );
+    testRun( 4u * period_lr );
+
+    rises = testEdges( first, TEST_PULSE_PIN, 1u, rise, 16u );
+    falls = testEdges( first, TEST_PULSE_PIN, 0u, fall, 16u );
+    HOST_CHECK( rises == count );
+    HOST_CHECK( falls == count );
+    for ( i = 0u; ( i < rises ) && ( i < falls ); i++ )
+    {
+        HOST_CHECK( fall[ i ] - rise[ i ] == hetNsToHr( width_ns ) );
+        if ( i > 0u )
+        {
+            HOST_CHECK( rise[ i ] - rise[ i - 1u ] == TEST_LR_HR( period_lr ) );
+        }
+    }
+    HOST_CHECK( ( test_levels & ( 1u << TEST_PULSE_PIN ) ) == 0u );
+
+    printf( "pulses: %u of %u LR, high %u HR clocks: %u rises, %u falls\n",
+            count, period_lr, hetNsToHr( width_ns ), rises, falls );
+}
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+int main( void )
+{
+    testInit();
+    testContinuous();
+    testDuty();
+    testPeriod();
+    testPulses( 10000u, 1000u, 5u );
+    testPulses( 10000u, 1000u, 1u );
+    testPulses( 3000u, 200u, 12u );
+
+    HOST_CHECK( hetPulseStart( eHET_PWM_HET1_2, 10000u, 1000u, 0u ) == FALSE );
+    HOST_CHECK( hetPulseStart( eHET_PWM_HET1_0, 10000u, 1000u, 1u ) == FALSE );
+
+    return HOST_RESULT();
+}
+
+/*----------------------------------------------------------------------------\
+|   End of test_het.c module                                                  |
+\----------------------------------------------------------------------------*/
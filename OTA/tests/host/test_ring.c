@@ -0,0 +1,267 @@
+/*----------------------------------------------------------------------------\
+|          Copyright(c) 2024 Jerry Pylarinos.                                 |
+|          This program is protected by copyright and information             |
+|          contained therein is confidential. The program may not be          |
+|          copied and the information may not be used or disclosed            |
+|          except with the written permission of the proprietor(s).           |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   Module Name  : test_ring.c Module File.                                   |
+|                                                                             |
+|   Author       : Jerry Pylarinos                                            |
+|                                                                             |
+|   Date         : 19 Oct 2026                                                |
+|                                                                             |
+|-----------------------------------------------------------------------------|
+|                                                                             |
+|   fw_ring tests.                                                            |
+|                                                                             |
+|   Single thread: sizing, full / empty, batches across the end of the        |
+|   storage and the wrap of the free running indices. Then a producer and     |
+|   a consumer thread move a numbered stream through a small ring in random   |
+|   batches; the consumer sleeps when the ring is empty and relies on the     |
+|   notify callback alone to be woken, a lost wake-up shows as a timeout.     |
+|                                                                             |
+\----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------\
+|   Header Files                                                              |
+\----------------------------------------------------------------------------*/
+
+#include <pthread.h>
+
+#include "host_test.h"
+
+#include "fw_ring.h"
+
+/*----------------------------------------------------------------------------\
+|   Private Constant Definitions                                              |
+\----------------------------------------------------------------------------*/
+
+#define TEST_RING_LENGTH            16u
+#define TEST_BATCH_MAX              8u
+#define TEST_STRESS_ITEMS           2000000u
+#define TEST_INDEX_NEAR_WRAP        0xFFFFFF00u
+#define TEST_CHECK( seq )           ( ( seq ) * 2654435761u )
+
+/*----------------------------------------------------------------------------\
+|   Private Type Definitions                                                  |
+\----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    U32                         seq;
+    U32                         check;
+    U8                          pad[ 4 ];           /* Odd item size */
+} S_TEST_ITEM;
+
+/* Binary semaphore the notify callback gives */
+typedef struct
+{
+    pthread_mutex_t             lock;
+    pthread_cond_t              cond;
+    int                         given;
+    unsigned                    notifies;
+} S_TEST_SEM;
+
+/*----------------------------------------------------------------------------\
+|   Private Data Declarations                                                 |
+\----------------------------------------------------------------------------*/
+
+static S_RING test_ring;
+static S_TEST_ITEM test_storage[ TEST_RING_LENGTH ];
+static S_TEST_SEM test_sem = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, 0u };
+static unsigned test_lost_wakeups;
+
+/*----------------------------------------------------------------------------\
+|   Private Function Implementations                                          |
+\----------------------------------------------------------------------------*/
+
+static void testFill( S_TEST_ITEM *items, U32 first, U32 count )
+{
+    U32 i;
+
+    for ( i = 0u; i < count; i++ )
+    {
+        items[ i ].seq = first + i;
+        items[ i ].check = TEST_CHECK( first + i );
+        items[ i ].pad[ 0 ] = ( U8 ) i;
+    }
+}
+
+static void testSingleThread( void )
+{
+    S_TEST_ITEM items[ TEST_RING_LENGTH + 4u ];
+    S_TEST_ITEM out[ TEST_RING_LENGTH + 4u ];
+    U32 start;
+    U32 n;
+    U32 i;
+
+    HOST_CHECK( ringInit( &test_ring, test_storage, sizeof( S_TEST_ITEM ), 12u ) == FALSE );
+    HOST_CHECK( ringInit( &test_ring, test_storage, sizeof( S_TEST_ITEM ), 0u ) == FALSE );
+    HOST_CHECK( ringInit( &test_ring, test_storage, sizeof( S_TEST_ITEM ), TEST_RING_LENGTH ) == TRUE );
+
+    /* Empty, then full */
+    HOST_CHECK( ringPop( &test_ring, &out[ 0 ] ) == FALSE );
+    testFill( items, 0u, TEST_RING_LENGTH + 4u );
+    HOST_CHECK( ringPushBatch( &test_ring, items, TEST_RING_LENGTH + 4u ) == TEST_RING_LENGTH );
+    HOST_CHECK( ringCount( &test_ring ) == TEST_RING_LENGTH );
+    HOST_CHECK( ringFree( &test_ring ) == 0u );
+    HOST_CHECK( ringPush( &test_ring, &items[ 0 ] ) == FALSE );
+
+    n = ringPopBatch( &test_ring, out, TEST_RING_LENGTH + 4u );
+    HOST_CHECK( n == TEST_RING_LENGTH );
+    HOST_CHECK( memcmp( out, items, n * sizeof( S_TEST_ITEM ) ) == 0 );
+    HOST_CHECK( ringCount( &test_ring ) == 0u );
+
+    /* Batches straddling the end of the storage and the wrap of the indices */
+    for ( start = 0u; start < 2u; start++ )
+    {
+        ( void ) ringInit( &test_ring, test_storage, sizeof( S_TEST_ITEM ), TEST_RING_LENGTH );
+        if ( start == 1u )
+        {
+            test_ring.head = TEST_INDEX_NEAR_WRAP;
+            test_ring.tail = TEST_INDEX_NEAR_WRAP;
+        }
+
+        for ( i = 0u; i < 300u; i++ )
+        {
+            U32 count = 1u + ( i % 11u );
+
+            testFill( items, i * 100u, count );
+            HOST_CHECK( ringPushBatch( &test_ring, items, count ) == count );
+            HOST_CHECK( ringCount( &test_ring ) == count );
+            HOST_CHECK( ringPopBatch( &test_ring, out, TEST_RING_LENGTH ) == count );
+            HOST_CHECK( memcmp( out, items, count * sizeof( S_TEST_ITEM ) ) == 0 );
+        }
+    }
+}
+
+static void testNotify( void *arg )
+{
+    S_TEST_SEM *p_sem = ( S_TEST_SEM * ) arg;
+
+    pthread_mutex_lock( &p_sem->lock );
+    p_sem->given = 1;
+    p_sem->notifies++;
+    pthread_cond_signal( &p_sem->cond );
+    pthread_mutex_unlock( &p_sem->lock );
+}
+
+static void *testProducer( void *arg )
+{
+    S_TEST_ITEM items[ TEST_BATCH_MAX ];
+    uint32_t seed = 0x12345678u;
+    U32 next = 0u;
+    U32 count;
+
+    ( void ) arg;
+
+    while ( next < TEST_STRESS_ITEMS )
+    {
+        count = 1u + ( hostRand( &seed ) % TEST_BATCH_MAX );
+        if ( count > ( TEST_STRESS_ITEMS - next ) )
+        {
+            count = TEST_STRESS_ITEMS - next;
+        }
+
+        testFill( items, next, count );
+        next += ringPushBatch( &test_ring, items, count );
+    }
+
+    return NULL;
+}
+
+static void *testConsumer( void *arg )
+{
+    S_TEST_ITEM items[ TEST_BATCH_MAX ];
+    uint32_t seed = 0x9E3779B9u;
+    U32 expected = 0u;
+    U32 errors = 0u;
+    U32 n;
+    U32 i;
+
+    ( void ) arg;
+
+    while ( expected < TEST_STRESS_ITEMS )
+    {
+        n = ringPopBatch( &test_ring, items, 1u + ( hostRand( &seed ) % TEST_BATCH_MAX ) );
+
+        if ( n == 0u )
+        {
+            /* Drained: sleep until notified, as a gatekeeper would. A wait
+             * that times out with items in the ring is a lost wake-up.
+             */
+            pthread_mutex_lock( &test_sem.lock );
+            while ( test_sem.given == 0 )
+            {
+                struct timespec limit;
+
+                clock_gettime( CLOCK_REALTIME, &limit );
+                limit.tv_sec += 1;
+                if ( ( pthread_cond_timedwait( &test_sem.cond, &test_sem.lock, &limit ) != 0 ) &&
+                     ( ringCount( &test_ring ) != 0u ) )
+                {
+                    test_lost_wakeups++;
+                    break;
+                }
+            }
+            test_sem.given = 0;
+            pthread_mutex_unlock( &test_sem.lock );
+            continue;
+        }
+
+        for ( i = 0u; i < n; i++ )
+        {
+            if ( ( items[ i ].seq != expected ) || ( items[ i ].check != TEST_CHECK( expected ) ) )
+            {
+                errors++;
+                expected = items[ i ].seq;
+            }
+            expected++;
+        }
+    }
+
+    return ( void * ) ( uintptr_t ) errors;
+}
+
+static void testStress( void )
+{
+    pthread_t producer;
+    pthread_t consumer;
+    void *errors;
+
+    ( void ) ringInit( &test_ring, test_storage, sizeof( S_TEST_ITEM ), TEST_RING_LENGTH );
+    test_ring.head = TEST_INDEX_NEAR_WRAP;
+    test_ring.tail = TEST_INDEX_NEAR_WRAP;
+    ringSetNotify( &test_ring, testNotify, &test_sem );
+
+    pthread_create( &consumer, NULL, testConsumer, NULL );
+    pthread_create( &producer, NULL, testProducer, NULL );
+    pthread_join( producer, NULL );
+    pthread_join( consumer, &errors );
+
+    printf( "stress: %u items, %u notifies, %u sequence errors, %u lost wake-ups\n",
+            TEST_STRESS_ITEMS, test_sem.notifies, ( unsigned ) ( uintptr_t ) errors, test_lost_wakeups );
+
+    HOST_CHECK( errors == NULL );
+    HOST_CHECK( test_lost_wakeups == 0u );
+    HOST_CHECK( ringCount( &test_ring ) == 0u );
+}
+
+/*----------------------------------------------------------------------------\
+|   Public Function Implementations                                           |
+\----------------------------------------------------------------------------*/
+
+int main( void )
+{
+    testSingleThread();
+    testStress();
+
+    return HOST_RESULT();
+}
+
+/*----------------------------------------------------------------------------\
+|   End of test_ring.c module                                                 |
+\----------------------------------------------------------------------------*/
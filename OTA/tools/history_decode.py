@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+"""
+history_decode.py - turn data manager history dumps into CSV.
+
+A dump is requested with STX 'H' <history> <level> ETX ( ASCII digits ) and
+arrives as frames of S_DM_HIST_FRAME_HDR ( 16 bytes ) followed by the
+entries: S32 for the raw level, S32 min / max / mean for the decimated ones.
+History names are read from components/data_manager/dm_signals.h.
+
+usage: history_decode.py capture.bin [--signals dm_signals.h] [--hz 37500000]
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+from uart_frames import STREAM_HISTORY, frames
+
+HEADER = struct.Struct(">BBHIII")
+RAW = struct.Struct(">i")
+AGG = struct.Struct(">iii")
+
+LEVELS = ["raw", "fast", "slow"]
+
+DEFAULT_SIGNALS = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                               "..", "components", "data_manager", "dm_signals.h")
+
+DM_HISTORY = re.compile(r"DM_HISTORY\(\s*(\w+)\s*,\s*(\w+)")
+
+
+def load_table(path):
+    with open(path, encoding="latin-1") as f:
+        text = f.read()
+    return [m.groups() for m in DM_HISTORY.finditer(text)]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    ap.add_argument("capture", help="raw UART capture file")
+    ap.add_argument("--signals", default=DEFAULT_SIGNALS, help="path of dm_signals.h")
+    ap.add_argument("--hz", type=float, default=37500000, help="timestamp clock ( RTI counter 0 )")
+    args = ap.parse_args()
+
+    table = load_table(args.signals)
+    with open(args.capture, "rb") as f:
+        data = f.read()
+
+    sys.stdout.write("history,signal,level,seq,head,head_time,min,max,mean\n")
+    for payload in frames(data, STREAM_HISTORY):
+        history, level, count, first, head, head_time = HEADER.unpack_from(payload, 0)
+        name, signal = table[history] if history < len(table) else ("?", "?")
+        entry = RAW if level == 0 else AGG
+        for i in range(count):
+            values = entry.unpack_from(payload, HEADER.size + i * entry.size)
+            if len(values) == 1:
+                values = values * 3
+            sys.stdout.write("%s,%s,%s,%d,%d,%.6f,%d,%d,%d\n"
+                             % (name, signal, LEVELS[level] if level < len(LEVELS) else level,
+                                first + i, head, head_time / args.hz, values[0], values[1], values[2]))
+
+
+if __name__ == "__main__":
+    main()
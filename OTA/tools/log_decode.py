@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""
+log_decode.py - turn a fw_log UART capture back into readable text.
+
+The message table ( id, module, level, format ) is read from
+components/fw_log/fw_log_msgs.h, so the decoder always matches the firmware
+it was built from. Records are 20 bytes, see S_LOG_RECORD in fw_log.h.
+
+usage: log_decode.py capture.bin [--msgs fw_log_msgs.h] [--hz 37500000]
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+from uart_frames import STREAM_LOG, frames
+
+RECORD = struct.Struct(">IHBB3I")
+
+DEFAULT_MSGS = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                            "..", "components", "fw_log", "fw_log_msgs.h")
+
+LOG_MSG = re.compile(r'LOG_MSG\(\s*(\w+)\s*,\s*eLOG_MOD_(\w+)\s*,\s*eLOG_LEVEL_(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+
+
+def load_table(path):
+    with open(path, encoding="latin-1") as f:
+        text = f.read()
+    return [m.groups() for m in LOG_MSG.finditer(text)]
+
+
+CONVERSION = re.compile(r"%[-+ #0]*\d*(?:\.\d+)?([diuxXc%])")
+
+
+def render(fmt, raw):
+    # Arguments travel as unsigned 32 bit words, sign extend the %d / %i ones
+    values = []
+    for conv in CONVERSION.findall(fmt):
+        if conv == "%":
+            continue
+        if len(values) == len(raw):
+            break
+        value = raw[len(values)]
+        if conv in "di" and value & 0x80000000:
+            value -= 1 << 32
+        values.append(value)
+    try:
+        return fmt % tuple(values)
+    except (TypeError, ValueError):
+        return "%s %r" % (fmt, raw)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    ap.add_argument("capture", help="raw UART capture file")
+    ap.add_argument("--msgs", default=DEFAULT_MSGS, help="path of fw_log_msgs.h")
+    ap.add_argument("--hz", type=float, default=37500000, help="timestamp clock ( RTI counter 0 )")
+    args = ap.parse_args()
+
+    table = load_table(args.msgs)
+    with open(args.capture, "rb") as f:
+        data = f.read()
+
+    for payload in frames(data, STREAM_LOG):
+        for off in range(0, len(payload) - RECORD.size + 1, RECORD.size):
+            ts, msg_id, nargs, _, a0, a1, a2 = RECORD.unpack_from(payload, off)
+            raw = [a0, a1, a2][:nargs]
+            if msg_id >= len(table):
+                sys.stdout.write("%12.6f  ?        ?      unknown id %d %r\n" % (ts / args.hz, msg_id, raw))
+                continue
+            name, module, level, fmt = table[msg_id]
+            sys.stdout.write("%12.6f  %-8s %-6s %s\n" % (ts / args.hz, level, module, render(fmt, raw)))
+
+
+if __name__ == "__main__":
+    main()
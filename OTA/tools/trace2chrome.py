@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""
+trace2chrome.py - convert a fw_trace UART capture into Chrome trace JSON.
+
+The input is the raw byte stream captured from the trace UART, the binary
+frames are picked out of it by uart_frames.py. Stream 1 carries 12 byte
+S_TRC_EVENT records, see components/fw_trace/fw_trace.h. The output loads
+in chrome://tracing or https://ui.perfetto.dev.
+
+usage: trace2chrome.py capture.bin [-o trace.json] [--hz 37500000]
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+from uart_frames import STREAM_TRACE, frames
+
+EVENT = struct.Struct(">IHHI")
+
+# E_TRC_EVENT_ID, keep in step with fw_trace.h
+(EVT_NONE, EVT_OBJECT_NAME, EVT_TASK_CREATE, EVT_TASK_SWITCHED_IN,
+ EVT_TASK_SWITCHED_OUT, EVT_TASK_DELAY_UNTIL, EVT_QUEUE_CREATE, EVT_QUEUE_SEND,
+ EVT_QUEUE_SEND_FAILED, EVT_QUEUE_SEND_FROM_ISR, EVT_QUEUE_RECEIVE,
+ EVT_QUEUE_RECEIVE_FAILED, EVT_QUEUE_RECEIVE_FROM_ISR, EVT_QUEUE_BLOCK_ON_SEND,
+ EVT_QUEUE_BLOCK_ON_RECEIVE, EVT_ISR_ENTER, EVT_ISR_EXIT, EVT_DROPPED,
+ EVT_USER) = range(19)
+
+QUEUE_EVENTS = {
+    EVT_QUEUE_CREATE: "create",
+    EVT_QUEUE_SEND: "send",
+    EVT_QUEUE_SEND_FAILED: "send failed",
+    EVT_QUEUE_SEND_FROM_ISR: "send from ISR",
+    EVT_QUEUE_RECEIVE: "receive",
+    EVT_QUEUE_RECEIVE_FAILED: "receive failed",
+    EVT_QUEUE_RECEIVE_FROM_ISR: "receive from ISR",
+    EVT_QUEUE_BLOCK_ON_SEND: "block on send",
+    EVT_QUEUE_BLOCK_ON_RECEIVE: "block on receive",
+}
+
+# E_TRC_ISR_ID
+ISR_NAMES = ["SCI3", "SCI4", "ADC", "GIO", "DIO_SCHED", "TIMEBASE"]
+
+PID = 1
+TID_ISR = 0
+
+
+def events(data):
+    for payload in frames(data, STREAM_TRACE):
+        for off in range(0, len(payload) - EVENT.size + 1, EVENT.size):
+            yield EVENT.unpack_from(payload, off)
+
+
+class Converter:
+    def __init__(self, hz):
+        self.hz = float(hz)
+        self.out = []
+        self.names = {}        # handle -> name chunks
+        self.tids = {}         # task handle -> tid
+        self.running = None    # (task handle, start us)
+        self.last_raw = None
+        self.wraps = 0
+        self.last_us = 0.0
+
+    def usec(self, raw):
+        # The RTI counter is 32 bit, unwrap it ( events are never 114 s apart )
+        if self.last_raw is not None and raw < self.last_raw:
+            self.wraps += 1
+        self.last_raw = raw
+        self.last_us = ((self.wraps << 32) + raw) * 1e6 / self.hz
+        return self.last_us
+
+    def name(self, handle):
+        chunks = self.names.get(handle)
+        if not chunks:
+            return "0x%08X" % handle
+        return "".join(chunks[i] for i in sorted(chunks)).rstrip("\0") or "0x%08X" % handle
+
+    def tid(self, handle):
+        if handle not in self.tids:
+            self.tids[handle] = len(self.tids) + 1
+        return self.tids[handle]
+
+    def current_tid(self):
+        return self.tid(self.running[0]) if self.running else TID_ISR
+
+    def add(self, evt):
+        raw, event, arg, obj = evt
+
+        if event == EVT_OBJECT_NAME:
+            # timestamp holds the handle, object four characters
+            self.names.setdefault(raw, {})[arg] = struct.pack(">I", obj).decode("latin-1")
+            return
+
+        ts = self.usec(raw)
+
+        if event == EVT_TASK_SWITCHED_IN:
+            self.running = (obj, ts)
+        elif event == EVT_TASK_SWITCHED_OUT:
+            if self.running and self.running[0] == obj:
+                start = self.running[1]
+                self.out.append({"ph": "X", "pid": PID, "tid": self.tid(obj), "ts": start,
+                                 "dur": max(ts - start, 0.0), "name": self.name(obj)})
+            self.running = None
+        elif event == EVT_TASK_CREATE:
+            self.tid(obj)
+        elif event in (EVT_ISR_ENTER, EVT_ISR_EXIT):
+            label = ISR_NAMES[obj] if obj < len(ISR_NAMES) else "ISR %d" % obj
+            self.out.append({"ph": "B" if event == EVT_ISR_ENTER else "E", "pid": PID,
+                             "tid": TID_ISR, "ts": ts, "name": label})
+        elif event in QUEUE_EVENTS:
+            self.out.append({"ph": "i", "s": "t", "pid": PID, "tid": self.current_tid(), "ts": ts,
+                             "name": "%s %s" % (self.name(obj), QUEUE_EVENTS[event]),
+                             "args": {"waiting": arg}})
+        elif event == EVT_TASK_DELAY_UNTIL:
+            self.out.append({"ph": "i", "s": "t", "pid": PID, "tid": self.current_tid(), "ts": ts,
+                             "name": "delay until", "args": {"tick": obj}})
+        elif event == EVT_DROPPED:
+            self.out.append({"ph": "i", "s": "g", "pid": PID, "tid": TID_ISR, "ts": ts,
+                             "name": "events dropped", "args": {"total": obj}})
+        elif event >= EVT_USER:
+            self.out.append({"ph": "i", "s": "t", "pid": PID, "tid": self.current_tid(), "ts": ts,
+                             "name": "user %d" % (event - EVT_USER), "args": {"arg": arg, "object": obj}})
+
+    def finish(self):
+        meta = [{"ph": "M", "pid": PID, "name": "process_name", "args": {"name": "TMS570LC43"}},
+                {"ph": "M", "pid": PID, "tid": TID_ISR, "name": "thread_name", "args": {"name": "ISR"}}]
+        for handle, tid in self.tids.items():
+            meta.append({"ph": "M", "pid": PID, "tid": tid, "name": "thread_name",
+                         "args": {"name": self.name(handle)}})
+            # Names may arrive after the first slices, fix them up here
+            for e in self.out:
+                if e.get("tid") == tid and e["ph"] == "X":
+                    e["name"] = self.name(handle)
+        return {"traceEvents": meta + self.out, "displayTimeUnit": "ns"}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    ap.add_argument("capture", help="raw UART capture file")
+    ap.add_argument("-o", "--output", help="JSON output, default stdout")
+    ap.add_argument("--hz", type=float, default=37500000, help="timestamp clock (TRC_TIMESTAMP_HZ)")
+    args = ap.parse_args()
+
+    with open(args.capture, "rb") as f:
+        data = f.read()
+
+    conv = Converter(args.hz)
+    count = 0
+    for evt in events(data):
+        conv.add(evt)
+        count += 1
+
+    result = json.dumps(conv.finish(), indent=1)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(result)
+    else:
+        sys.stdout.write(result)
+    sys.stderr.write("%d events decoded\n" % count)
+
+
+if __name__ == "__main__":
+    main()
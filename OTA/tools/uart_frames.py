@@ -0,0 +1,47 @@
+"""
+uart_frames.py - pick fw_uart binary frames out of a raw UART capture.
+
+    0xA5 0x5A stream len_hi len_lo payload[len] crc32[4]   (big endian)
+
+The CRC32 ( fw_crc, same as zlib ) covers stream, length and payload.
+Bytes outside valid frames ( the STX / ETX protocol traffic sharing the
+link ) are skipped.
+"""
+
+import struct
+import zlib
+
+SYNC = b"\xA5\x5A"
+
+# UART_FRAME_PAYLOAD_SIZE, keep in step with fw_uart.h
+PAYLOAD_MAX = 252
+
+# E_UART_STREAM, keep in step with fw_uart.h
+STREAM_TRACE = 1
+STREAM_LOG = 2
+STREAM_HISTORY = 3
+
+
+def frames(data, stream_id):
+    """Yield the payload of every CRC-valid frame of the given stream."""
+    pos = 0
+    while True:
+        pos = data.find(SYNC, pos)
+        if pos < 0 or pos + 5 > len(data):
+            return
+        stream = data[pos + 2]
+        length = (data[pos + 3] << 8) | data[pos + 4]
+        end = pos + 5 + length + 4
+        # A sync pair in the protocol traffic, or a frame cut by the end of
+        # the capture: resume the search right after it
+        if length > PAYLOAD_MAX or end > len(data):
+            pos += 1
+            continue
+        body = data[pos + 2:pos + 5 + length]
+        crc = struct.unpack(">I", data[end - 4:end])[0]
+        if (zlib.crc32(body) & 0xFFFFFFFF) != crc:
+            pos += 1
+            continue
+        if stream == stream_id:
+            yield data[pos + 5:pos + 5 + length]
+        pos = end